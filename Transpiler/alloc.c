@@ -0,0 +1,364 @@
+#define _GNU_SOURCE
+#include "alloc.h"
+#include "stats.h"
+#include <stdarg.h>
+#include <stdint.h>
+
+// The accounting functions are only reached through the macros of a -DDEBUG_MEMORY build,
+// the tables below use the C library directly.
+
+#define ALLOC_INITIAL_RECORDS 4096
+#define ALLOC_INITIAL_KINDS 256
+
+// One live block
+struct Alloc_Record {
+    void *ptr;                    /* NULL marks an empty slot */
+    size_t size;
+    unsigned int kind;            /* index in kinds */
+    unsigned int phase;           /* phase it was allocated in */
+};
+
+// Size expression at one allocation site, e.g. "sizeof(struct AST_Node_Operand)"
+struct Alloc_Kind {
+    const char *expr;
+    ALLOC_SUBSYSTEM_TYPE subsystem;
+    struct Alloc_Counters counters;
+};
+
+static struct Alloc_Record *records = NULL;
+static size_t n_record_slots = 0;         /* always a power of two */
+static size_t n_records = 0;
+
+static struct Alloc_Kind *kinds = NULL;
+static size_t n_kinds = 0;
+static size_t kinds_capacity = 0;
+static int *kind_slots = NULL;            /* kind index + 1, 0 if empty */
+static size_t n_kind_slots = 0;           /* always a power of two */
+
+static struct Alloc_Counters total;
+static struct Alloc_Counters subsystems[N_ALLOC_SUBSYSTEMS];
+static struct Alloc_Counters phases[N_PHASES];
+static size_t untracked_frees = 0;        /* blocks freed that did not come through the macros */
+static bool accounting_failed = false;
+
+static const char *subsystem_names[N_ALLOC_SUBSYSTEMS] = { "other", "scanner", "ast", "symtab", "emitter" };
+
+static size_t hash_pointer(const void *ptr) {
+    uintptr_t key = (uintptr_t)ptr;
+    key ^= key >> 17;
+    key *= 0xed5ad4bbu;
+    key ^= key >> 11;
+    return (size_t)key;
+}
+
+static void charge(struct Alloc_Counters *counters, size_t size) {
+    counters->allocs++;
+    counters->bytes += size;
+    counters->live_bytes += size;
+    if (counters->live_bytes > counters->peak_bytes) counters->peak_bytes = counters->live_bytes;
+}
+
+static void discharge(struct Alloc_Counters *counters, size_t size) {
+    counters->frees++;
+    counters->live_bytes -= size;
+}
+
+static bool grow_kinds(void) {
+    if (n_kinds == kinds_capacity) {
+        size_t capacity = kinds_capacity ? kinds_capacity * 2 : ALLOC_INITIAL_KINDS;
+        struct Alloc_Kind *grown = realloc(kinds, capacity * sizeof(struct Alloc_Kind));
+        if (!grown) return false;
+        kinds = grown;
+        kinds_capacity = capacity;
+    }
+    if ((n_kinds + 1) * 2 > n_kind_slots) {
+        size_t n_slots = n_kind_slots ? n_kind_slots * 2 : ALLOC_INITIAL_KINDS * 2;
+        int *slots = calloc(n_slots, sizeof(int));
+        if (!slots) return false;
+        for (size_t k = 0; k < n_kinds; k++) {
+            size_t i = (hash_pointer(kinds[k].expr) + kinds[k].subsystem) & (n_slots - 1);
+            while (slots[i] != 0) i = (i + 1) & (n_slots - 1);
+            slots[i] = (int)k + 1;
+        }
+        free(kind_slots);
+        kind_slots = slots;
+        n_kind_slots = n_slots;
+    }
+    return true;
+}
+
+// Index of the kind for an allocation site, -1 if the tables cannot grow
+static int find_kind(ALLOC_SUBSYSTEM_TYPE subsystem, const char *expr) {
+    if (n_kind_slots > 0) {
+        size_t i = (hash_pointer(expr) + subsystem) & (n_kind_slots - 1);
+        for (; kind_slots[i] != 0; i = (i + 1) & (n_kind_slots - 1)) {
+            struct Alloc_Kind *kind = &kinds[kind_slots[i] - 1];
+            if (kind->expr == expr && kind->subsystem == subsystem) return kind_slots[i] - 1;
+        }
+    }
+    if (!grow_kinds()) return -1;
+    size_t i = (hash_pointer(expr) + subsystem) & (n_kind_slots - 1);
+    while (kind_slots[i] != 0) i = (i + 1) & (n_kind_slots - 1);
+    kinds[n_kinds].expr = expr;
+    kinds[n_kinds].subsystem = subsystem;
+    memset(&kinds[n_kinds].counters, 0, sizeof(struct Alloc_Counters));
+    kind_slots[i] = (int)n_kinds + 1;
+    return (int)n_kinds++;
+}
+
+static size_t probe_record(struct Alloc_Record *slots, size_t n_slots, const void *ptr) {
+    size_t i = hash_pointer(ptr) & (n_slots - 1);
+    while (slots[i].ptr != NULL && slots[i].ptr != ptr) i = (i + 1) & (n_slots - 1);
+    return i;
+}
+
+static bool grow_records(void) {
+    size_t n_slots = n_record_slots ? n_record_slots * 2 : ALLOC_INITIAL_RECORDS;
+    struct Alloc_Record *slots = calloc(n_slots, sizeof(struct Alloc_Record));
+    if (!slots) return false;
+    for (size_t i = 0; i < n_record_slots; i++) {
+        if (records[i].ptr != NULL) slots[probe_record(slots, n_slots, records[i].ptr)] = records[i];
+    }
+    free(records);
+    records = slots;
+    n_record_slots = n_slots;
+    return true;
+}
+
+// Remember a new block and charge it to its subsystem, kind and the current phase
+static void track(void *ptr, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *expr) {
+    if (ptr == NULL) return;
+    int kind = find_kind(subsystem, expr);
+    if (kind < 0 || ((n_records + 1) * 4 > n_record_slots * 3 && !grow_records())) {
+        if (!accounting_failed) fprintf(stderr, "Error: Failed to allocate memory for allocation accounting\n");
+        accounting_failed = true;
+        return;
+    }
+    size_t i = probe_record(records, n_record_slots, ptr);
+    records[i].ptr = ptr;
+    records[i].size = size;
+    records[i].kind = (unsigned int)kind;
+    records[i].phase = (unsigned int)stats.phase;
+    n_records++;
+
+    charge(&total, size);
+    charge(&subsystems[subsystem], size);
+    charge(&kinds[kind].counters, size);
+    charge(&phases[stats.phase], size);
+}
+
+// Forget a block, false if it was never tracked
+static bool untrack(void *ptr, struct Alloc_Record *precord) {
+    if (n_record_slots == 0) return false;
+    size_t i = probe_record(records, n_record_slots, ptr);
+    if (records[i].ptr == NULL) return false;
+
+    struct Alloc_Record record = records[i];
+    if (precord) *precord = record;
+    discharge(&total, record.size);
+    discharge(&subsystems[kinds[record.kind].subsystem], record.size);
+    discharge(&kinds[record.kind].counters, record.size);
+    discharge(&phases[record.phase], record.size);
+
+    // backward-shift deletion keeps the probe sequences intact without tombstones
+    size_t mask = n_record_slots - 1;
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (records[j].ptr == NULL) break;
+        size_t home = hash_pointer(records[j].ptr) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            records[i] = records[j];
+            i = j;
+        }
+    }
+    records[i].ptr = NULL;
+    n_records--;
+    return true;
+}
+
+void *alloc_malloc(size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind) {
+    void *ptr = malloc(size);
+    track(ptr, size, subsystem, kind);
+    return ptr;
+}
+
+void *alloc_calloc(size_t n, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind) {
+    void *ptr = calloc(n, size);
+    track(ptr, n * size, subsystem, kind);
+    return ptr;
+}
+
+// A successful realloc counts as freeing the old block and allocating the new one
+void *alloc_realloc(void *ptr, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind) {
+    struct Alloc_Record old;
+    bool tracked = ptr != NULL && untrack(ptr, &old);   // ptr is stale once realloc moved the block
+    if (ptr != NULL && !tracked) untracked_frees++;
+    void *grown = realloc(ptr, size);
+    if (grown == NULL && size > 0) {
+        // the old block is still there
+        if (tracked) track(ptr, old.size, kinds[old.kind].subsystem, kinds[old.kind].expr);
+        return NULL;
+    }
+    track(grown, size, subsystem, kind);
+    return grown;
+}
+
+char *alloc_strdup(const char *s, ALLOC_SUBSYSTEM_TYPE subsystem) {
+    char *copy = strdup(s);
+    if (copy) track(copy, strlen(copy) + 1, subsystem, "string");
+    return copy;
+}
+
+int alloc_asprintf(ALLOC_SUBSYSTEM_TYPE subsystem, char **pstr, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int len = vasprintf(pstr, format, args);
+    va_end(args);
+    if (len >= 0) track(*pstr, (size_t)len + 1, subsystem, "string");
+    return len;
+}
+
+// Take over a block the C library allocated (open_memstream, getline, ...)
+void alloc_adopt(void *ptr, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind) {
+    track(ptr, size, subsystem, kind);
+}
+
+void alloc_free(void *ptr) {
+    if (ptr == NULL) return;
+    if (!untrack(ptr, NULL)) untracked_frees++;
+    free(ptr);
+}
+
+// Counters over all subsystems so far
+struct Alloc_Counters alloc_totals(void) {
+    return total;
+}
+
+// Free every block still allocated. For a caller that runs the translator many times in one
+// process (the fuzz harness), since nothing owns the AST once it has been emitted.
+void alloc_release_all(void) {
+    for (size_t i = 0; i < n_record_slots; i++) {
+        if (records[i].ptr == NULL) continue;
+        struct Alloc_Record record = records[i];
+        discharge(&total, record.size);
+        discharge(&subsystems[kinds[record.kind].subsystem], record.size);
+        discharge(&kinds[record.kind].counters, record.size);
+        discharge(&phases[record.phase], record.size);
+        free(record.ptr);
+        records[i].ptr = NULL;
+    }
+    n_records = 0;
+}
+
+// True if allocations are being accounted (a -DDEBUG_MEMORY build)
+bool alloc_accounting(void) {
+#ifdef DEBUG_MEMORY
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char *alloc_subsystem_name(ALLOC_SUBSYSTEM_TYPE subsystem) {
+    return subsystem < N_ALLOC_SUBSYSTEMS ? subsystem_names[subsystem] : "unknown";
+}
+
+// Readable name of a kind: the type inside the sizeof() of its size expression
+static void kind_name(const char *expr, char *name, size_t size) {
+    const char *s = strstr(expr, "sizeof(");
+    if (s == NULL) {
+        snprintf(name, size, "%s", strcmp(expr, "string") == 0 ? "string" : "bytes");
+        return;
+    }
+    s += strlen("sizeof(");
+    size_t len = 0;
+    for (int depth = 1; s[len] != '\0'; len++) {
+        if (s[len] == '(') depth++;
+        else if (s[len] == ')' && --depth == 0) break;
+    }
+    snprintf(name, size, "%.*s", (int)len, s);
+}
+
+// Counters of every (subsystem, kind name), allocation sites with the same kind merged
+static size_t merge_kinds(struct Alloc_Kind *merged, char (*names)[96]) {
+    size_t n = 0;
+    for (size_t k = 0; k < n_kinds; k++) {
+        char name[96];
+        kind_name(kinds[k].expr, name, sizeof(name));
+        size_t m = 0;
+        while (m < n && (merged[m].subsystem != kinds[k].subsystem || strcmp(names[m], name) != 0)) m++;
+        if (m == n) {
+            merged[n] = kinds[k];
+            memcpy(names[n], name, sizeof(name));
+            n++;
+            continue;
+        }
+        struct Alloc_Counters *c = &merged[m].counters;
+        c->allocs += kinds[k].counters.allocs;
+        c->frees += kinds[k].counters.frees;
+        c->bytes += kinds[k].counters.bytes;
+        c->live_bytes += kinds[k].counters.live_bytes;
+        c->peak_bytes += kinds[k].counters.peak_bytes;   // upper bound, the sites peak at different times
+    }
+    return n;
+}
+
+static void write_counters(FILE *out, struct Alloc_Counters *c) {
+    fprintf(out, "{ \"allocs\": %zu, \"frees\": %zu, \"bytes\": %zu, \"live_bytes\": %zu, \"peak_bytes\": %zu }",
+            c->allocs, c->frees, c->bytes, c->live_bytes, c->peak_bytes);
+}
+
+// "allocations" member of the stats JSON object
+void alloc_write_json(FILE *out) {
+    fprintf(out, "  \"allocations\": {\n    \"total\": ");
+    write_counters(out, &total);
+    fprintf(out, ",\n    \"untracked_frees\": %zu,\n    \"subsystems\": {", untracked_frees);
+    for (int s = 0; s < N_ALLOC_SUBSYSTEMS; s++) {
+        fprintf(out, "%s\n      \"%s\": ", s ? "," : "", subsystem_names[s]);
+        write_counters(out, &subsystems[s]);
+    }
+    fprintf(out, "\n    },\n    \"phases\": {");
+    for (int p = 0; p < N_PHASES; p++) {
+        fprintf(out, "%s\n      \"%s\": ", p ? "," : "", stats_phase_name((STATS_PHASE)p));
+        write_counters(out, &phases[p]);
+    }
+    fprintf(out, "\n    },\n    \"kinds\": [");
+
+    struct Alloc_Kind *merged = malloc((n_kinds ? n_kinds : 1) * sizeof(struct Alloc_Kind));
+    char (*names)[96] = malloc((n_kinds ? n_kinds : 1) * sizeof(*names));
+    size_t n = (merged && names) ? merge_kinds(merged, names) : 0;
+    for (size_t m = 0; m < n; m++) {
+        fprintf(out, "%s\n      { \"subsystem\": \"%s\", \"kind\": ", m ? "," : "", subsystem_names[merged[m].subsystem]);
+        write_json_string(out, names[m]);
+        fprintf(out, ", \"counters\": ");
+        write_counters(out, &merged[m].counters);
+        fprintf(out, " }");
+    }
+    fprintf(out, "%s]\n  }", n ? "\n    " : "");
+    free(merged);
+    free(names);
+}
+
+// Blocks still allocated, per subsystem and kind
+void alloc_report_leaks(FILE *out) {
+    if (!alloc_accounting() || total.live_bytes == 0) return;
+    fprintf(out, "Memory still allocated at exit: %zu bytes in %zu blocks\n",
+            total.live_bytes, total.allocs - total.frees);
+
+    struct Alloc_Kind *merged = malloc((n_kinds ? n_kinds : 1) * sizeof(struct Alloc_Kind));
+    char (*names)[96] = malloc((n_kinds ? n_kinds : 1) * sizeof(*names));
+    size_t n = (merged && names) ? merge_kinds(merged, names) : 0;
+    for (int s = 0; s < N_ALLOC_SUBSYSTEMS; s++) {
+        if (subsystems[s].live_bytes == 0) continue;
+        fprintf(out, "  %-8s %10zu bytes in %zu blocks\n", subsystem_names[s],
+                subsystems[s].live_bytes, subsystems[s].allocs - subsystems[s].frees);
+        for (size_t m = 0; m < n; m++) {
+            struct Alloc_Counters *c = &merged[m].counters;
+            if (merged[m].subsystem != (ALLOC_SUBSYSTEM_TYPE)s || c->live_bytes == 0) continue;
+            fprintf(out, "    %-36s %10zu bytes in %zu blocks\n", names[m], c->live_bytes, c->allocs - c->frees);
+        }
+    }
+    free(merged);
+    free(names);
+}
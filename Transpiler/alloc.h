@@ -0,0 +1,69 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Parts of the translator memory is charged to; a source file picks its own by defining
+// ALLOC_SUBSYSTEM before its first #include
+typedef enum {
+    ALLOC_OTHER,
+    ALLOC_SCANNER,
+    ALLOC_AST,
+    ALLOC_SYMTAB,
+    ALLOC_EMITTER,
+    N_ALLOC_SUBSYSTEMS
+} ALLOC_SUBSYSTEM_TYPE;
+
+#ifndef ALLOC_SUBSYSTEM
+#define ALLOC_SUBSYSTEM ALLOC_OTHER
+#endif
+
+// Every translator allocation goes through these macros. Built with -DDEBUG_MEMORY they are
+// accounted per subsystem and per kind (the sizeof() in the size expression names the kind,
+// e.g. struct AST_Node_Operand); otherwise they are the plain C library calls.
+#ifdef DEBUG_MEMORY
+#define MALLOC(size)            alloc_malloc((size), ALLOC_SUBSYSTEM, #size)
+#define CALLOC(n, size)         alloc_calloc((n), (size), ALLOC_SUBSYSTEM, #size)
+#define REALLOC(ptr, size)      alloc_realloc((ptr), (size), ALLOC_SUBSYSTEM, #size)
+#define STRDUP(s)               alloc_strdup((s), ALLOC_SUBSYSTEM)
+#define ASPRINTF(pstr, ...)     alloc_asprintf(ALLOC_SUBSYSTEM, (pstr), __VA_ARGS__)
+#define ADOPT(ptr, size)        alloc_adopt((ptr), (size), ALLOC_SUBSYSTEM, "string")
+#define FREE(ptr)               alloc_free(ptr)
+#else
+#define MALLOC(size)            malloc(size)
+#define CALLOC(n, size)         calloc((n), (size))
+#define REALLOC(ptr, size)      realloc((ptr), (size))
+#define STRDUP(s)               strdup(s)
+#define ASPRINTF(pstr, ...)     asprintf((pstr), __VA_ARGS__)
+#define ADOPT(ptr, size)        ((void)0)
+#define FREE(ptr)               free(ptr)
+#endif
+
+// Counters of one subsystem, kind or phase
+struct Alloc_Counters {
+    size_t allocs;                /* blocks allocated (a realloc counts as one) */
+    size_t frees;                 /* blocks freed */
+    size_t bytes;                 /* bytes allocated over the run */
+    size_t live_bytes;            /* bytes allocated and not freed yet */
+    size_t peak_bytes;            /* highest live_bytes seen */
+};
+
+// Function declarations
+void *alloc_malloc(size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind);
+void *alloc_calloc(size_t n, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind);
+void *alloc_realloc(void *ptr, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind);
+char *alloc_strdup(const char *s, ALLOC_SUBSYSTEM_TYPE subsystem);
+int alloc_asprintf(ALLOC_SUBSYSTEM_TYPE subsystem, char **pstr, const char *format, ...);
+void alloc_adopt(void *ptr, size_t size, ALLOC_SUBSYSTEM_TYPE subsystem, const char *kind);
+void alloc_free(void *ptr);
+struct Alloc_Counters alloc_totals(void);
+void alloc_release_all(void);
+bool alloc_accounting(void);
+const char *alloc_subsystem_name(ALLOC_SUBSYSTEM_TYPE subsystem);
+void alloc_write_json(FILE *out);
+void alloc_report_leaks(FILE *out);
+
+#endif // ALLOC_H
@@ -1,361 +1,617 @@
-#include "ast.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-// Create new AST node
-struct AST_Node *new_ast_node(NODE_TYPE n_type, void *value) {
-    struct AST_Node *node = (struct AST_Node *)malloc(sizeof(struct AST_Node));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for AST node\n");
-        return NULL;
-    }
-    
-    node->n_type = n_type;
-    node->value = value;
-    return node;
-}
-
-// Create new instruction node
-struct AST_Node_Instruction *new_instruction_node(NODE_TYPE n_type, void *value) {
-    struct AST_Node_Instruction *node = (struct AST_Node_Instruction *)malloc(sizeof(struct AST_Node_Instruction));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for instruction node\n");
-        return NULL;
-    }
-    
-    node->n_type = n_type;
-    node->value.instruction = (struct AST_Node_Instruction *)value;  // Cast to the appropriate type
-    return node;
-}
-
-// Create new statements node
-struct AST_Node_Statements *new_statements_node(struct AST_Node_Instruction *left, struct AST_Node_Statements *right) {
-    struct AST_Node_Statements *node = (struct AST_Node_Statements *)malloc(sizeof(struct AST_Node_Statements));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for statements node\n");
-        return NULL;
-    }
-    
-    node->left = left;
-    node->right = right;
-    return node;
-}
-
-// Create new function definition node
-struct AST_Node_FunctionDef *new_function_def_node(char *func_name, DATA_TYPE ret_type, 
-                                                 struct AST_Node_Params *params,
-                                                 struct AST_Node_Statements *body) {
-    struct AST_Node_FunctionDef *node = (struct AST_Node_FunctionDef *)malloc(sizeof(struct AST_Node_FunctionDef));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for function definition node\n");
-        return NULL;
-    }
-    
-    node->func_name = strdup(func_name);
-    node->return_type = ret_type;
-    node->params = params;
-    node->f_body = (struct AST_Node_FBody *)body;  // Cast to correct type
-    return node;
-}
-
-// Create new function call node
-struct AST_Node_FunctionCall *new_function_call_node(char *func_name, struct AST_Node_Params *params) {
-    struct AST_Node_FunctionCall *node = (struct AST_Node_FunctionCall *)malloc(sizeof(struct AST_Node_FunctionCall));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for function call node\n");
-        return NULL;
-    }
-    
-    node->func_name = strdup(func_name);
-    node->params = params;
-    return node;
-}
-
-// Create new parameter node
-struct AST_Node_Params *new_params_node(struct AST_Node_Param *param, struct AST_Node_Params *next) {
-    struct AST_Node_Params *node = (struct AST_Node_Params *)malloc(sizeof(struct AST_Node_Params));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for parameters node\n");
-        return NULL;
-    }
-    
-    node->decl_param = (struct AST_Node_Init *)param;  // Cast to correct type
-    node->next_param = next;
-    return node;
-}
-
-// Create new parameter declaration node
-struct AST_Node_ParamDecl *new_param_decl_node(char *param_name, DATA_TYPE data_type) {
-    struct AST_Node_ParamDecl *node = (struct AST_Node_ParamDecl *)malloc(sizeof(struct AST_Node_ParamDecl));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for parameter declaration node\n");
-        return NULL;
-    }
-    
-    node->param_name = strdup(param_name);
-    node->data_type = data_type;
-    return node;
-}
-
-// Create new parameter call node
-struct AST_Node_ParamCall *new_param_call_node(struct AST_Node *value) {
-    struct AST_Node_ParamCall *node = (struct AST_Node_ParamCall *)malloc(sizeof(struct AST_Node_ParamCall));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for parameter call node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new initialization node
-struct AST_Node_Init *new_init_node(struct AST_Node_Assign *assign) {
-    struct AST_Node_Init *node = (struct AST_Node_Init *)malloc(sizeof(struct AST_Node_Init));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for initialization node\n");
-        return NULL;
-    }
-    
-    node->assign = assign;
-    return node;
-}
-
-// Create new assignment node
-struct AST_Node_Assign *new_assign_node(char *var, struct AST_Node *value) {
-    struct AST_Node_Assign *node = (struct AST_Node_Assign *)malloc(sizeof(struct AST_Node_Assign));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for assignment node\n");
-        return NULL;
-    }
-    
-    node->var = strdup(var);
-    node->a_val.expr = (struct AST_Node_Expression *)value;  // Cast to the appropriate type
-    return node;
-}
-
-// Create new class definition node
-struct AST_Node_ClassDef *new_class_def_node(char *class_name, struct AST_Node_Statements *body) {
-    struct AST_Node_ClassDef *node = (struct AST_Node_ClassDef *)malloc(sizeof(struct AST_Node_ClassDef));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for class definition node\n");
-        return NULL;
-    }
-    
-    node->class_name = strdup(class_name);
-    node->body = body;
-    return node;
-}
-
-// Create new object node
-struct AST_Node_Object *new_object_node(char *class_name, char *obj_name) {
-    struct AST_Node_Object *node = (struct AST_Node_Object *)malloc(sizeof(struct AST_Node_Object));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for object node\n");
-        return NULL;
-    }
-    
-    node->obj_name = strdup(obj_name);
-    node->obj_class = (struct AST_Node_Class *)malloc(sizeof(struct AST_Node_Class));
-    node->obj_class->class_name = strdup(class_name);
-    return node;
-}
-
-// Create new object call node
-struct AST_Node_ObjectCall *new_object_call_node(char *obj_name, char *func_name, struct AST_Node_Params *params) {
-    struct AST_Node_ObjectCall *node = (struct AST_Node_ObjectCall *)malloc(sizeof(struct AST_Node_ObjectCall));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for object call node\n");
-        return NULL;
-    }
-    
-    node->obj_name = strdup(obj_name);
-    node->func_name = strdup(func_name);
-    node->params = params;
-    return node;
-}
-
-// Create new if node
-struct AST_Node_If *new_if_node(struct AST_Node *condition, struct AST_Node_Statements *body) {
-    struct AST_Node_If *node = (struct AST_Node_If *)malloc(sizeof(struct AST_Node_If));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for if node\n");
-        return NULL;
-    }
-    
-    node->condition = (struct AST_Node_Expression *)condition;  // Cast to correct type
-    node->if_body = body;
-    return node;
-}
-
-// Create new while node
-struct AST_Node_While *new_while_node(struct AST_Node *condition, struct AST_Node_Statements *body) {
-    struct AST_Node_While *node = (struct AST_Node_While *)malloc(sizeof(struct AST_Node_While));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for while node\n");
-        return NULL;
-    }
-    
-    node->condition = condition;
-    node->body = body;
-    return node;
-}
-
-// Create new for node
-struct AST_Node_For *new_for_node(struct AST_Node_Assign *init, struct AST_Node_Expression *condition, struct AST_Node_Assign *increment, struct AST_Node_Statements *for_body) {
-    struct AST_Node_For *node = (struct AST_Node_For *)malloc(sizeof(struct AST_Node_For));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for for node\n");
-        return NULL;
-    }
-    node->init = init;
-    node->condition = condition;
-    node->increment = increment;
-    node->for_body = for_body;
-    return node;
-}
-
-// Create new print node
-struct AST_Node_Print *new_print_node(struct AST_Node *value) {
-    struct AST_Node_Print *node = (struct AST_Node_Print *)malloc(sizeof(struct AST_Node_Print));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for print node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new return node
-struct AST_Node_Return *new_return_node(struct AST_Node *value) {
-    struct AST_Node_Return *node = (struct AST_Node_Return *)malloc(sizeof(struct AST_Node_Return));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for return node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new break node
-struct AST_Node_Break *new_break_node(void) {
-    struct AST_Node_Break *node = (struct AST_Node_Break *)malloc(sizeof(struct AST_Node_Break));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for break node\n");
-        return NULL;
-    }
-    
-    return node;
-}
-
-// Create new continue node
-struct AST_Node_Continue *new_continue_node(void) {
-    struct AST_Node_Continue *node = (struct AST_Node_Continue *)malloc(sizeof(struct AST_Node_Continue));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for continue node\n");
-        return NULL;
-    }
-    
-    return node;
-}
-
-// Create new binary operation node
-struct AST_Node_BinOp *new_binop_node(struct AST_Node *left, char *op, struct AST_Node *right) {
-    struct AST_Node_BinOp *node = (struct AST_Node_BinOp *)malloc(sizeof(struct AST_Node_BinOp));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for binary operation node\n");
-        return NULL;
-    }
-    
-    node->left = left;
-    node->op = strdup(op);
-    node->right = right;
-    return node;
-}
-
-// Create new unary operation node
-struct AST_Node_UnOp *new_unop_node(char *op, struct AST_Node *operand) {
-    struct AST_Node_UnOp *node = (struct AST_Node_UnOp *)malloc(sizeof(struct AST_Node_UnOp));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for unary operation node\n");
-        return NULL;
-    }
-    
-    node->op = strdup(op);
-    node->operand = operand;
-    return node;
-}
-
-// Create new number node
-struct AST_Node_Num *new_num_node(int value) {
-    struct AST_Node_Num *node = (struct AST_Node_Num *)malloc(sizeof(struct AST_Node_Num));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for number node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new float node
-struct AST_Node_Float *new_float_node(float value) {
-    struct AST_Node_Float *node = (struct AST_Node_Float *)malloc(sizeof(struct AST_Node_Float));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for float node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new string node
-struct AST_Node_String *new_string_node(char *value) {
-    struct AST_Node_String *node = (struct AST_Node_String *)malloc(sizeof(struct AST_Node_String));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for string node\n");
-        return NULL;
-    }
-    
-    node->value = strdup(value);
-    return node;
-}
-
-// Create new boolean node
-struct AST_Node_Bool *new_bool_node(bool value) {
-    struct AST_Node_Bool *node = (struct AST_Node_Bool *)malloc(sizeof(struct AST_Node_Bool));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for boolean node\n");
-        return NULL;
-    }
-    
-    node->value = value;
-    return node;
-}
-
-// Create new variable node
-struct AST_Node_Var *new_var_node(char *name) {
-    struct AST_Node_Var *node = (struct AST_Node_Var *)malloc(sizeof(struct AST_Node_Var));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for variable node\n");
-        return NULL;
-    }
-    
-    node->name = strdup(name);
-    return node;
-}
-
-// Create new no operation node
-struct AST_Node_NoOp *new_noop_node(void) {
-    struct AST_Node_NoOp *node = (struct AST_Node_NoOp *)malloc(sizeof(struct AST_Node_NoOp));
-    if (!node) {
-        fprintf(stderr, "Error: Failed to allocate memory for no operation node\n");
-        return NULL;
-    }
-    
-    return node;
-} 
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "ast.h"
+#include "symtab.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Create new AST node
+struct AST_Node *new_ast_node(NODE_TYPE n_type, void *value) {
+    struct AST_Node *node = (struct AST_Node *)MALLOC(sizeof(struct AST_Node));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for AST node\n");
+        return NULL;
+    }
+    
+    node->n_type = n_type;
+    node->value = value;
+    return node;
+}
+
+// Create new instruction node
+struct AST_Node_Instruction *new_instruction_node(NODE_TYPE n_type, void *value) {
+    struct AST_Node_Instruction *node = (struct AST_Node_Instruction *)MALLOC(sizeof(struct AST_Node_Instruction));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for instruction node\n");
+        return NULL;
+    }
+    
+    node->n_type = n_type;
+    node->value.instruction = (struct AST_Node_Instruction *)value;  // Cast to the appropriate type
+    return node;
+}
+
+// Create new statements node
+struct AST_Node_Statements *new_statements_node(struct AST_Node_Instruction *left, struct AST_Node_Statements *right) {
+    struct AST_Node_Statements *node = (struct AST_Node_Statements *)MALLOC(sizeof(struct AST_Node_Statements));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for statements node\n");
+        return NULL;
+    }
+    
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+// Create new function definition node
+struct AST_Node_FunctionDef *new_function_def_node(char *func_name, DATA_TYPE ret_type, 
+                                                 struct AST_Node_Params *params,
+                                                 struct AST_Node_Statements *body) {
+    struct AST_Node_FunctionDef *node = (struct AST_Node_FunctionDef *)MALLOC(sizeof(struct AST_Node_FunctionDef));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for function definition node\n");
+        return NULL;
+    }
+    
+    node->func_name = STRDUP(func_name);
+    node->return_type = ret_type;
+    node->params = params;
+    node->f_body = (struct AST_Node_FBody *)body;  // Cast to correct type
+    return node;
+}
+
+// Create new function call node
+struct AST_Node_FunctionCall *new_function_call_node(char *func_name, struct AST_Node_Params *params) {
+    struct AST_Node_FunctionCall *node = (struct AST_Node_FunctionCall *)MALLOC(sizeof(struct AST_Node_FunctionCall));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for function call node\n");
+        return NULL;
+    }
+    
+    node->func_name = STRDUP(func_name);
+    node->params = params;
+    return node;
+}
+
+// Create new parameter node
+struct AST_Node_Params *new_params_node(struct AST_Node_Param *param, struct AST_Node_Params *next) {
+    struct AST_Node_Params *node = (struct AST_Node_Params *)MALLOC(sizeof(struct AST_Node_Params));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for parameters node\n");
+        return NULL;
+    }
+    
+    node->decl_param = (struct AST_Node_Init *)param;  // Cast to correct type
+    node->next_param = next;
+    return node;
+}
+
+// Create new parameter declaration node
+struct AST_Node_ParamDecl *new_param_decl_node(char *param_name, DATA_TYPE data_type) {
+    struct AST_Node_ParamDecl *node = (struct AST_Node_ParamDecl *)MALLOC(sizeof(struct AST_Node_ParamDecl));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for parameter declaration node\n");
+        return NULL;
+    }
+    
+    node->param_name = STRDUP(param_name);
+    node->data_type = data_type;
+    return node;
+}
+
+// Create new parameter call node
+struct AST_Node_ParamCall *new_param_call_node(struct AST_Node *value) {
+    struct AST_Node_ParamCall *node = (struct AST_Node_ParamCall *)MALLOC(sizeof(struct AST_Node_ParamCall));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for parameter call node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new initialization node
+struct AST_Node_Init *new_init_node(struct AST_Node_Assign *assign) {
+    struct AST_Node_Init *node = (struct AST_Node_Init *)MALLOC(sizeof(struct AST_Node_Init));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for initialization node\n");
+        return NULL;
+    }
+    
+    node->assign = assign;
+    return node;
+}
+
+// Create new assignment node
+struct AST_Node_Assign *new_assign_node(char *var, struct AST_Node *value) {
+    struct AST_Node_Assign *node = (struct AST_Node_Assign *)MALLOC(sizeof(struct AST_Node_Assign));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for assignment node\n");
+        return NULL;
+    }
+    
+    node->var = STRDUP(var);
+    node->a_val.expr = (struct AST_Node_Expression *)value;  // Cast to the appropriate type
+    return node;
+}
+
+// Create new class definition node
+struct AST_Node_ClassDef *new_class_def_node(char *class_name, struct AST_Node_Statements *body) {
+    struct AST_Node_ClassDef *node = (struct AST_Node_ClassDef *)MALLOC(sizeof(struct AST_Node_ClassDef));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for class definition node\n");
+        return NULL;
+    }
+    
+    node->class_name = STRDUP(class_name);
+    node->body = body;
+    return node;
+}
+
+// Create new object node
+struct AST_Node_Object *new_object_node(char *class_name, char *obj_name) {
+    struct AST_Node_Object *node = (struct AST_Node_Object *)MALLOC(sizeof(struct AST_Node_Object));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for object node\n");
+        return NULL;
+    }
+    
+    node->obj_name = STRDUP(obj_name);
+    node->obj_class = (struct AST_Node_Class *)MALLOC(sizeof(struct AST_Node_Class));
+    node->obj_class->class_name = STRDUP(class_name);
+    return node;
+}
+
+// Create new object call node
+struct AST_Node_ObjectCall *new_object_call_node(char *obj_name, char *func_name, struct AST_Node_Params *params) {
+    struct AST_Node_ObjectCall *node = (struct AST_Node_ObjectCall *)MALLOC(sizeof(struct AST_Node_ObjectCall));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for object call node\n");
+        return NULL;
+    }
+    
+    node->obj_name = STRDUP(obj_name);
+    node->func_name = STRDUP(func_name);
+    node->params = params;
+    return node;
+}
+
+// Create new if node
+struct AST_Node_If *new_if_node(struct AST_Node *condition, struct AST_Node_Statements *body) {
+    struct AST_Node_If *node = (struct AST_Node_If *)MALLOC(sizeof(struct AST_Node_If));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for if node\n");
+        return NULL;
+    }
+    
+    node->condition = (struct AST_Node_Expression *)condition;  // Cast to correct type
+    node->if_body = body;
+    return node;
+}
+
+// Create new while node
+struct AST_Node_While *new_while_node(struct AST_Node *condition, struct AST_Node_Statements *body) {
+    struct AST_Node_While *node = (struct AST_Node_While *)MALLOC(sizeof(struct AST_Node_While));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for while node\n");
+        return NULL;
+    }
+    
+    node->condition = condition;
+    node->body = body;
+    return node;
+}
+
+// Create new for node
+struct AST_Node_For *new_for_node(struct AST_Node_Assign *init, struct AST_Node_Expression *condition, struct AST_Node_Assign *increment, struct AST_Node_Statements *for_body) {
+    struct AST_Node_For *node = (struct AST_Node_For *)MALLOC(sizeof(struct AST_Node_For));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for for node\n");
+        return NULL;
+    }
+    node->init = init;
+    node->condition = condition;
+    node->increment = increment;
+    node->for_body = for_body;
+    return node;
+}
+
+// Create new print node
+struct AST_Node_Print *new_print_node(struct AST_Node *value) {
+    struct AST_Node_Print *node = (struct AST_Node_Print *)MALLOC(sizeof(struct AST_Node_Print));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for print node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new return node
+struct AST_Node_Return *new_return_node(struct AST_Node *value) {
+    struct AST_Node_Return *node = (struct AST_Node_Return *)MALLOC(sizeof(struct AST_Node_Return));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for return node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new break node
+struct AST_Node_Break *new_break_node(void) {
+    struct AST_Node_Break *node = (struct AST_Node_Break *)MALLOC(sizeof(struct AST_Node_Break));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for break node\n");
+        return NULL;
+    }
+    
+    return node;
+}
+
+// Create new continue node
+struct AST_Node_Continue *new_continue_node(void) {
+    struct AST_Node_Continue *node = (struct AST_Node_Continue *)MALLOC(sizeof(struct AST_Node_Continue));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for continue node\n");
+        return NULL;
+    }
+    
+    return node;
+}
+
+// Create new binary operation node
+struct AST_Node_BinOp *new_binop_node(struct AST_Node *left, char *op, struct AST_Node *right) {
+    struct AST_Node_BinOp *node = (struct AST_Node_BinOp *)MALLOC(sizeof(struct AST_Node_BinOp));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for binary operation node\n");
+        return NULL;
+    }
+    
+    node->left = left;
+    node->op = STRDUP(op);
+    node->right = right;
+    return node;
+}
+
+// Create new unary operation node
+struct AST_Node_UnOp *new_unop_node(char *op, struct AST_Node *operand) {
+    struct AST_Node_UnOp *node = (struct AST_Node_UnOp *)MALLOC(sizeof(struct AST_Node_UnOp));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for unary operation node\n");
+        return NULL;
+    }
+    
+    node->op = STRDUP(op);
+    node->operand = operand;
+    return node;
+}
+
+// Create new number node
+struct AST_Node_Num *new_num_node(int value) {
+    struct AST_Node_Num *node = (struct AST_Node_Num *)MALLOC(sizeof(struct AST_Node_Num));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for number node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new float node
+struct AST_Node_Float *new_float_node(float value) {
+    struct AST_Node_Float *node = (struct AST_Node_Float *)MALLOC(sizeof(struct AST_Node_Float));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for float node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new string node
+struct AST_Node_String *new_string_node(char *value) {
+    struct AST_Node_String *node = (struct AST_Node_String *)MALLOC(sizeof(struct AST_Node_String));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for string node\n");
+        return NULL;
+    }
+    
+    node->value = STRDUP(value);
+    return node;
+}
+
+// Create new boolean node
+struct AST_Node_Bool *new_bool_node(bool value) {
+    struct AST_Node_Bool *node = (struct AST_Node_Bool *)MALLOC(sizeof(struct AST_Node_Bool));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for boolean node\n");
+        return NULL;
+    }
+    
+    node->value = value;
+    return node;
+}
+
+// Create new variable node
+struct AST_Node_Var *new_var_node(char *name) {
+    struct AST_Node_Var *node = (struct AST_Node_Var *)MALLOC(sizeof(struct AST_Node_Var));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for variable node\n");
+        return NULL;
+    }
+    
+    node->name = STRDUP(name);
+    return node;
+}
+
+// Create new no operation node
+struct AST_Node_NoOp *new_noop_node(void) {
+    struct AST_Node_NoOp *node = (struct AST_Node_NoOp *)MALLOC(sizeof(struct AST_Node_NoOp));
+    if (!node) {
+        fprintf(stderr, "Error: Failed to allocate memory for no operation node\n");
+        return NULL;
+    }
+    
+    return node;
+}
+
+/****************** Hash-consing of expressions *****************/
+
+#define SHARED_INITIAL_SLOTS 256
+
+// Structurally identical operands and expressions are only kept once when enabled
+bool share_expressions = false;
+
+// Open-addressing set of canonical nodes
+struct Shared_Set {
+    void **slots;
+    unsigned int *hashes;
+    size_t n_slots;               /* always a power of two */
+    size_t n_nodes;
+};
+
+static struct Shared_Set shared_operands;
+static struct Shared_Set shared_expressions;
+
+static unsigned int mix_hash(unsigned int hash, unsigned long long value) {
+    hash ^= (unsigned int)(value ^ (value >> 32));
+    return hash * 16777619u;
+}
+
+static unsigned int hash_operand(struct AST_Node_Operand *operand) {
+    unsigned int hash = mix_hash(2166136261u, operand->operand_type);
+    hash = mix_hash(hash, operand->val_type);
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID:
+        case CONTENT_TYPE_STRING:
+            return mix_hash(hash, hash_name(operand->value.val));
+        case CONTENT_TYPE_INT_NUMBER:
+            return mix_hash(hash, (unsigned long long)operand->value.ival);
+        case CONTENT_TYPE_FLOAT_NUMBER: {
+            unsigned long long bits;
+            memcpy(&bits, &operand->value.dval, sizeof(bits));
+            return mix_hash(hash, bits);
+        }
+        case CONTENT_TYPE_BOOL:
+            return mix_hash(hash, operand->value.bval);
+        default:
+            return mix_hash(hash, (unsigned long long)(uintptr_t)operand->value.expr);
+    }
+}
+
+static bool same_operand(struct AST_Node_Operand *a, struct AST_Node_Operand *b) {
+    if (a->operand_type != b->operand_type || a->val_type != b->val_type) return false;
+    switch (a->operand_type) {
+        case CONTENT_TYPE_ID:
+        case CONTENT_TYPE_STRING:
+            return strcmp(a->value.val, b->value.val) == 0;
+        case CONTENT_TYPE_INT_NUMBER:
+            return a->value.ival == b->value.ival;
+        case CONTENT_TYPE_FLOAT_NUMBER:
+            return memcmp(&a->value.dval, &b->value.dval, sizeof(double)) == 0;
+        case CONTENT_TYPE_BOOL:
+            return a->value.bval == b->value.bval;
+        default:
+            return a->value.expr == b->value.expr;   // sub-expressions are canonical already
+    }
+}
+
+static unsigned int hash_expression(struct AST_Node_Expression *expr) {
+    unsigned int hash = mix_hash(2166136261u, expr->op);
+    hash = mix_hash(hash, expr->expr_type);
+    hash = mix_hash(hash, (unsigned long long)(uintptr_t)expr->left_op);
+    hash = mix_hash(hash, (unsigned long long)(uintptr_t)expr->right_op);
+    for (size_t i = 0; i < expr->n_operands; i++) {
+        hash = mix_hash(hash, (unsigned long long)(uintptr_t)expr->operands[i]);
+    }
+    return mix_hash(hash, expr->n_operands);
+}
+
+static bool same_expression(struct AST_Node_Expression *a, struct AST_Node_Expression *b) {
+    if (a->op != b->op || a->expr_type != b->expr_type || a->n_operands != b->n_operands ||
+        a->left_op != b->left_op || a->right_op != b->right_op) return false;
+    for (size_t i = 0; i < a->n_operands; i++) {
+        if (a->operands[i] != b->operands[i]) return false;
+    }
+    return true;
+}
+
+// Slot holding a node equal to node, or the empty slot where it would go
+static size_t probe_shared(struct Shared_Set *set, void *node, unsigned int hash, bool is_operand) {
+    size_t mask = set->n_slots - 1;
+    size_t i = hash & mask;
+    while (set->slots[i] != NULL) {
+        if (set->hashes[i] == hash &&
+            (is_operand ? same_operand(set->slots[i], node) : same_expression(set->slots[i], node))) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool grow_shared(struct Shared_Set *set) {
+    size_t n_slots = set->n_slots ? set->n_slots * 2 : SHARED_INITIAL_SLOTS;
+    void **slots = (void **)CALLOC(n_slots, sizeof(void *));
+    unsigned int *hashes = (unsigned int *)CALLOC(n_slots, sizeof(unsigned int));
+    if (!slots || !hashes) {
+        fprintf(stderr, "Error: Failed to allocate memory for shared expressions\n");
+        FREE(slots);
+        FREE(hashes);
+        return false;
+    }
+    for (size_t i = 0; i < set->n_slots; i++) {
+        if (set->slots[i] == NULL) continue;
+        size_t j = set->hashes[i] & (n_slots - 1);
+        while (slots[j] != NULL) j = (j + 1) & (n_slots - 1);
+        slots[j] = set->slots[i];
+        hashes[j] = set->hashes[i];
+    }
+    FREE(set->slots);
+    FREE(set->hashes);
+    set->slots = slots;
+    set->hashes = hashes;
+    set->n_slots = n_slots;
+    return true;
+}
+
+// Canonical copy of node; a fresh duplicate is freed (its children are canonical already)
+static void *share_node(struct Shared_Set *set, void *node, unsigned int hash, bool is_operand) {
+    if ((set->n_nodes + 1) * 4 > set->n_slots * 3 && !grow_shared(set)) return node;
+    size_t i = probe_shared(set, node, hash, is_operand);
+    if (set->slots[i] == NULL) {
+        set->slots[i] = node;
+        set->hashes[i] = hash;
+        set->n_nodes++;
+        return node;
+    }
+    if (set->slots[i] != node) {
+        if (!is_operand) FREE(((struct AST_Node_Expression *)node)->operands);
+        FREE(node);
+    }
+    return set->slots[i];
+}
+
+// Share a freshly built operand, a function call operand is never merged with another one
+struct AST_Node_Operand *share_operand(struct AST_Node_Operand *operand) {
+    if (!share_expressions || operand == NULL) return operand;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) return operand;
+    if ((operand->operand_type == CONTENT_TYPE_ID || operand->operand_type == CONTENT_TYPE_STRING) &&
+        operand->value.val == NULL) return operand;
+    return share_node(&shared_operands, operand, hash_operand(operand), true);
+}
+
+// Share a freshly built expression whose operands have been shared
+struct AST_Node_Expression *share_expression(struct AST_Node_Expression *expr) {
+    if (!share_expressions || expr == NULL) return expr;
+    return share_node(&shared_expressions, expr, hash_expression(expr), false);
+}
+
+// Forget the sharing tables (the nodes belong to the AST)
+void delete_shared_expressions(void) {
+    FREE(shared_operands.slots);
+    FREE(shared_operands.hashes);
+    FREE(shared_expressions.slots);
+    FREE(shared_expressions.hashes);
+    memset(&shared_operands, 0, sizeof(shared_operands));
+    memset(&shared_expressions, 0, sizeof(shared_expressions));
+}
+
+/****************** Flattening of associative chains *****************/
+
+// Operators whose chains may be regrouped; float addition and multiplication are not associative
+static bool is_associative(struct AST_Node_Expression *expr) {
+    switch (expr->op) {
+        case OP_AND:
+        case OP_OR:
+            return true;
+        case OP_ADD:
+            return expr->expr_type == DATA_TYPE_INT || expr->expr_type == DATA_TYPE_STRING;
+        case OP_MUL:
+            return expr->expr_type == DATA_TYPE_INT;
+        default:
+            return false;
+    }
+}
+
+// Sub-expression of operand that continues the chain of expr, NULL if the chain stops there
+static struct AST_Node_Expression *chain_link(struct AST_Node_Expression *expr, struct AST_Node_Operand *operand) {
+    if (operand == NULL || operand->operand_type != CONTENT_TYPE_EXPRESSION) return NULL;
+    struct AST_Node_Expression *child = operand->value.expr;
+    if (child == NULL || child->op != expr->op || child->expr_type != expr->expr_type) return NULL;
+    return child->left_op && child->right_op ? child : NULL;
+}
+
+// Append the operands of one side of the chain, children are flat already
+static size_t collect_chain(struct AST_Node_Expression *expr, struct AST_Node_Operand *operand,
+                            struct AST_Node_Operand **operands, size_t n) {
+    struct AST_Node_Expression *child = chain_link(expr, operand);
+    if (child == NULL) {
+        if (operands) operands[n] = operand;
+        return n + 1;
+    }
+    if (child->n_operands == 0) {
+        if (operands) {
+            operands[n] = child->left_op;
+            operands[n + 1] = child->right_op;
+        }
+        return n + 2;
+    }
+    if (operands) memcpy(operands + n, child->operands, child->n_operands * sizeof(*operands));
+    return n + child->n_operands;
+}
+
+// Slots allocated for n operands, rounded up to a power of two so that a chain growing by one
+// operand at a time is only reallocated a logarithmic number of times
+static size_t operand_capacity(size_t n) {
+    size_t capacity = 4;
+    while (capacity < n) capacity *= 2;
+    return capacity;
+}
+
+// Merge the same-operator children of a freshly built node into it.
+// Children are left untouched, they may be shared with other expressions. Without sharing the
+// left child of a chain is referenced from here only, so its operands are taken over rather than
+// copied and a + b + c + ... is flattened in linear time.
+struct AST_Node_Expression *flatten_expression(struct AST_Node_Expression *expr) {
+    if (expr == NULL || !expr->left_op || !expr->right_op || !is_associative(expr)) return expr;
+    struct AST_Node_Expression *left = chain_link(expr, expr->left_op);
+    if (!left && !chain_link(expr, expr->right_op)) return expr;
+
+    struct AST_Node_Operand **operands;
+    size_t n_operands;
+    if (!share_expressions && left && left->n_operands > 0) {
+        size_t n_left = left->n_operands;
+        n_operands = collect_chain(expr, expr->right_op, NULL, n_left);
+        operands = left->operands;
+        if (operand_capacity(n_operands) > operand_capacity(n_left)) {
+            operands = (struct AST_Node_Operand **)REALLOC(operands, operand_capacity(n_operands) * sizeof(*operands));
+            if (!operands) {
+                fprintf(stderr, "Error: Failed to allocate memory for expression operands\n");
+                return expr;
+            }
+        }
+        left->operands = NULL;
+        left->n_operands = 0;
+        collect_chain(expr, expr->right_op, operands, n_left);
+    } else {
+        n_operands = collect_chain(expr, expr->right_op, NULL, collect_chain(expr, expr->left_op, NULL, 0));
+        operands = (struct AST_Node_Operand **)MALLOC(operand_capacity(n_operands) * sizeof(*operands));
+        if (!operands) {
+            fprintf(stderr, "Error: Failed to allocate memory for expression operands\n");
+            return expr;
+        }
+        collect_chain(expr, expr->right_op, operands, collect_chain(expr, expr->left_op, operands, 0));
+    }
+    expr->operands = operands;
+    expr->n_operands = n_operands;
+    expr->left_op = operands[0];
+    expr->right_op = operands[n_operands - 1];
+    return expr;
+}
@@ -0,0 +1,661 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "astimage.h"
+#include "members.h"
+#include <string.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define AST_IMAGE_BYTE_ORDER 0x01020304u
+#define AST_IMAGE_ALIGN 8
+#define WRITER_INITIAL_SIZE 4096
+#define WRITER_INITIAL_SLOTS 256
+
+// Node already placed in the image, so shared subtrees are written once
+struct Image_Slot {
+    const void *node;
+    size_t offset;
+};
+
+// Image being built in memory
+struct Image_Writer {
+    char *buf;
+    size_t size;
+    size_t capacity;
+    uint64_t *relocs;             /* offsets of the pointer fields written so far */
+    size_t n_relocs;
+    size_t relocs_capacity;
+    struct Image_Slot *slots;     /* node -> offset, open addressing */
+    size_t n_slots;               /* always a power of two */
+    size_t n_nodes;
+    bool failed;
+};
+
+// Sizes of the node structures folded together, an image is only read back by a compatible build
+static uint32_t ast_image_layout(void) {
+    static const size_t sizes[] = {
+        sizeof(struct AST_Node_Statements), sizeof(struct AST_Node_Instruction),
+        sizeof(struct AST_Node_Init), sizeof(struct AST_Node_Assign),
+        sizeof(struct AST_Node_FunctionCall), sizeof(struct AST_Node_FunctionDef),
+        sizeof(struct AST_Node_Params), sizeof(struct AST_Node_If),
+        sizeof(struct AST_Node_Else_If), sizeof(struct AST_Node_Else),
+        sizeof(struct AST_Node_Operand), sizeof(struct AST_Node_For),
+        sizeof(struct AST_Node_Expression), sizeof(struct AST_Node_Input),
+        sizeof(struct AST_Node_Output), sizeof(struct AST_Node_FBody),
+        sizeof(struct AST_Node_Class), sizeof(struct AST_Node_CBody),
+        sizeof(struct AST_Node_Parent_Public), sizeof(struct AST_Node_Object),
+        sizeof(struct AST_Node_Return), sizeof(struct AST_Node),
+        sizeof(struct Member_Index), sizeof(struct Class_Member),
+    };
+    uint32_t layout = 2166136261u;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        layout ^= (uint32_t)sizes[i];
+        layout *= 16777619u;
+    }
+    return layout;
+}
+
+// FNV-1a over the 64-bit words of data (the bytes of a short tail last), so that an image damaged
+// on disk is rejected before its offsets are followed
+static uint64_t image_checksum(const char *data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < size; i++) hash = (hash ^ (unsigned char)data[i]) * 1099511628211ull;
+    return hash;
+}
+
+/****************** Writer *****************/
+
+// Reserve size bytes at the next aligned offset
+static size_t reserve(struct Image_Writer *w, size_t size, size_t align) {
+    if (w->failed) return 0;
+    size_t at = (w->size + align - 1) & ~(align - 1);
+    if (at + size > w->capacity) {
+        size_t capacity = w->capacity;
+        while (at + size > capacity) capacity *= 2;
+        char *grown = REALLOC(w->buf, capacity);
+        if (!grown) {
+            fprintf(stderr, "Error: Failed to allocate memory for AST image\n");
+            w->failed = true;
+            return 0;
+        }
+        w->buf = grown;
+        w->capacity = capacity;
+    }
+    memset(w->buf + w->size, 0, at + size - w->size);
+    w->size = at + size;
+    return at;
+}
+
+static size_t hash_node(const void *node, size_t n_slots) {
+    uintptr_t key = (uintptr_t)node;
+    key ^= key >> 17;
+    key *= 0xed5ad4bbu;
+    key ^= key >> 11;
+    return key & (n_slots - 1);
+}
+
+static size_t probe_node(struct Image_Slot *slots, size_t n_slots, const void *node) {
+    size_t i = hash_node(node, n_slots);
+    while (slots[i].node != NULL && slots[i].node != node) i = (i + 1) & (n_slots - 1);
+    return i;
+}
+
+// Offset of a node already in the image, 0 if it has not been written yet
+static size_t placed(struct Image_Writer *w, const void *node) {
+    size_t i = probe_node(w->slots, w->n_slots, node);
+    return w->slots[i].node != NULL ? w->slots[i].offset : 0;
+}
+
+// Copy a node into the image and remember where it went
+static size_t place(struct Image_Writer *w, const void *node, size_t size) {
+    size_t at = reserve(w, size, AST_IMAGE_ALIGN);
+    if (w->failed) return 0;
+    memcpy(w->buf + at, node, size);
+
+    if ((w->n_nodes + 1) * 2 > w->n_slots) {
+        size_t n_slots = w->n_slots * 2;
+        struct Image_Slot *slots = CALLOC(n_slots, sizeof(struct Image_Slot));
+        if (!slots) {
+            fprintf(stderr, "Error: Failed to allocate memory for AST image\n");
+            w->failed = true;
+            return 0;
+        }
+        for (size_t i = 0; i < w->n_slots; i++) {
+            if (w->slots[i].node != NULL) slots[probe_node(slots, n_slots, w->slots[i].node)] = w->slots[i];
+        }
+        FREE(w->slots);
+        w->slots = slots;
+        w->n_slots = n_slots;
+    }
+    size_t i = probe_node(w->slots, w->n_slots, node);
+    w->slots[i].node = node;
+    w->slots[i].offset = at;
+    w->n_nodes++;
+    return at;
+}
+
+// Store target as the pointer field at offset field, targets other than NULL are relocated on load
+static void link_field(struct Image_Writer *w, size_t field, size_t target) {
+    if (w->failed) return;
+    uintptr_t value = target;
+    memcpy(w->buf + field, &value, sizeof(value));
+    if (target == 0) return;
+
+    if (w->n_relocs == w->relocs_capacity) {
+        size_t capacity = w->relocs_capacity ? w->relocs_capacity * 2 : 256;
+        uint64_t *grown = REALLOC(w->relocs, capacity * sizeof(uint64_t));
+        if (!grown) {
+            fprintf(stderr, "Error: Failed to allocate memory for AST image\n");
+            w->failed = true;
+            return;
+        }
+        w->relocs = grown;
+        w->relocs_capacity = capacity;
+    }
+    w->relocs[w->n_relocs++] = field;
+}
+
+#define LINK(w, at, type, field, target) link_field((w), (at) + offsetof(type, field), (target))
+
+static size_t put_string(struct Image_Writer *w, const char *s) {
+    if (s == NULL) return 0;
+    size_t at = placed(w, s);
+    return at ? at : place(w, s, strlen(s) + 1);
+}
+
+static size_t put_statements(struct Image_Writer *w, struct AST_Node_Statements *node);
+static size_t put_instruction(struct Image_Writer *w, struct AST_Node_Instruction *node);
+static size_t put_expression(struct Image_Writer *w, struct AST_Node_Expression *node);
+static size_t put_params(struct Image_Writer *w, struct AST_Node_Params *node);
+static size_t put_class(struct Image_Writer *w, struct AST_Node_Class *node);
+
+// The pointer held by a Value_sym depends on the content type next to it
+static void put_value(struct Image_Writer *w, size_t field, CONTENT_TYPE type, union Value_sym value);
+
+static size_t put_function_call(struct Image_Writer *w, struct AST_Node_FunctionCall *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_FunctionCall, func_name, put_string(w, node->func_name));
+    LINK(w, at, struct AST_Node_FunctionCall, params, put_params(w, node->params));
+    return at;
+}
+
+static size_t put_operand(struct Image_Writer *w, struct AST_Node_Operand *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    put_value(w, at + offsetof(struct AST_Node_Operand, value), node->operand_type, node->value);
+    return at;
+}
+
+static size_t put_assign(struct Image_Writer *w, struct AST_Node_Assign *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Assign, var, put_string(w, node->var));
+    put_value(w, at + offsetof(struct AST_Node_Assign, a_val), node->a_type, node->a_val);
+    return at;
+}
+
+static void put_value(struct Image_Writer *w, size_t field, CONTENT_TYPE type, union Value_sym value) {
+    switch (type) {
+        case CONTENT_TYPE_ID:
+        case CONTENT_TYPE_STRING:
+            link_field(w, field, put_string(w, value.val));
+            break;
+        case CONTENT_TYPE_EXPRESSION:
+            link_field(w, field, put_expression(w, value.expr));
+            break;
+        case CONTENT_TYPE_FUNCTION:
+            link_field(w, field, put_function_call(w, value.funca));
+            break;
+        default:
+            break;                // literals are stored as they are
+    }
+}
+
+static size_t put_expression(struct Image_Writer *w, struct AST_Node_Expression *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Expression, left_op, put_operand(w, node->left_op));
+    LINK(w, at, struct AST_Node_Expression, right_op, put_operand(w, node->right_op));
+    if (node->n_operands > 0) {
+        size_t operands = reserve(w, node->n_operands * sizeof(struct AST_Node_Operand *), AST_IMAGE_ALIGN);
+        LINK(w, at, struct AST_Node_Expression, operands, operands);
+        for (size_t i = 0; i < node->n_operands; i++) {
+            link_field(w, operands + i * sizeof(struct AST_Node_Operand *), put_operand(w, node->operands[i]));
+        }
+    }
+    return at;
+}
+
+static size_t put_init(struct Image_Writer *w, struct AST_Node_Init *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Init, assign, put_assign(w, node->assign));
+    LINK(w, at, struct AST_Node_Init, next_init, put_init(w, node->next_init));
+    return at;
+}
+
+static size_t put_params(struct Image_Writer *w, struct AST_Node_Params *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Params, decl_param, put_init(w, node->decl_param));
+    LINK(w, at, struct AST_Node_Params, call_param, put_operand(w, node->call_param));
+    LINK(w, at, struct AST_Node_Params, next_param, put_params(w, node->next_param));
+    return at;
+}
+
+static size_t put_fbody(struct Image_Writer *w, struct AST_Node_FBody *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_FBody, func_body, put_statements(w, node->func_body));
+    LINK(w, at, struct AST_Node_FBody, return_op, put_operand(w, node->return_op));
+    return at;
+}
+
+static size_t put_function_def(struct Image_Writer *w, struct AST_Node_FunctionDef *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_FunctionDef, func_name, put_string(w, node->func_name));
+    LINK(w, at, struct AST_Node_FunctionDef, params, put_params(w, node->params));
+    LINK(w, at, struct AST_Node_FunctionDef, f_body, put_fbody(w, node->f_body));
+    return at;
+}
+
+static size_t put_else_if(struct Image_Writer *w, struct AST_Node_Else_If *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Else_If, condition, put_expression(w, node->condition));
+    LINK(w, at, struct AST_Node_Else_If, elif_body, put_statements(w, node->elif_body));
+    return at;
+}
+
+static size_t put_else(struct Image_Writer *w, struct AST_Node_Else *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Else, else_body, put_statements(w, node->else_body));
+    return at;
+}
+
+static size_t put_if(struct Image_Writer *w, struct AST_Node_If *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_If, condition, put_expression(w, node->condition));
+    LINK(w, at, struct AST_Node_If, if_body, put_statements(w, node->if_body));
+    LINK(w, at, struct AST_Node_If, else_if, put_else_if(w, node->else_if));
+    LINK(w, at, struct AST_Node_If, else_body, put_else(w, node->else_body));
+    return at;
+}
+
+static size_t put_for(struct Image_Writer *w, struct AST_Node_For *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_For, init, put_assign(w, node->init));
+    LINK(w, at, struct AST_Node_For, condition, put_expression(w, node->condition));
+    LINK(w, at, struct AST_Node_For, increment, put_assign(w, node->increment));
+    LINK(w, at, struct AST_Node_For, for_body, put_statements(w, node->for_body));
+    return at;
+}
+
+static size_t put_input(struct Image_Writer *w, struct AST_Node_Input *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Input, input_op, put_operand(w, node->input_op));
+    LINK(w, at, struct AST_Node_Input, next_input, put_input(w, node->next_input));
+    return at;
+}
+
+static size_t put_output(struct Image_Writer *w, struct AST_Node_Output *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Output, output_op, put_operand(w, node->output_op));
+    LINK(w, at, struct AST_Node_Output, next_output, put_output(w, node->next_output));
+    return at;
+}
+
+static size_t put_return(struct Image_Writer *w, struct AST_Node_Return *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    if (node->value != NULL) {
+        // The parser only wraps operands in a generic node
+        if (node->value->n_type != OPERAND_NODE) {
+            fprintf(stderr, "Error: Cannot store return value of node type %d in AST image\n", node->value->n_type);
+            w->failed = true;
+            return 0;
+        }
+        size_t value = place(w, node->value, sizeof(*node->value));
+        LINK(w, value, struct AST_Node, value, put_operand(w, (struct AST_Node_Operand *)node->value->value));
+        LINK(w, at, struct AST_Node_Return, value, value);
+    } else {
+        LINK(w, at, struct AST_Node_Return, value, 0);
+    }
+    return at;
+}
+
+static size_t put_parent_public(struct Image_Writer *w, struct AST_Node_Parent_Public *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Parent_Public, parent_pub_body, put_statements(w, node->parent_pub_body));
+    LINK(w, at, struct AST_Node_Parent_Public, next_parent_public, put_parent_public(w, node->next_parent_public));
+    return at;
+}
+
+static size_t put_member_index(struct Image_Writer *w, struct Member_Index *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    size_t slots = reserve(w, node->n_slots * sizeof(struct Class_Member), AST_IMAGE_ALIGN);
+    if (w->failed) return 0;
+    memcpy(w->buf + slots, node->slots, node->n_slots * sizeof(struct Class_Member));
+    for (size_t i = 0; i < node->n_slots; i++) {
+        size_t member = slots + i * sizeof(struct Class_Member);
+        LINK(w, member, struct Class_Member, name, put_string(w, node->slots[i].name));
+        LINK(w, member, struct Class_Member, decl, put_instruction(w, node->slots[i].decl));
+    }
+    LINK(w, at, struct Member_Index, slots, slots);
+    return at;
+}
+
+static size_t put_cbody(struct Image_Writer *w, struct AST_Node_CBody *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_CBody, pri_body, put_statements(w, node->pri_body));
+    LINK(w, at, struct AST_Node_CBody, pub_body, put_statements(w, node->pub_body));
+    return at;
+}
+
+static size_t put_class(struct Image_Writer *w, struct AST_Node_Class *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Class, class_name, put_string(w, node->class_name));
+    LINK(w, at, struct AST_Node_Class, c_body, put_cbody(w, node->c_body));
+    LINK(w, at, struct AST_Node_Class, parent_class, put_class(w, node->parent_class));
+    LINK(w, at, struct AST_Node_Class, parent_class_public, put_parent_public(w, node->parent_class_public));
+    LINK(w, at, struct AST_Node_Class, members, put_member_index(w, node->members));
+    return at;
+}
+
+static size_t put_object(struct Image_Writer *w, struct AST_Node_Object *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    LINK(w, at, struct AST_Node_Object, obj_name, put_string(w, node->obj_name));
+    size_t access = at + offsetof(struct AST_Node_Object, access_value);
+    switch (node->access_type) {
+        case ACCESS_TYPE_VAR:
+            link_field(w, access, put_string(w, node->access_value.val));
+            break;
+        case ACCESS_TYPE_FUNCTION:
+            link_field(w, access, put_function_call(w, node->access_value.funca));
+            break;
+        case ACCESS_TYPE_ASSIGN:
+            link_field(w, access, put_assign(w, node->access_value.ass_val));
+            break;
+    }
+    LINK(w, at, struct AST_Node_Object, obj_class, put_class(w, node->obj_class));
+    return at;
+}
+
+static size_t put_instruction(struct Image_Writer *w, struct AST_Node_Instruction *node) {
+    if (node == NULL) return 0;
+    size_t at = placed(w, node);
+    if (at) return at;
+    at = place(w, node, sizeof(*node));
+    size_t value = at + offsetof(struct AST_Node_Instruction, value);
+    switch (node->n_type) {
+        case INIT_NODE:
+            link_field(w, value, put_init(w, node->value.init));
+            break;
+        case ASSIGN_NODE:
+            link_field(w, value, put_assign(w, node->value.assign));
+            break;
+        case FUNC_CALL_NODE:
+            link_field(w, value, put_function_call(w, node->value.functionCall));
+            break;
+        case FUNC_DEF_NODE:
+            link_field(w, value, put_function_def(w, node->value.functionDef));
+            break;
+        case IF_NODE:
+            link_field(w, value, put_if(w, node->value.ifNode));
+            break;
+        case ELSE_IF_NODE:
+            link_field(w, value, put_else_if(w, node->value.elseIfNode));
+            break;
+        case ELSE_NODE:
+            link_field(w, value, put_else(w, node->value.elseNode));
+            break;
+        case FOR_NODE:
+            link_field(w, value, put_for(w, node->value.forNode));
+            break;
+        case INPUT_NODE:
+            link_field(w, value, put_input(w, node->value.inputNode));
+            break;
+        case OUTPUT_NODE:
+            link_field(w, value, put_output(w, node->value.outputNode));
+            break;
+        case CLASS_NODE:
+        case CLASS_CHILD_NODE:
+            link_field(w, value, put_class(w, node->value.classNode));
+            break;
+        case OBJECT_NODE:
+        case ACCESS_CLASS_NODE:
+            link_field(w, value, put_object(w, node->value.objectNode));
+            break;
+        case RETURN_NODE:
+            link_field(w, value, put_return(w, node->value.returnNode));
+            break;
+        default:
+            fprintf(stderr, "Error: Cannot store instruction of node type %d in AST image\n", node->n_type);
+            w->failed = true;
+            break;
+    }
+    return at;
+}
+
+// Statement lists are walked iteratively, they are as long as the program
+static size_t put_statements(struct Image_Writer *w, struct AST_Node_Statements *node) {
+    size_t first = 0;
+    size_t prev = 0;
+    while (node != NULL && !w->failed) {
+        size_t at = placed(w, node);
+        bool is_new = (at == 0);
+        if (is_new) at = place(w, node, sizeof(*node));
+        if (prev) LINK(w, prev, struct AST_Node_Statements, right, at);
+        else first = at;
+        if (!is_new) return first;
+
+        LINK(w, at, struct AST_Node_Statements, left, put_instruction(w, node->left));
+        LINK(w, at, struct AST_Node_Statements, right, 0);
+        prev = at;
+        node = node->right;
+    }
+    return first;
+}
+
+// Write root and everything reachable from it to path
+bool write_ast_image(const char *path, struct AST_Node_Statements *root) {
+    struct Image_Writer w = { 0 };
+    w.capacity = WRITER_INITIAL_SIZE;
+    w.buf = MALLOC(w.capacity);
+    w.n_slots = WRITER_INITIAL_SLOTS;
+    w.slots = CALLOC(w.n_slots, sizeof(struct Image_Slot));
+    if (!w.buf || !w.slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for AST image\n");
+        FREE(w.buf);
+        FREE(w.slots);
+        return false;
+    }
+
+    reserve(&w, sizeof(struct AST_Image_Header), AST_IMAGE_ALIGN);
+    size_t root_at = put_statements(&w, root);
+    size_t relocs = reserve(&w, w.n_relocs * sizeof(uint64_t), AST_IMAGE_ALIGN);
+
+    bool ok = !w.failed;
+    if (ok) {
+        memcpy(w.buf + relocs, w.relocs, w.n_relocs * sizeof(uint64_t));
+        struct AST_Image_Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, AST_IMAGE_MAGIC, sizeof(header.magic));
+        header.pointer_size = sizeof(void *);
+        header.version = AST_IMAGE_VERSION;
+        header.byte_order = AST_IMAGE_BYTE_ORDER;
+        header.layout = ast_image_layout();
+        header.size = w.size;
+        header.root = root_at;
+        header.relocs = relocs;
+        header.n_relocs = w.n_relocs;
+        header.checksum = image_checksum(w.buf + sizeof(header), w.size - sizeof(header));
+        memcpy(w.buf, &header, sizeof(header));
+
+        FILE *file = fopen(path, "wb");
+        if (file == NULL) {
+            fprintf(stderr, "Error: Cannot open AST image %s for writing\n", path);
+            ok = false;
+        } else {
+            if (fwrite(w.buf, 1, w.size, file) != w.size) {
+                fprintf(stderr, "Error: Failed to write AST image %s\n", path);
+                ok = false;
+            }
+            if (fclose(file) != 0) ok = false;
+        }
+    }
+
+    FREE(w.buf);
+    FREE(w.relocs);
+    FREE(w.slots);
+    return ok;
+}
+
+/****************** Reader *****************/
+
+// Check that the header describes an image this build can use, *corrupt is set when it does but
+// the body does not match its checksum
+static bool check_header(const struct AST_Image_Header *header, const char *base, size_t size, bool *corrupt) {
+    *corrupt = false;
+    if (memcmp(header->magic, AST_IMAGE_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != AST_IMAGE_VERSION || header->pointer_size != sizeof(void *)) return false;
+    if (header->byte_order != AST_IMAGE_BYTE_ORDER || header->layout != ast_image_layout()) return false;
+    if (header->size != size || header->root >= size) return false;
+    if (header->relocs % AST_IMAGE_ALIGN != 0 || header->relocs > size) return false;
+    if (header->n_relocs > (size - header->relocs) / sizeof(uint64_t)) return false;
+    if (header->checksum != image_checksum(base + sizeof(*header), size - sizeof(*header))) {
+        *corrupt = true;
+        return false;
+    }
+    return true;
+}
+
+// Map an image privately and turn its offsets back into pointers, the nodes are used where they lie
+struct AST_Image *load_ast_image(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open AST image %s\n", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct AST_Image_Header)) {
+        fprintf(stderr, "Error: %s is not an AST image\n", path);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    char *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map AST image %s\n", path);
+        return NULL;
+    }
+
+    struct AST_Image_Header header;
+    memcpy(&header, base, sizeof(header));
+    bool corrupt;
+    if (!check_header(&header, base, size, &corrupt)) {
+        if (corrupt) fprintf(stderr, "Error: AST image %s is corrupt\n", path);
+        else fprintf(stderr, "Error: %s is not an AST image of this version of cpp2py\n", path);
+        munmap(base, size);
+        return NULL;
+    }
+
+    const uint64_t *relocs = (const uint64_t *)(base + header.relocs);
+    for (uint64_t i = 0; i < header.n_relocs; i++) {
+        uint64_t field = relocs[i];
+        uintptr_t target;
+        if (field < sizeof(header) || field % sizeof(uintptr_t) != 0 || field + sizeof(uintptr_t) > header.relocs) {
+            fprintf(stderr, "Error: AST image %s is corrupt\n", path);
+            munmap(base, size);
+            return NULL;
+        }
+        memcpy(&target, base + field, sizeof(target));
+        if (target < sizeof(header) || target >= header.relocs) {
+            fprintf(stderr, "Error: AST image %s is corrupt\n", path);
+            munmap(base, size);
+            return NULL;
+        }
+        target += (uintptr_t)base;
+        memcpy(base + field, &target, sizeof(target));
+    }
+
+    struct AST_Image *image = MALLOC(sizeof(struct AST_Image));
+    if (!image) {
+        fprintf(stderr, "Error: Failed to allocate memory for AST image\n");
+        munmap(base, size);
+        return NULL;
+    }
+    image->base = base;
+    image->size = size;
+    image->root = header.root ? (struct AST_Node_Statements *)(base + header.root) : NULL;
+    return image;
+}
+
+// Unmap an image, nothing inside it may be used afterwards
+void unload_ast_image(struct AST_Image **pimage) {
+    if (!pimage || !*pimage) return;
+    munmap((*pimage)->base, (*pimage)->size);
+    FREE(*pimage);
+    *pimage = NULL;
+}
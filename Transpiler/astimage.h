@@ -0,0 +1,40 @@
+#ifndef ASTIMAGE_H
+#define ASTIMAGE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ast.h"
+
+#define AST_IMAGE_MAGIC "CPP2PYAST"
+#define AST_IMAGE_VERSION 3
+
+// File header. Nodes follow it in their in-memory layout, every pointer field holds
+// the file offset of its target (0 for NULL) and is listed in the relocation table.
+struct AST_Image_Header {
+    char magic[10];               /* AST_IMAGE_MAGIC */
+    uint16_t pointer_size;        /* sizeof(void *) of the writer */
+    uint32_t version;             /* AST_IMAGE_VERSION */
+    uint32_t byte_order;          /* 0x01020304 as written by the writer */
+    uint32_t layout;              /* sizes of the node structures, see ast_image_layout() */
+    uint64_t size;                /* whole file, header included */
+    uint64_t root;                /* offset of the root statements */
+    uint64_t relocs;              /* offset of the relocation table, nodes all lie below it */
+    uint64_t n_relocs;            /* number of pointer fields listed there */
+    uint64_t checksum;            /* of everything after the header, see image_checksum() */
+};
+
+// AST mapped from a file, pointers fixed up in place
+struct AST_Image {
+    void *base;                   /* private mapping of the whole file */
+    size_t size;
+    struct AST_Node_Statements *root;
+};
+
+// Function declarations
+bool write_ast_image(const char *path, struct AST_Node_Statements *root);
+struct AST_Image *load_ast_image(const char *path);
+void unload_ast_image(struct AST_Image **pimage);
+
+#endif // ASTIMAGE_H
@@ -0,0 +1,64 @@
+#!/bin/sh
+# End-to-end throughput of cpp2py over synthetic corpora written by gencorpus.
+#
+#     ./bench.sh [size ...]        sizes like 1K, 64K, 16M or 1G
+#
+# Sizes default to $BENCH_SIZES, or "1K 64K 1M 16M". Corpora are kept in $BENCH_DIR (bench/)
+# and only generated once. A line per size is printed, and every run's --stats-json counters
+# are collected in $BENCH_OUT (bench/results-<date>.json) so that runs can be compared.
+
+CPP2PY=${CPP2PY:-./cpp2py}
+GENCORPUS=${GENCORPUS:-./gencorpus}
+BENCH_DIR=${BENCH_DIR:-bench}
+SIZES=${*:-${BENCH_SIZES:-1K 64K 1M 16M}}
+
+mkdir -p "$BENCH_DIR" || exit 1
+OUT=${BENCH_OUT:-$BENCH_DIR/results-$(date +%Y%m%d-%H%M%S).json}
+COMMIT=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+
+# Number after "key": in a stats file
+field() {
+    sed -n "s/.*\"$2\": *\([0-9.]*\).*/\1/p" "$1" | head -n 1
+}
+
+# Wall milliseconds of a phase in a stats file
+phase_ms() {
+    sed -n "s/.*\"$2\": { \"wall_ms\": \([0-9.]*\).*/\1/p" "$1" | head -n 1
+}
+
+printf '{\n  "date": "%s",\n  "commit": "%s",\n  "runs": [' "$(date -u +%Y-%m-%dT%H:%M:%SZ)" "$COMMIT" > "$OUT" || exit 1
+printf '%-8s %10s %12s %10s %12s %10s %10s %10s %10s %s\n' \
+    size lines lines/s MB/s "peak RSS KB" "lex ms" "parse ms" "sem ms" "emit ms" status
+
+sep=""
+failed=0
+for size in $SIZES; do
+    src="$BENCH_DIR/corpus-$size.cpp"
+    if [ ! -f "$src" ]; then
+        "$GENCORPUS" "$size" > "$src.tmp" && mv "$src.tmp" "$src" || { rm -f "$src.tmp"; exit 1; }
+    fi
+    stats="$BENCH_DIR/stats-$size.json"
+    rm -f "$stats"
+    "$CPP2PY" --stats-json "$stats" "$src" "$BENCH_DIR/out-$size.py" > /dev/null 2> "$BENCH_DIR/err-$size.txt"
+    status=$?
+    # the parser reports syntax errors without failing
+    if [ $status -eq 0 ] && grep -q "syntax error" "$BENCH_DIR/err-$size.txt"; then status=1; fi
+    if [ $status -ne 0 ] || [ ! -s "$stats" ]; then
+        failed=1
+        printf '%-8s %10s %12s %10s %12s %10s %10s %10s %10s %s\n' "$size" - - - - - - - - "failed ($status)"
+        printf '%s\n    { "size": "%s", "status": %d }' "$sep" "$size" "$status" >> "$OUT"
+    else
+        printf '%-8s %10s %12s %10s %12s %10s %10s %10s %10s %s\n' "$size" \
+            "$(field "$stats" source_lines)" "$(field "$stats" lines_per_sec)" "$(field "$stats" mb_per_sec)" \
+            "$(field "$stats" peak_rss_kb)" "$(phase_ms "$stats" lex)" "$(phase_ms "$stats" parse)" \
+            "$(phase_ms "$stats" semantic)" "$(phase_ms "$stats" emit)" ok
+        printf '%s\n    { "size": "%s", "status": 0, "stats":\n' "$sep" "$size" >> "$OUT"
+        sed 's/^/    /' "$stats" >> "$OUT"
+        printf '    }' >> "$OUT"
+    fi
+    sep=","
+done
+printf '\n  ]\n}\n' >> "$OUT"
+
+echo "Results written to $OUT"
+exit $failed
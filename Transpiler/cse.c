@@ -0,0 +1,667 @@
+#define _GNU_SOURCE
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include <string.h>
+
+// Common subexpression elimination within basic blocks.
+//
+// A basic block is a run of straight-line statements (assignments, declarations, input, output,
+// calls) up to and including the next if, whose condition still belongs to it, or return; any
+// other statement ends the run. An expression computed twice in a block, with none of its names
+// assigned in between, is computed once into a temporary assigned before the statement of its
+// first use, and both uses read the temporary:
+//
+//     d = (x - cx) * (x - cx) + (y - cy) * (y - cy);    __cse0 = x - cx
+//                                                       __cse1 = y - cy
+//                                                       d = __cse0 * __cse0 + __cse1 * __cse1
+//
+// When the first occurrence is the whole value of an assignment, the repeats read the variable
+// assigned instead while it holds the value, and no temporary is needed.
+//
+// Names are numbered by the assignments to them (local value numbering): an expression matches an
+// earlier one only if its names still hold the values they held there. Only expressions over names
+// and literals with arithmetic, comparisons and logical operators are candidates; a call may have
+// effects and is never one. An operand Python evaluates conditionally (the right side of and / or)
+// may read a temporary computed before, it never starts one, so a temporary is only ever computed
+// where the block computed its value anyway. A statement with x++ inside is left alone, the names
+// it increments change halfway. Temporaries are named __cse<n>.
+
+#define CSE_PREFIX "__cse"
+#define CSE_MAX_DEPTH 32   /* deeper expressions are not candidates, bounding the cost of hashing them */
+#define NO_ENTRY ((size_t)-1)
+
+// A name assigned in the block, with the number of the last assignment to it
+struct Cse_Name {
+    const char *name;
+    unsigned int hash;
+    unsigned long assigned;
+};
+
+// An expression of the block: where it is first computed and how often
+struct Cse_Entry {
+    struct AST_Node_Operand operand;  /* a copy, the operand of an assignment value is built on the stack */
+    unsigned int hash;
+    unsigned long stamp;              /* assignments seen when it was first computed */
+    size_t statement;                 /* statement of the block it is first computed in */
+    size_t count;
+    size_t record;                    /* record of its first occurrence */
+    size_t finished;                  /* order in which first occurrences finished */
+    long next;                        /* next entry in the same bucket, -1 for none */
+    const char *holder;               /* variable its first occurrence is assigned to whole, if any */
+    unsigned long held;               /* the assignment to holder */
+    bool needs_temp;                  /* it is repeated where holder no longer holds it */
+    struct AST_Node_Operand *temp;    /* what repeats read: the temporary, or holder */
+    struct AST_Node_Operand *value;   /* what the temporary is assigned, reading other temporaries */
+};
+
+struct Cse_Block {
+    struct Cse_Name *names;
+    size_t n_names, name_slots;
+    struct Cse_Entry *entries;
+    size_t n_entries, entries_capacity;
+    long *buckets;
+    size_t n_buckets;
+    size_t *records;                  /* entry of every candidate occurrence in the order the block is walked,
+                                         NO_ENTRY for a conditional one that repeats none */
+    size_t n_records, records_capacity, next_record;
+    unsigned long stamp;              /* assignments seen so far */
+    unsigned long statement_stamp;    /* assignments seen before the current statement */
+    size_t statement;
+    size_t finished;
+};
+
+static unsigned long next_temp = 0;
+static size_t eliminated = 0;
+
+static unsigned int mix_hash(unsigned int hash, unsigned long long value) {
+    hash ^= (unsigned int)(value ^ (value >> 32));
+    return hash * 16777619u;
+}
+
+static unsigned int string_hash(const char *s) {
+    unsigned int hash = 2166136261u;
+    for (; *s; s++) hash = mix_hash(hash, (unsigned char)*s);
+    return hash;
+}
+
+// Operators that have no effect and evaluate all their operands, but for and / or
+static bool candidate_op(OP_TYPE op) {
+    switch (op) {
+        case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV:
+        case OP_AND: case OP_OR:
+        case OP_LT: case OP_GT: case OP_LE: case OP_GE: case OP_EQ: case OP_NE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Slot of name in the open-addressed name table, an empty one if it was never assigned
+static struct Cse_Name *name_slot(struct Cse_Block *block, const char *name, unsigned int hash) {
+    size_t mask = block->name_slots - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        struct Cse_Name *slot = &block->names[i];
+        if (slot->name == NULL || (slot->hash == hash && strcmp(slot->name, name) == 0)) return slot;
+    }
+}
+
+// Number of the last assignment to name in the block, 0 if none
+static unsigned long last_assigned(struct Cse_Block *block, const char *name) {
+    if (block->n_names == 0) return 0;
+    return name_slot(block, name, string_hash(name))->assigned;
+}
+
+static void assign_name(struct Cse_Block *block, const char *name) {
+    if (name == NULL) return;
+    if (2 * (block->n_names + 1) > block->name_slots) {
+        size_t slots = block->name_slots ? block->name_slots * 2 : 16;
+        struct Cse_Name *old = block->names;
+        size_t old_slots = block->name_slots;
+        block->names = (struct Cse_Name *)CALLOC(slots, sizeof(struct Cse_Name));
+        if (!block->names) {
+            // without the table no expression can be told unchanged
+            fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+            exit(1);
+        }
+        block->name_slots = slots;
+        for (size_t i = 0; i < old_slots; i++) {
+            if (old[i].name) *name_slot(block, old[i].name, old[i].hash) = old[i];
+        }
+        FREE(old);
+    }
+    unsigned int hash = string_hash(name);
+    struct Cse_Name *slot = name_slot(block, name, hash);
+    if (slot->name == NULL) {
+        slot->name = name;
+        slot->hash = hash;
+        block->n_names++;
+    }
+    slot->assigned = ++block->stamp;
+}
+
+// The operand is pure, at most CSE_MAX_DEPTH deep and reads no name the current statement assigned
+// before it; *hash then covers its structure and the values of its names, *named is set when it
+// reads a name
+static bool analyze(struct Cse_Block *block, struct AST_Node_Operand *operand, int depth,
+                    unsigned int *hash, bool *named) {
+    if (operand == NULL || depth > CSE_MAX_DEPTH) return false;
+    unsigned int h = mix_hash(2166136261u, operand->operand_type);
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID: {
+            if (operand->value.val == NULL) return false;
+            unsigned long assigned = last_assigned(block, operand->value.val);
+            if (assigned > block->statement_stamp) return false;
+            *hash = mix_hash(mix_hash(h, string_hash(operand->value.val)), assigned);
+            *named = true;
+            return true;
+        }
+        case CONTENT_TYPE_STRING:
+            if (operand->value.val == NULL) return false;
+            *hash = mix_hash(h, string_hash(operand->value.val));
+            return true;
+        case CONTENT_TYPE_INT_NUMBER:
+            *hash = mix_hash(h, (unsigned long long)operand->value.ival);
+            return true;
+        case CONTENT_TYPE_FLOAT_NUMBER: {
+            unsigned long long bits;
+            memcpy(&bits, &operand->value.dval, sizeof(bits));
+            *hash = mix_hash(h, bits);
+            return true;
+        }
+        case CONTENT_TYPE_BOOL:
+            *hash = mix_hash(h, operand->value.bval);
+            return true;
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL || !expr->left_op || !expr->right_op || !candidate_op(expr->op)) return false;
+            h = mix_hash(mix_hash(h, expr->op), count_operands(expr));
+            for (size_t i = 0; i < count_operands(expr); i++) {
+                unsigned int child;
+                if (!analyze(block, nth_operand(expr, i), depth + 1, &child, named)) return false;
+                h = mix_hash(h, child);
+            }
+            *hash = h;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// No name of operand was assigned after stamp
+static bool unchanged_since(struct Cse_Block *block, struct AST_Node_Operand *operand, unsigned long stamp) {
+    if (operand->operand_type == CONTENT_TYPE_ID) return last_assigned(block, operand->value.val) <= stamp;
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION) return true;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    for (size_t i = 0; i < count_operands(expr); i++) {
+        if (!unchanged_since(block, nth_operand(expr, i), stamp)) return false;
+    }
+    return true;
+}
+
+static void grow_buckets(struct Cse_Block *block) {
+    size_t n = block->n_buckets ? block->n_buckets * 2 : 16;
+    long *buckets = (long *)MALLOC(n * sizeof(long));
+    if (!buckets) {
+        fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++) buckets[i] = -1;
+    for (size_t i = 0; i < block->n_entries; i++) {
+        struct Cse_Entry *entry = &block->entries[i];
+        entry->next = buckets[entry->hash & (n - 1)];
+        buckets[entry->hash & (n - 1)] = (long)i;
+    }
+    FREE(block->buckets);
+    block->buckets = buckets;
+    block->n_buckets = n;
+}
+
+// Entry of the expression operand still computes, -1 if none
+static long find_entry(struct Cse_Block *block, struct AST_Node_Operand *operand, unsigned int hash) {
+    if (block->n_buckets == 0) return -1;
+    for (long i = block->buckets[hash & (block->n_buckets - 1)]; i >= 0; i = block->entries[i].next) {
+        struct Cse_Entry *entry = &block->entries[i];
+        if (entry->hash == hash && same_operand(&entry->operand, operand) &&
+            unchanged_since(block, &entry->operand, entry->stamp)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static size_t add_record(struct Cse_Block *block) {
+    if (block->n_records == block->records_capacity) {
+        size_t capacity = block->records_capacity ? block->records_capacity * 2 : 32;
+        size_t *records = (size_t *)REALLOC(block->records, capacity * sizeof(*records));
+        if (!records) {
+            fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+            exit(1);
+        }
+        block->records = records;
+        block->records_capacity = capacity;
+    }
+    return block->n_records++;
+}
+
+static size_t add_entry(struct Cse_Block *block, struct AST_Node_Operand *operand, unsigned int hash, size_t record) {
+    if (block->n_entries == block->entries_capacity) {
+        size_t capacity = block->entries_capacity ? block->entries_capacity * 2 : 16;
+        struct Cse_Entry *entries = (struct Cse_Entry *)REALLOC(block->entries, capacity * sizeof(*entries));
+        if (!entries) {
+            fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+            exit(1);
+        }
+        block->entries = entries;
+        block->entries_capacity = capacity;
+    }
+    if (2 * (block->n_entries + 1) > block->n_buckets) grow_buckets(block);
+    size_t i = block->n_entries++;
+    size_t bucket = hash & (block->n_buckets - 1);
+    block->entries[i] = (struct Cse_Entry){ .operand = *operand, .hash = hash, .stamp = block->stamp,
+                                            .statement = block->statement, .count = 1, .record = record,
+                                            .next = block->buckets[bucket] };
+    block->buckets[bucket] = (long)i;
+    return i;
+}
+
+static void count_operand(struct Cse_Block *block, struct AST_Node_Operand *operand, bool conditional);
+
+static void count_children(struct Cse_Block *block, struct AST_Node_Expression *expr, bool conditional) {
+    if (expr == NULL || !expr->left_op || !expr->right_op) return;
+    for (size_t i = 0; i < count_operands(expr); i++) {
+        count_operand(block, nth_operand(expr, i), conditional || conditional_operand(expr, i));
+    }
+}
+
+// Records the candidates in operand, outermost first; a repeated one is not looked into, the
+// expressions in it were counted with its first occurrence. A conditional operand may repeat an
+// expression, it is not the first occurrence of one.
+static void count_operand(struct Cse_Block *block, struct AST_Node_Operand *operand, bool conditional) {
+    if (operand == NULL || operand->operand_type != CONTENT_TYPE_EXPRESSION) return;
+    unsigned int hash;
+    bool named = false;
+    if (!analyze(block, operand, 0, &hash, &named) || !named) {
+        count_children(block, operand->value.expr, conditional);
+        return;
+    }
+    size_t record = add_record(block);
+    long found = find_entry(block, operand, hash);
+    if (found >= 0) {
+        struct Cse_Entry *entry = &block->entries[found];
+        entry->count++;
+        entry->needs_temp = entry->needs_temp || entry->holder == NULL ||
+                            last_assigned(block, entry->holder) != entry->held;
+        block->records[record] = (size_t)found;
+        return;
+    }
+    if (conditional) {
+        block->records[record] = NO_ENTRY;
+        count_children(block, operand->value.expr, true);
+        return;
+    }
+    size_t entry = add_entry(block, operand, hash, record);
+    block->records[record] = entry;
+    count_children(block, operand->value.expr, false);
+    block->entries[entry].finished = block->finished++;
+}
+
+static struct AST_Node_Operand *rewrite_operand(struct Cse_Block *block, struct AST_Node_Operand *operand);
+
+// operand with its children rewritten, operand itself if none changed
+static struct AST_Node_Operand *rewrite_children(struct Cse_Block *block, struct AST_Node_Operand *operand) {
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr == NULL || !expr->left_op || !expr->right_op) return operand;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+        exit(1);
+    }
+    bool changed = false;
+    for (size_t i = 0; i < n; i++) {
+        operands[i] = rewrite_operand(block, nth_operand(expr, i));
+        changed = changed || operands[i] != nth_operand(expr, i);
+    }
+    struct AST_Node_Operand *result = operand;
+    if (changed) {
+        struct AST_Node_Expression *copy = (struct AST_Node_Expression *)MALLOC(sizeof(struct AST_Node_Expression));
+        struct AST_Node_Operand **list = expr->n_operands
+            ? (struct AST_Node_Operand **)MALLOC(n * sizeof(*list)) : NULL;
+        struct AST_Node_Operand *node = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        if (!copy || !node || (expr->n_operands && !list)) {
+            // a temporary the rest of the block reads would be left without its value
+            fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+            exit(1);
+        }
+        *copy = *expr;
+        copy->left_op = operands[0];
+        copy->right_op = operands[n - 1];
+        if (list) memcpy(list, operands, n * sizeof(*list));
+        copy->operands = list;
+        *node = *operand;
+        node->value.expr = share_expression(copy);
+        result = share_operand(node);
+    }
+    if (operands != small) FREE(operands);
+    return result;
+}
+
+// operand with the candidates in it read from their temporaries; walks operand as count_operand
+// did, in the same state of the names, taking its records in the same order
+static struct AST_Node_Operand *rewrite_operand(struct Cse_Block *block, struct AST_Node_Operand *operand) {
+    if (operand == NULL || operand->operand_type != CONTENT_TYPE_EXPRESSION) return operand;
+    unsigned int hash;
+    bool named = false;
+    if (!analyze(block, operand, 0, &hash, &named) || !named) return rewrite_children(block, operand);
+    size_t record = block->next_record++;
+    if (block->records[record] == NO_ENTRY) return rewrite_children(block, operand);
+    struct Cse_Entry *entry = &block->entries[block->records[record]];
+    if (entry->record != record) {
+        if (entry->temp == NULL) return operand;
+        eliminated++;
+        return entry->temp;
+    }
+    struct AST_Node_Operand *value = rewrite_children(block, operand);
+    if (entry->temp == NULL || !entry->needs_temp) return value;
+    if (value != operand) entry->value = value;
+    return entry->temp;
+}
+
+static struct AST_Node_Operand *make_name(const char *name, DATA_TYPE type) {
+    struct AST_Node_Operand *operand = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    if (!operand) {
+        fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+        return NULL;
+    }
+    operand->value.val = (char *)name;
+    operand->val_type = type;
+    operand->operand_type = CONTENT_TYPE_ID;
+    return share_operand(operand);
+}
+
+static struct AST_Node_Operand *make_temp(struct AST_Node_Operand *value) {
+    struct AST_Node_Operand *temp = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    char *name = NULL;
+    if (!temp || ASPRINTF(&name, CSE_PREFIX "%lu", next_temp) < 0) {
+        fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+        FREE(temp);
+        return NULL;
+    }
+    next_temp++;
+    temp->value.val = name;
+    temp->val_type = value->val_type;
+    temp->operand_type = CONTENT_TYPE_ID;
+    return share_operand(temp);
+}
+
+// The names x++ and x-- in operand change
+static void assign_increments(struct Cse_Block *block, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) {
+        if (operand->value.funca == NULL) return;
+        for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+            assign_increments(block, p->call_param);
+        }
+        return;
+    }
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION || operand->value.expr == NULL) return;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if ((expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) && expr->left_op &&
+        expr->left_op->operand_type == CONTENT_TYPE_ID) {
+        assign_name(block, expr->left_op->value.val);
+    }
+    if (!expr->left_op || !expr->right_op) return;
+    for (size_t i = 0; i < count_operands(expr); i++) assign_increments(block, nth_operand(expr, i));
+}
+
+// An assignment value, counted or rewritten, and the assignment. Repeats of an expression
+// assigned whole read the variable it is assigned to, as long as that still holds it.
+static void block_assign(struct Cse_Block *block, struct AST_Node_Assign *assign, bool rewrite) {
+    if (has_value(assign)) {
+        struct AST_Node_Operand value = assign_value(assign);
+        size_t first = block->n_records;
+        if (rewrite) {
+            struct AST_Node_Operand *result = rewrite_operand(block, &value);
+            assign->a_val = result->value;
+            assign->a_type = result->operand_type;
+        } else {
+            count_operand(block, &value, false);
+        }
+        assign_name(block, assign->var);
+        struct Cse_Entry *entry = first < block->n_records ? &block->entries[block->records[first]] : NULL;
+        if (!rewrite && entry && entry->record == first && entry->operand.value.expr == value.value.expr &&
+            value.value.expr->expr_type == assign->val_type) {
+            entry->holder = assign->var;
+            entry->held = block->stamp;
+        }
+        return;
+    }
+    assign_name(block, assign->var);
+}
+
+// The expressions instr computes, counted or rewritten, and then the names it assigns
+static void block_statement(struct Cse_Block *block, struct AST_Node_Instruction *instr, bool rewrite) {
+    block->statement_stamp = block->stamp;
+    if (statement_increments(instr)) {
+        switch (instr->n_type) {
+            case ASSIGN_NODE: {
+                struct AST_Node_Operand value = assign_value(instr->value.assign);
+                assign_increments(block, &value);
+                assign_name(block, instr->value.assign->var);
+                break;
+            }
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    if (init->assign == NULL) continue;
+                    if (has_value(init->assign)) {
+                        struct AST_Node_Operand value = assign_value(init->assign);
+                        assign_increments(block, &value);
+                    }
+                    assign_name(block, init->assign->var);
+                }
+                break;
+            case OUTPUT_NODE:
+                for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                    assign_increments(block, out->output_op);
+                }
+                break;
+            case FUNC_CALL_NODE: {
+                struct AST_Node_Operand call = { .value.funca = instr->value.functionCall, .operand_type = CONTENT_TYPE_FUNCTION };
+                assign_increments(block, &call);
+                break;
+            }
+            default:
+                // a return or an if ends the block, what it changes does not matter
+                break;
+        }
+        return;
+    }
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            if (instr->value.assign == NULL) break;
+            block_assign(block, instr->value.assign, rewrite);
+            break;
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                if (init->assign == NULL) continue;
+                block_assign(block, init->assign, rewrite);
+            }
+            break;
+        case INPUT_NODE:
+            for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL; in = in->next_input) {
+                if (in->input_op && in->input_op->operand_type == CONTENT_TYPE_ID) assign_name(block, in->input_op->value.val);
+            }
+            break;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                if (rewrite) {
+                    out->output_op = rewrite_operand(block, out->output_op);
+                } else {
+                    count_operand(block, out->output_op, false);
+                }
+            }
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                struct AST_Node *node = instr->value.returnNode->value;
+                if (rewrite) {
+                    node->value = rewrite_operand(block, (struct AST_Node_Operand *)node->value);
+                } else {
+                    count_operand(block, (struct AST_Node_Operand *)node->value, false);
+                }
+            }
+            break;
+        case IF_NODE: {
+            // the condition stays an expression node, only the operands in it are replaced
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL || if_node->condition == NULL) break;
+            struct AST_Node_Operand condition = { .value.expr = if_node->condition, .val_type = if_node->condition->expr_type,
+                                                  .operand_type = CONTENT_TYPE_EXPRESSION };
+            if (rewrite) {
+                if_node->condition = rewrite_children(block, &condition)->value.expr;
+            } else {
+                count_children(block, if_node->condition, false);
+            }
+            break;
+        }
+        default:
+            // calls: their arguments are left alone, nothing the block computes is assigned
+            break;
+    }
+}
+
+static bool in_block(struct AST_Node_Instruction *instr) {
+    switch (instr->n_type) {
+        case ASSIGN_NODE: case INIT_NODE: case INPUT_NODE: case OUTPUT_NODE: case FUNC_CALL_NODE:
+        case RETURN_NODE: case IF_NODE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool ends_block(struct AST_Node_Instruction *instr) {
+    return instr->n_type == RETURN_NODE || instr->n_type == IF_NODE;
+}
+
+// Temporaries first computed in the current statement, in the order they were finished, so one
+// is assigned after those it reads
+static int compare_finished(const void *a, const void *b) {
+    const struct Cse_Entry *x = *(struct Cse_Entry *const *)a, *y = *(struct Cse_Entry *const *)b;
+    return (x->finished > y->finished) - (x->finished < y->finished);
+}
+
+// Assigns the temporaries of entries [from, to) that have one before statement; returns the node
+// statement ends up in
+static struct AST_Node_Statements *insert_temps(struct Cse_Block *block, struct AST_Node_Statements *statement,
+                                                size_t from, size_t to) {
+    struct Cse_Entry *small[8];
+    struct Cse_Entry **temps = to - from <= 8 ? small : (struct Cse_Entry **)MALLOC((to - from) * sizeof(*temps));
+    if (!temps) {
+        fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+        exit(1);
+    }
+    size_t n = 0;
+    for (size_t i = from; i < to; i++) {
+        if (block->entries[i].temp && block->entries[i].needs_temp) temps[n++] = &block->entries[i];
+    }
+    qsort(temps, n, sizeof(*temps), compare_finished);
+    for (size_t i = 0; i < n; i++) {
+        struct AST_Node_Operand *value = temps[i]->value ? temps[i]->value : &temps[i]->operand;
+        struct AST_Node_Assign *assign = (struct AST_Node_Assign *)MALLOC(sizeof(struct AST_Node_Assign));
+        struct AST_Node_Instruction *node = (struct AST_Node_Instruction *)MALLOC(sizeof(struct AST_Node_Instruction));
+        struct AST_Node_Statements *next = (struct AST_Node_Statements *)MALLOC(sizeof(struct AST_Node_Statements));
+        if (!assign || !node || !next) {
+            fprintf(stderr, "Error: Failed to allocate memory for common subexpressions\n");
+            exit(1);
+        }
+        assign->var = temps[i]->temp->value.val;
+        assign->val_type = value->val_type;
+        assign->a_val = value->value;
+        assign->a_type = value->operand_type;
+        node->n_type = ASSIGN_NODE;
+        node->value.assign = assign;
+        // the assignment takes the statement's place, the statement moves to a new node after it
+        *next = *statement;
+        statement->left = node;
+        statement->right = next;
+        statement = next;
+    }
+    if (temps != small) FREE(temps);
+    return statement;
+}
+
+// The n statements from first on as one block
+static void cse_block(struct AST_Node_Statements *first, size_t n) {
+    struct Cse_Block block = { 0 };
+    struct AST_Node_Statements *list = first;
+    for (size_t i = 0; i < n; list = list->right, i++) {
+        block.statement = i;
+        if (list->left) block_statement(&block, list->left, false);
+    }
+
+    bool repeated = false;
+    for (size_t i = 0; i < block.n_entries; i++) {
+        struct Cse_Entry *entry = &block.entries[i];
+        if (entry->count < 2) continue;
+        entry->temp = entry->needs_temp ? make_temp(&entry->operand) : make_name(entry->holder, entry->operand.val_type);
+        repeated = repeated || entry->temp != NULL;
+    }
+
+    if (repeated) {
+        // the same walk again from the same names, now replacing what has a temporary
+        if (block.names) memset(block.names, 0, block.name_slots * sizeof(*block.names));
+        block.n_names = 0;
+        block.stamp = 0;
+        size_t entry = 0;
+        list = first;
+        for (size_t i = 0; i < n; list = list->right, i++) {
+            if (list->left) block_statement(&block, list->left, true);
+            size_t from = entry;
+            while (entry < block.n_entries && block.entries[entry].statement == i) entry++;
+            if (entry > from) list = insert_temps(&block, list, from, entry);
+        }
+    }
+    FREE(block.names);
+    FREE(block.entries);
+    FREE(block.buckets);
+    FREE(block.records);
+}
+
+static void cse_list(struct AST_Node_Statements *list) {
+    struct AST_Node_Statements *first = NULL;
+    size_t n = 0;
+    for (struct AST_Node_Statements *s = list; s != NULL; s = s->right) {
+        struct AST_Node_Instruction *instr = s->left;
+        if (instr != NULL && !in_block(instr)) {
+            if (n > 0) cse_block(first, n);
+            n = 0;
+            continue;
+        }
+        if (n++ == 0) first = s;
+        if (instr != NULL && ends_block(instr)) {
+            // the temporaries go before s, the walk goes on after it
+            struct AST_Node_Statements *next = s->right;
+            cse_block(first, n);
+            n = 0;
+            while (s->right != next) s = s->right;
+        }
+    }
+    if (n > 0) cse_block(first, n);
+
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL || instr->n_type == CLASS_NODE || instr->n_type == CLASS_CHILD_NODE) continue;
+        struct AST_Node_Statements **bodies[4];
+        size_t n_bodies = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n_bodies; i++) cse_list(*bodies[i]);
+    }
+}
+
+size_t pass_cse(struct AST_Node_Statements **root) {
+    eliminated = 0;
+    cse_list(*root);
+    return eliminated;
+}
@@ -0,0 +1,23 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+
+// Dead code elimination: in every block, statements after a return are dropped.
+static size_t dce_list(struct AST_Node_Statements **list) {
+    size_t removed = 0;
+    for (struct AST_Node_Statements *s = *list; s != NULL; s = s->right) {
+        if (s->left == NULL || s->left->n_type != RETURN_NODE || s->right == NULL) continue;
+        for (struct AST_Node_Statements *dead = s->right; dead != NULL; dead = dead->right) removed++;
+        s->right = NULL;
+        break;
+    }
+    for (struct AST_Node_Statements *s = *list; s != NULL; s = s->right) {
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(s->left, bodies, 4);
+        for (size_t i = 0; i < n; i++) removed += dce_list(bodies[i]);
+    }
+    return removed;
+}
+
+size_t pass_dce(struct AST_Node_Statements **root) {
+    return dce_list(root);
+}
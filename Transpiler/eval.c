@@ -0,0 +1,644 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "symtab.h"
+#include <stdint.h>
+#include <string.h>
+
+// Compile-time evaluation of calls to pure functions.
+//
+// A call whose arguments are all literals, to a function of the top level that prints nothing,
+// reads no input and assigns no name the top level assigns, is run by a small interpreter over
+// the AST and replaced by the literal it returns. The interpreter knows int, float and bool
+// values with the semantics the fold pass folds them with, if, for, return and calls, recursive
+// ones included. Anything else (strings, objects, an int overflow, an int division, a name
+// read before it is assigned) gives up on the call, which is then translated as before.
+//
+// Names are function-scoped, as in the generated Python. Every call of the program runs on a
+// budget of steps of its own (eval_budget, --eval-budget=N, the calls it makes included) and at
+// most EVAL_MAX_DEPTH calls deep; a call out of budget is left alone. Results are remembered per
+// function and arguments for the whole pass run, so recursion that repeats itself (fib) costs one
+// step per distinct call, and a call repeated elsewhere in the program costs none.
+//
+// The pass also folds, like the fold pass, so the results propagate into their uses.
+
+#define EVAL_MAX_DEPTH 256
+#define EVAL_MAX_LOCALS 64            // names one call may bind
+#define EVAL_MEMO_ARGS 4              // calls with more arguments are not remembered
+#define FUNCTIONS_INITIAL_SLOTS 64
+#define MEMO_INITIAL_SLOTS 256
+
+unsigned long eval_budget = 1000000;
+
+// A name of the top level: a function it defines or a variable it assigns
+struct Eval_Name {
+    const char *name;
+    struct AST_Node_FunctionDef *def;
+    bool global;                      /* assigned at the top level */
+    bool overloaded;                  /* defined more than once, not evaluated */
+    int pure;                         /* -1 until checked */
+};
+
+// Result of a call, or its failure
+struct Eval_Memo {
+    struct AST_Node_FunctionDef *def;
+    unsigned int hash;
+    size_t n_args;
+    struct AST_Node_Operand args[EVAL_MEMO_ARGS];
+    struct AST_Node_Operand result;
+    bool ok;
+};
+
+struct Eval_Binding {
+    const char *name;
+    struct AST_Node_Operand value;
+};
+
+enum Eval_Status { EVAL_NEXT, EVAL_RETURN, EVAL_FAIL };
+
+static struct {
+    struct Eval_Name *names;
+    unsigned int *hashes;
+    size_t n_slots;                   /* always a power of two */
+    size_t n_names;
+
+    struct Eval_Memo *memo;
+    size_t memo_slots;
+    size_t n_memo;
+
+    struct Eval_Binding *bindings;    /* locals of the calls being run, innermost call last */
+    size_t n_bindings;
+    size_t bindings_capacity;
+    size_t frame;                     /* first binding of the innermost call */
+    int depth;
+    unsigned long steps;              /* left in the budget of the call being evaluated */
+    struct AST_Node_Operand returned;
+    bool active;                      /* while pass_eval runs */
+} eval;
+
+static enum Eval_Status run_list(struct AST_Node_Statements *list);
+static bool run_operand(struct AST_Node_Operand *operand, struct AST_Node_Operand *value);
+
+/****************** Top level names *****************/
+
+static size_t probe_name(const char *name, unsigned int hash) {
+    size_t mask = eval.n_slots - 1;
+    size_t i = hash & mask;
+    while (eval.names[i].name != NULL) {
+        if (eval.hashes[i] == hash && strcmp(eval.names[i].name, name) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool grow_names(void) {
+    size_t n_slots = eval.n_slots ? eval.n_slots * 2 : FUNCTIONS_INITIAL_SLOTS;
+    struct Eval_Name *names = (struct Eval_Name *)CALLOC(n_slots, sizeof(struct Eval_Name));
+    unsigned int *hashes = (unsigned int *)CALLOC(n_slots, sizeof(unsigned int));
+    if (!names || !hashes) {
+        fprintf(stderr, "Error: Failed to allocate memory for evaluated functions\n");
+        FREE(names);
+        FREE(hashes);
+        return false;
+    }
+    for (size_t i = 0; i < eval.n_slots; i++) {
+        if (eval.names[i].name == NULL) continue;
+        size_t j = eval.hashes[i] & (n_slots - 1);
+        while (names[j].name != NULL) j = (j + 1) & (n_slots - 1);
+        names[j] = eval.names[i];
+        hashes[j] = eval.hashes[i];
+    }
+    FREE(eval.names);
+    FREE(eval.hashes);
+    eval.names = names;
+    eval.hashes = hashes;
+    eval.n_slots = n_slots;
+    return true;
+}
+
+static struct Eval_Name *find_name(const char *name) {
+    if (name == NULL || eval.n_names == 0) return NULL;
+    size_t i = probe_name(name, hash_name(name));
+    return eval.names[i].name ? &eval.names[i] : NULL;
+}
+
+static struct Eval_Name *add_name(const char *name) {
+    if (name == NULL) return NULL;
+    if ((eval.n_names + 1) * 2 > eval.n_slots && !grow_names()) return NULL;
+    unsigned int hash = hash_name(name);
+    size_t i = probe_name(name, hash);
+    if (eval.names[i].name == NULL) {
+        eval.names[i] = (struct Eval_Name){ .name = name, .pure = -1 };
+        eval.hashes[i] = hash;
+        eval.n_names++;
+    }
+    return &eval.names[i];
+}
+
+static void add_global(const char *name) {
+    struct Eval_Name *entry = add_name(name);
+    if (entry) entry->global = true;
+}
+
+// Names the top level assigns, also in its loops and branches
+static void collect_globals(struct AST_Node_Statements *list) {
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        switch (instr->n_type) {
+            case ASSIGN_NODE:
+                if (instr->value.assign) add_global(instr->value.assign->var);
+                break;
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    if (init->assign) add_global(init->assign->var);
+                }
+                break;
+            case INPUT_NODE:
+                if (instr->value.inputNode && instr->value.inputNode->input_op &&
+                    instr->value.inputNode->input_op->operand_type == CONTENT_TYPE_ID) {
+                    add_global(instr->value.inputNode->input_op->value.val);
+                }
+                break;
+            case FOR_NODE:
+                if (instr->value.forNode && instr->value.forNode->init) add_global(instr->value.forNode->init->var);
+                if (instr->value.forNode) collect_globals(instr->value.forNode->for_body);
+                break;
+            case REDUCE_NODE:
+                if (instr->value.reduceNode) add_global(instr->value.reduceNode->var);
+                break;
+            case IF_NODE: {
+                struct AST_Node_Statements **bodies[4];
+                size_t n = nested_bodies(instr, bodies, 4);
+                for (size_t i = 0; i < n; i++) collect_globals(*bodies[i]);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/****************** Purity *****************/
+
+static bool is_local(const char *name) {
+    struct Eval_Name *entry = find_name(name);
+    return name != NULL && (entry == NULL || !entry->global);
+}
+
+static bool pure_operand(struct AST_Node_Operand *operand) {
+    if (operand == NULL) return false;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL) return false;
+            if ((expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) &&
+                (expr->left_op == NULL || expr->left_op->operand_type != CONTENT_TYPE_ID ||
+                 !is_local(expr->left_op->value.val))) {
+                return false;
+            }
+            if (expr->n_operands == 0) return pure_operand(expr->left_op) && pure_operand(expr->right_op);
+            for (size_t i = 0; i < expr->n_operands; i++) {
+                if (!pure_operand(expr->operands[i])) return false;
+            }
+            return true;
+        }
+        case CONTENT_TYPE_FUNCTION:
+            // the function called is checked when the call is run
+            if (operand->value.funca == NULL) return false;
+            for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+                if (!pure_operand(p->call_param)) return false;
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+static bool pure_assign(struct AST_Node_Assign *assign) {
+    if (assign == NULL || !is_local(assign->var)) return false;
+    if (!has_value(assign)) return true;
+    struct AST_Node_Operand value = { .value = assign->a_val, .operand_type = assign->a_type };
+    return pure_operand(&value);
+}
+
+static bool pure_condition(struct AST_Node_Expression *condition) {
+    struct AST_Node_Operand value = { .value.expr = condition, .operand_type = CONTENT_TYPE_EXPRESSION };
+    return condition != NULL && pure_operand(&value);
+}
+
+// Running the statements has no effect outside the call
+static bool pure_list(struct AST_Node_Statements *list) {
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        switch (instr->n_type) {
+            case ASSIGN_NODE:
+                if (!pure_assign(instr->value.assign)) return false;
+                break;
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    if (!pure_assign(init->assign)) return false;
+                }
+                break;
+            case IF_NODE: {
+                struct AST_Node_If *if_node = instr->value.ifNode;
+                if (if_node == NULL || !pure_condition(if_node->condition) || !pure_list(if_node->if_body)) return false;
+                if (if_node->else_if && (!pure_condition(if_node->else_if->condition) ||
+                                         !pure_list(if_node->else_if->elif_body))) {
+                    return false;
+                }
+                if (if_node->else_body && !pure_list(if_node->else_body->else_body)) return false;
+                break;
+            }
+            case FOR_NODE: {
+                struct AST_Node_For *for_node = instr->value.forNode;
+                if (for_node == NULL || !pure_assign(for_node->init) || !pure_condition(for_node->condition) ||
+                    !pure_assign(for_node->increment) || !pure_list(for_node->for_body)) {
+                    return false;
+                }
+                break;
+            }
+            case RETURN_NODE: {
+                struct AST_Node *node = instr->value.returnNode ? instr->value.returnNode->value : NULL;
+                if (node == NULL || !pure_operand((struct AST_Node_Operand *)node->value)) return false;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+static bool is_pure_function(struct Eval_Name *entry) {
+    if (entry->pure < 0) {
+        struct AST_Node_FunctionDef *def = entry->def;
+        entry->pure = def->f_body != NULL && pure_list(def->f_body->func_body) &&
+                      pure_operand(def->f_body->return_op);
+    }
+    return entry->pure;
+}
+
+/****************** Remembered calls *****************/
+
+static unsigned int hash_value(unsigned int hash, const struct AST_Node_Operand *value) {
+    unsigned long long bits = 0;
+    switch (value->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER: bits = (unsigned long long)value->value.ival; break;
+        case CONTENT_TYPE_FLOAT_NUMBER: memcpy(&bits, &value->value.dval, sizeof(bits)); break;
+        default: bits = value->value.bval; break;
+    }
+    hash = (hash ^ (unsigned int)value->operand_type) * 16777619u;
+    hash = (hash ^ (unsigned int)bits) * 16777619u;
+    return (hash ^ (unsigned int)(bits >> 32)) * 16777619u;
+}
+
+// Same literal; floats compare by their bits, 0.0 and -0.0 differ in 1 / x
+static bool same_value(const struct AST_Node_Operand *a, const struct AST_Node_Operand *b) {
+    if (a->operand_type != b->operand_type) return false;
+    switch (a->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER: return a->value.ival == b->value.ival;
+        case CONTENT_TYPE_FLOAT_NUMBER: return memcmp(&a->value.dval, &b->value.dval, sizeof(double)) == 0;
+        default: return a->value.bval == b->value.bval;
+    }
+}
+
+static size_t probe_memo(struct AST_Node_FunctionDef *def, const struct AST_Node_Operand *args, size_t n_args,
+                         unsigned int hash) {
+    size_t mask = eval.memo_slots - 1;
+    size_t i = hash & mask;
+    for (; eval.memo[i].def != NULL; i = (i + 1) & mask) {
+        struct Eval_Memo *memo = &eval.memo[i];
+        if (memo->hash != hash || memo->def != def || memo->n_args != n_args) continue;
+        size_t k = 0;
+        while (k < n_args && same_value(&memo->args[k], &args[k])) k++;
+        if (k == n_args) break;
+    }
+    return i;
+}
+
+static unsigned int hash_call(struct AST_Node_FunctionDef *def, const struct AST_Node_Operand *args, size_t n_args) {
+    unsigned int hash = (unsigned int)(((uintptr_t)def >> 4) * 2654435761u);
+    for (size_t i = 0; i < n_args; i++) hash = hash_value(hash, &args[i]);
+    return hash;
+}
+
+static struct Eval_Memo *find_memo(struct AST_Node_FunctionDef *def, const struct AST_Node_Operand *args, size_t n_args) {
+    if (n_args > EVAL_MEMO_ARGS || eval.n_memo == 0) return NULL;
+    size_t i = probe_memo(def, args, n_args, hash_call(def, args, n_args));
+    return eval.memo[i].def ? &eval.memo[i] : NULL;
+}
+
+static bool grow_memo(void) {
+    size_t n_slots = eval.memo_slots ? eval.memo_slots * 2 : MEMO_INITIAL_SLOTS;
+    struct Eval_Memo *memo = (struct Eval_Memo *)CALLOC(n_slots, sizeof(struct Eval_Memo));
+    if (!memo) {
+        fprintf(stderr, "Error: Failed to allocate memory for evaluated calls\n");
+        return false;
+    }
+    for (size_t i = 0; i < eval.memo_slots; i++) {
+        if (eval.memo[i].def == NULL) continue;
+        size_t j = eval.memo[i].hash & (n_slots - 1);
+        while (memo[j].def != NULL) j = (j + 1) & (n_slots - 1);
+        memo[j] = eval.memo[i];
+    }
+    FREE(eval.memo);
+    eval.memo = memo;
+    eval.memo_slots = n_slots;
+    return true;
+}
+
+static void remember(struct AST_Node_FunctionDef *def, const struct AST_Node_Operand *args, size_t n_args,
+                     bool ok, const struct AST_Node_Operand *result) {
+    if (n_args > EVAL_MEMO_ARGS) return;
+    if ((eval.n_memo + 1) * 2 > eval.memo_slots && !grow_memo()) return;
+    unsigned int hash = hash_call(def, args, n_args);
+    size_t i = probe_memo(def, args, n_args, hash);
+    struct Eval_Memo *memo = &eval.memo[i];
+    if (memo->def == NULL) eval.n_memo++;
+    memo->def = def;
+    memo->hash = hash;
+    memo->n_args = n_args;
+    memcpy(memo->args, args, n_args * sizeof(*args));
+    memo->ok = ok;
+    if (ok) memo->result = *result;
+}
+
+/****************** Interpreter *****************/
+
+static bool step(void) {
+    if (eval.steps == 0) return false;
+    eval.steps--;
+    return true;
+}
+
+static struct Eval_Binding *find_binding(const char *name) {
+    for (size_t i = eval.n_bindings; i > eval.frame; i--) {
+        struct Eval_Binding *binding = &eval.bindings[i - 1];
+        if (binding->name == name || strcmp(binding->name, name) == 0) return binding;
+    }
+    return NULL;
+}
+
+static bool bind(const char *name, const struct AST_Node_Operand *value) {
+    if (name == NULL) return false;
+    struct Eval_Binding *binding = find_binding(name);
+    if (binding == NULL) {
+        if (eval.n_bindings - eval.frame == EVAL_MAX_LOCALS) return false;
+        if (eval.n_bindings == eval.bindings_capacity) {
+            size_t capacity = eval.bindings_capacity ? eval.bindings_capacity * 2 : EVAL_MAX_LOCALS;
+            struct Eval_Binding *bindings = (struct Eval_Binding *)REALLOC(eval.bindings, capacity * sizeof(*bindings));
+            if (!bindings) {
+                fprintf(stderr, "Error: Failed to allocate memory for evaluated locals\n");
+                return false;
+            }
+            eval.bindings = bindings;
+            eval.bindings_capacity = capacity;
+        }
+        binding = &eval.bindings[eval.n_bindings++];
+        binding->name = name;
+    }
+    binding->value = *value;
+    return true;
+}
+
+// The value has the type the declaration gives, C++ converts where the generated Python would not
+static bool has_type(const struct AST_Node_Operand *value, DATA_TYPE type) {
+    switch (type) {
+        case DATA_TYPE_INT: return value->operand_type == CONTENT_TYPE_INT_NUMBER;
+        case DATA_TYPE_FLOAT: return value->operand_type == CONTENT_TYPE_FLOAT_NUMBER;
+        case DATA_TYPE_BOOL: return value->operand_type == CONTENT_TYPE_BOOL;
+        default: return false;
+    }
+}
+
+static bool run_call(struct AST_Node_FunctionCall *call, struct AST_Node_Operand *value) {
+    struct Eval_Name *entry = find_name(call->func_name);
+    if (entry == NULL || entry->def == NULL || entry->overloaded || !is_pure_function(entry)) return false;
+    if (eval.depth == EVAL_MAX_DEPTH) return false;
+    struct AST_Node_FunctionDef *def = entry->def;
+
+    struct AST_Node_Operand small[EVAL_MEMO_ARGS];
+    struct AST_Node_Operand *args = small;
+    size_t n_args = 0;
+    for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) n_args++;
+    if (n_args > EVAL_MEMO_ARGS) {
+        args = (struct AST_Node_Operand *)MALLOC(n_args * sizeof(*args));
+        if (!args) {
+            fprintf(stderr, "Error: Failed to allocate memory for evaluated arguments\n");
+            return false;
+        }
+    }
+    bool ok = true;
+    size_t i = 0;
+    for (struct AST_Node_Params *p = call->params; p != NULL && ok; p = p->next_param) {
+        ok = run_operand(p->call_param, &args[i++]);
+    }
+
+    struct Eval_Memo *memo = ok ? find_memo(def, args, n_args) : NULL;
+    if (memo != NULL) {
+        ok = memo->ok;
+        if (ok) *value = memo->result;
+    } else if (ok) {
+        size_t caller_frame = eval.frame;
+        size_t caller_bindings = eval.n_bindings;
+        eval.frame = eval.n_bindings;
+        eval.depth++;
+        struct AST_Node_Params *p = def->params;
+        for (i = 0; i < n_args && ok; i++, p = p->next_param) {
+            struct AST_Node_Init *param = p ? p->decl_param : NULL;
+            ok = param && param->assign && has_type(&args[i], param->data_type) && bind(param->assign->var, &args[i]);
+        }
+        ok = ok && p == NULL;                     // as many arguments as parameters
+        if (ok) {
+            switch (run_list(def->f_body->func_body)) {
+                case EVAL_RETURN: *value = eval.returned; break;
+                case EVAL_NEXT: ok = run_operand(def->f_body->return_op, value); break;
+                default: ok = false; break;
+            }
+        }
+        ok = ok && has_type(value, def->return_type);
+        eval.depth--;
+        eval.frame = caller_frame;
+        eval.n_bindings = caller_bindings;
+        // out of budget says nothing about the call, the call that ran out fails as a whole
+        if (ok || eval.steps > 0) remember(def, args, n_args, ok, value);
+    }
+    if (args != small) FREE(args);
+    return ok;
+}
+
+static bool run_expression(struct AST_Node_Expression *expr, struct AST_Node_Operand *value) {
+    if (expr == NULL || expr->left_op == NULL || expr->right_op == NULL) return false;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand operand;
+    for (size_t i = 0; i < n; i++) {
+        struct AST_Node_Operand *child = nth_operand(expr, i);
+        if (!run_operand(child, i == 0 ? value : &operand)) return false;
+        if (expr->op == OP_AND || expr->op == OP_OR) {
+            struct AST_Node_Operand *b = i == 0 ? value : &operand;
+            if (b->operand_type != CONTENT_TYPE_BOOL) return false;
+            *value = *b;
+            if (b->value.bval == (expr->op == OP_OR)) return true;      // decided, the rest is not run
+        } else if (i > 0 && !evaluate_constant(expr->op, value, &operand, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool run_operand(struct AST_Node_Operand *operand, struct AST_Node_Operand *value) {
+    if (operand == NULL || !step()) return false;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER:
+        case CONTENT_TYPE_FLOAT_NUMBER:
+        case CONTENT_TYPE_BOOL:
+            *value = *operand;
+            return true;
+        case CONTENT_TYPE_ID: {
+            struct Eval_Binding *binding = operand->value.val ? find_binding(operand->value.val) : NULL;
+            if (binding == NULL) return false;
+            *value = binding->value;
+            return true;
+        }
+        case CONTENT_TYPE_EXPRESSION:
+            // x++ inside an expression is translated as x + 1, so it is not given a value here
+            if (operand->value.expr == NULL || operand->value.expr->op == OP_ADD_ASSIGN ||
+                operand->value.expr->op == OP_SUB_ASSIGN) {
+                return false;
+            }
+            return run_expression(operand->value.expr, value);
+        case CONTENT_TYPE_FUNCTION:
+            return operand->value.funca != NULL && run_call(operand->value.funca, value);
+        default:
+            return false;
+    }
+}
+
+static bool run_assign(struct AST_Node_Assign *assign) {
+    if (assign == NULL || !step()) return false;
+    struct AST_Node_Operand value;
+    if (assign->a_type == CONTENT_TYPE_EXPRESSION && assign->a_val.expr &&
+        (assign->a_val.expr->op == OP_ADD_ASSIGN || assign->a_val.expr->op == OP_SUB_ASSIGN)) {
+        // x++ and x-- as a statement
+        struct AST_Node_Expression *expr = assign->a_val.expr;
+        struct AST_Node_Operand current, amount;
+        if (expr->left_op == NULL || expr->left_op->operand_type != CONTENT_TYPE_ID ||
+            !run_operand(expr->left_op, &current) || !run_operand(expr->right_op, &amount) ||
+            !evaluate_constant(expr->op == OP_ADD_ASSIGN ? OP_ADD : OP_SUB, &current, &amount, &value)) {
+            return false;
+        }
+        return bind(expr->left_op->value.val, &value);
+    }
+    struct AST_Node_Operand operand = assign_value(assign);
+    return run_operand(&operand, &value) && has_type(&value, assign->val_type) && bind(assign->var, &value);
+}
+
+static bool run_condition(struct AST_Node_Expression *condition, bool *taken) {
+    struct AST_Node_Operand value;
+    if (!run_expression(condition, &value) || value.operand_type != CONTENT_TYPE_BOOL) return false;
+    *taken = value.value.bval;
+    return true;
+}
+
+static enum Eval_Status run_instruction(struct AST_Node_Instruction *instr) {
+    if (!step()) return EVAL_FAIL;
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            return run_assign(instr->value.assign) ? EVAL_NEXT : EVAL_FAIL;
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                struct AST_Node_Operand zero = { .operand_type = CONTENT_TYPE_INT_NUMBER, .val_type = DATA_TYPE_INT };
+                if (init->data_type == DATA_TYPE_FLOAT) {
+                    zero = (struct AST_Node_Operand){ .value.dval = 0.0, .operand_type = CONTENT_TYPE_FLOAT_NUMBER,
+                                                      .val_type = DATA_TYPE_FLOAT };
+                } else if (init->data_type == DATA_TYPE_BOOL) {
+                    zero = (struct AST_Node_Operand){ .value.bval = false, .operand_type = CONTENT_TYPE_BOOL,
+                                                      .val_type = DATA_TYPE_BOOL };
+                } else if (init->data_type != DATA_TYPE_INT) {
+                    return EVAL_FAIL;
+                }
+                if (init->assign == NULL || !bind(init->assign->var, &zero)) return EVAL_FAIL;
+            }
+            return EVAL_NEXT;
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            bool taken;
+            if (if_node == NULL || !run_condition(if_node->condition, &taken)) return EVAL_FAIL;
+            if (taken) return run_list(if_node->if_body);
+            if (if_node->else_if) {
+                if (!run_condition(if_node->else_if->condition, &taken)) return EVAL_FAIL;
+                if (taken) return run_list(if_node->else_if->elif_body);
+            }
+            return if_node->else_body ? run_list(if_node->else_body->else_body) : EVAL_NEXT;
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL || !run_assign(for_node->init)) return EVAL_FAIL;
+            for (;;) {
+                bool taken;
+                if (!run_condition(for_node->condition, &taken)) return EVAL_FAIL;
+                if (!taken) return EVAL_NEXT;
+                enum Eval_Status status = run_list(for_node->for_body);
+                if (status != EVAL_NEXT) return status;
+                if (!run_assign(for_node->increment)) return EVAL_FAIL;
+            }
+        }
+        case RETURN_NODE: {
+            struct AST_Node *node = instr->value.returnNode ? instr->value.returnNode->value : NULL;
+            if (node == NULL || !run_operand((struct AST_Node_Operand *)node->value, &eval.returned)) return EVAL_FAIL;
+            return EVAL_RETURN;
+        }
+        default:
+            return EVAL_FAIL;
+    }
+}
+
+static enum Eval_Status run_list(struct AST_Node_Statements *list) {
+    for (; list != NULL; list = list->right) {
+        if (list->left == NULL) continue;
+        enum Eval_Status status = run_instruction(list->left);
+        if (status != EVAL_NEXT) return status;
+    }
+    return EVAL_NEXT;
+}
+
+/****************** Pass *****************/
+
+// Value of a call whose arguments are literals into *result, false if it is not evaluated
+bool eval_call(struct AST_Node_FunctionCall *call, struct AST_Node_Operand *result) {
+    if (!eval.active || call == NULL) return false;
+    for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) {
+        if (!is_literal(p->call_param)) return false;
+    }
+    eval.frame = eval.n_bindings = 0;
+    eval.depth = 0;
+    eval.steps = eval_budget;
+    return run_call(call, result);
+}
+
+static void eval_release(void) {
+    FREE(eval.names);
+    FREE(eval.hashes);
+    FREE(eval.memo);
+    FREE(eval.bindings);
+    memset(&eval, 0, sizeof(eval));
+}
+
+size_t pass_eval(struct AST_Node_Statements **root) {
+    collect_globals(*root);
+    for (struct AST_Node_Statements *list = *root; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL || instr->n_type != FUNC_DEF_NODE) continue;
+        struct AST_Node_FunctionDef *def = instr->value.functionDef;
+        if (def == NULL || def->is_class_method) continue;
+        struct Eval_Name *entry = add_name(def->func_name);
+        if (entry == NULL) continue;
+        if (entry->def != NULL) entry->overloaded = true;
+        entry->def = def;
+    }
+    eval.active = true;
+    size_t changes = fold_tree(root, true);
+    eval_release();
+    return changes;
+}
@@ -0,0 +1,762 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "symtab.h"
+#include <limits.h>
+#include <math.h>
+
+// Constant folding and propagation.
+//
+// Operators over literals are evaluated with C++ semantics: int arithmetic is left alone when it
+// would overflow an int, and int / is not folded at all, since the / it is translated to divides
+// as floats in Python; floats are computed in double precision, as the generated Python does, and
+// a division by zero or a result that is not finite is left for the runtime. Chains of int + and
+// *, && and || are simplified around their constants.
+//
+// The scanner knows no const, so a local counts as constant when its function (or the top level)
+// assigns it exactly once and the value folds to a literal. Its uses after that assignment, in the
+// same block or in blocks nested there, are replaced by the literal: a Python local assigned once
+// holds that value wherever the assignment dominates the use. An if whose condition folds to a
+// constant is replaced by the branch it takes.
+
+#define NAMES_INITIAL_SLOTS 64
+
+// Assignments to one name in a scope, and its constant while one is bound
+struct Fold_Name {
+    const char *name;
+    unsigned int assigns;
+    struct AST_Node_Operand *value;
+};
+
+// Names of a function body or of the top level
+struct Fold_Scope {
+    struct Fold_Name *slots;
+    unsigned int *hashes;
+    size_t n_slots;               /* always a power of two */
+    size_t n_names;
+    struct Fold_Name **bound;     /* names holding a constant, innermost block last */
+    size_t n_bound;
+    size_t bound_capacity;
+    size_t changes;
+};
+
+static void fold_list(struct Fold_Scope *scope, struct AST_Node_Statements **list, struct AST_Node_Operand **result);
+
+static bool evaluate_calls = false;        // set while the eval pass folds
+
+/****************** Names *****************/
+
+static size_t probe_name(struct Fold_Scope *scope, const char *name, unsigned int hash) {
+    size_t mask = scope->n_slots - 1;
+    size_t i = hash & mask;
+    while (scope->slots[i].name != NULL) {
+        if (scope->hashes[i] == hash && strcmp(scope->slots[i].name, name) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool grow_names(struct Fold_Scope *scope) {
+    size_t n_slots = scope->n_slots ? scope->n_slots * 2 : NAMES_INITIAL_SLOTS;
+    struct Fold_Name *slots = (struct Fold_Name *)CALLOC(n_slots, sizeof(struct Fold_Name));
+    unsigned int *hashes = (unsigned int *)CALLOC(n_slots, sizeof(unsigned int));
+    if (!slots || !hashes) {
+        fprintf(stderr, "Error: Failed to allocate memory for folded names\n");
+        FREE(slots);
+        FREE(hashes);
+        return false;
+    }
+    for (size_t i = 0; i < scope->n_slots; i++) {
+        if (scope->slots[i].name == NULL) continue;
+        size_t j = scope->hashes[i] & (n_slots - 1);
+        while (slots[j].name != NULL) j = (j + 1) & (n_slots - 1);
+        slots[j] = scope->slots[i];
+        hashes[j] = scope->hashes[i];
+    }
+    FREE(scope->slots);
+    FREE(scope->hashes);
+    scope->slots = slots;
+    scope->hashes = hashes;
+    scope->n_slots = n_slots;
+    return true;
+}
+
+// Entry of name, NULL if the scope never assigns it
+static struct Fold_Name *find_name(struct Fold_Scope *scope, const char *name) {
+    if (name == NULL || scope->n_slots == 0) return NULL;
+    size_t i = probe_name(scope, name, hash_name(name));
+    return scope->slots[i].name ? &scope->slots[i] : NULL;
+}
+
+// One more assignment to name; a name whose count cannot be kept is never bound
+static void count_assign(struct Fold_Scope *scope, const char *name) {
+    if (name == NULL) return;
+    if ((scope->n_names + 1) * 4 > scope->n_slots * 3 && !grow_names(scope)) return;
+    unsigned int hash = hash_name(name);
+    size_t i = probe_name(scope, name, hash);
+    if (scope->slots[i].name == NULL) {
+        scope->slots[i].name = name;
+        scope->hashes[i] = hash;
+        scope->n_names++;
+    }
+    scope->slots[i].assigns++;
+}
+
+static void bind_name(struct Fold_Scope *scope, struct Fold_Name *entry, struct AST_Node_Operand *value) {
+    if (scope->n_bound == scope->bound_capacity) {
+        size_t capacity = scope->bound_capacity ? scope->bound_capacity * 2 : 16;
+        struct Fold_Name **bound = (struct Fold_Name **)REALLOC(scope->bound, capacity * sizeof(*bound));
+        if (!bound) {
+            fprintf(stderr, "Error: Failed to allocate memory for folded names\n");
+            return;
+        }
+        scope->bound = bound;
+        scope->bound_capacity = capacity;
+    }
+    entry->value = value;
+    scope->bound[scope->n_bound++] = entry;
+}
+
+// Forget the constants bound since mark, their block has ended
+static void unbind_names(struct Fold_Scope *scope, size_t mark) {
+    while (scope->n_bound > mark) scope->bound[--scope->n_bound]->value = NULL;
+}
+
+static void delete_scope(struct Fold_Scope *scope) {
+    FREE(scope->slots);
+    FREE(scope->hashes);
+    FREE(scope->bound);
+}
+
+/****************** Counting assignments *****************/
+
+// x++ and x-- inside an expression assign x as well
+static void count_operand(struct Fold_Scope *scope, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) {
+        if (operand->value.funca == NULL) return;
+        for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+            count_operand(scope, p->call_param);
+        }
+        return;
+    }
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION || operand->value.expr == NULL) return;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if ((expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) && expr->left_op &&
+        expr->left_op->operand_type == CONTENT_TYPE_ID) {
+        count_assign(scope, expr->left_op->value.val);
+    }
+    if (expr->n_operands == 0) {
+        count_operand(scope, expr->left_op);
+        count_operand(scope, expr->right_op);
+        return;
+    }
+    for (size_t i = 0; i < expr->n_operands; i++) count_operand(scope, expr->operands[i]);
+}
+
+static void count_value(struct Fold_Scope *scope, CONTENT_TYPE type, union Value_sym value) {
+    struct AST_Node_Operand operand = { .value = value, .operand_type = type };
+    count_operand(scope, &operand);
+}
+
+static void count_expression(struct Fold_Scope *scope, struct AST_Node_Expression *expr) {
+    if (expr) count_value(scope, CONTENT_TYPE_EXPRESSION, (union Value_sym){ .expr = expr });
+}
+
+// Assignments made by the statements of list and the blocks nested in them; function and class
+// bodies are scopes of their own
+static void count_list(struct Fold_Scope *scope, struct AST_Node_Statements *list) {
+    for (struct AST_Node_Statements *s = list; s != NULL; s = s->right) {
+        struct AST_Node_Instruction *instr = s->left;
+        if (instr == NULL) continue;
+        switch (instr->n_type) {
+            case ASSIGN_NODE:
+                if (instr->value.assign == NULL) break;
+                count_assign(scope, instr->value.assign->var);
+                count_value(scope, instr->value.assign->a_type, instr->value.assign->a_val);
+                break;
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    if (init->assign) count_assign(scope, init->assign->var);
+                }
+                break;
+            case FOR_NODE:
+            case REDUCE_NODE: {
+                // a reduction still holds the loop it replaced
+                struct AST_Node_For *for_node = instr->n_type == FOR_NODE ? instr->value.forNode
+                    : instr->value.reduceNode ? instr->value.reduceNode->loop : NULL;
+                if (for_node == NULL) break;
+                if (for_node->init) {
+                    count_assign(scope, for_node->init->var);
+                    count_value(scope, for_node->init->a_type, for_node->init->a_val);
+                }
+                count_expression(scope, for_node->condition);
+                if (for_node->increment) {
+                    count_assign(scope, for_node->increment->var);
+                    count_value(scope, for_node->increment->a_type, for_node->increment->a_val);
+                }
+                count_list(scope, for_node->for_body);
+                break;
+            }
+            case IF_NODE: {
+                struct AST_Node_If *if_node = instr->value.ifNode;
+                if (if_node == NULL) break;
+                count_expression(scope, if_node->condition);
+                count_list(scope, if_node->if_body);
+                if (if_node->else_if) {
+                    count_expression(scope, if_node->else_if->condition);
+                    count_list(scope, if_node->else_if->elif_body);
+                }
+                if (if_node->else_body) count_list(scope, if_node->else_body->else_body);
+                break;
+            }
+            case INPUT_NODE:
+                for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL; in = in->next_input) {
+                    if (in->input_op) count_assign(scope, in->input_op->value.val);
+                }
+                break;
+            case OUTPUT_NODE:
+                for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                    count_operand(scope, out->output_op);
+                }
+                break;
+            case RETURN_NODE:
+                if (instr->value.returnNode && instr->value.returnNode->value) {
+                    count_operand(scope, (struct AST_Node_Operand *)instr->value.returnNode->value->value);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/****************** Evaluation *****************/
+
+bool is_literal(const struct AST_Node_Operand *operand) {
+    return operand && (operand->operand_type == CONTENT_TYPE_INT_NUMBER ||
+                       operand->operand_type == CONTENT_TYPE_FLOAT_NUMBER ||
+                       operand->operand_type == CONTENT_TYPE_BOOL);
+}
+
+// An int literal C++ would type as int
+static bool is_int_constant(const struct AST_Node_Operand *operand) {
+    return operand && operand->operand_type == CONTENT_TYPE_INT_NUMBER &&
+           operand->value.ival >= INT_MIN && operand->value.ival <= INT_MAX;
+}
+
+// Evaluating the operand has no effect besides its value
+static bool is_pure(struct AST_Node_Operand *operand) {
+    if (operand == NULL || operand->operand_type == CONTENT_TYPE_FUNCTION) return false;
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION) return true;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr == NULL || expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) return false;
+    if (expr->n_operands == 0) return is_pure(expr->left_op) && is_pure(expr->right_op);
+    for (size_t i = 0; i < expr->n_operands; i++) {
+        if (!is_pure(expr->operands[i])) return false;
+    }
+    return true;
+}
+
+static void set_constant(struct AST_Node_Operand *operand, CONTENT_TYPE type, union Value_sym value) {
+    operand->value = value;
+    operand->operand_type = type;
+    operand->val_type = type == CONTENT_TYPE_INT_NUMBER ? DATA_TYPE_INT :
+                        type == CONTENT_TYPE_FLOAT_NUMBER ? DATA_TYPE_FLOAT : DATA_TYPE_BOOL;
+}
+
+static struct AST_Node_Operand *new_literal(CONTENT_TYPE type, union Value_sym value) {
+    struct AST_Node_Operand *literal = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    if (!literal) {
+        fprintf(stderr, "Error: Failed to allocate memory for folded constant\n");
+        return NULL;
+    }
+    set_constant(literal, type, value);
+    return share_operand(literal);
+}
+
+static struct AST_Node_Operand *int_literal(long long value) {
+    return new_literal(CONTENT_TYPE_INT_NUMBER, (union Value_sym){ .ival = (long)value });
+}
+
+static struct AST_Node_Operand *bool_literal(bool value) {
+    return new_literal(CONTENT_TYPE_BOOL, (union Value_sym){ .bval = value });
+}
+
+static bool compare(OP_TYPE op, double a, double b, struct AST_Node_Operand *result) {
+    bool value;
+    switch (op) {
+        case OP_LT: value = a < b; break;
+        case OP_GT: value = a > b; break;
+        case OP_LE: value = a <= b; break;
+        case OP_GE: value = a >= b; break;
+        case OP_EQ: value = a == b; break;
+        case OP_NE: value = a != b; break;
+        default: return false;
+    }
+    set_constant(result, CONTENT_TYPE_BOOL, (union Value_sym){ .bval = value });
+    return true;
+}
+
+// Value C++ computes for left op right into *result, false if it is left for the runtime
+bool evaluate_constant(OP_TYPE op, const struct AST_Node_Operand *left, const struct AST_Node_Operand *right,
+                       struct AST_Node_Operand *result) {
+    if (!is_literal(left) || !is_literal(right) || left->operand_type != right->operand_type) return false;
+    switch (left->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER: {
+            if (!is_int_constant(left) || !is_int_constant(right)) return false;
+            long long a = left->value.ival, b = right->value.ival, r;
+            switch (op) {
+                case OP_ADD: r = a + b; break;
+                case OP_SUB: r = a - b; break;
+                case OP_MUL: r = a * b; break;
+                case OP_DIV:
+                    return false;               // C++ truncates, the / translated is Python's true division
+                default:
+                    return compare(op, (double)a, (double)b, result);
+            }
+            if (r < INT_MIN || r > INT_MAX) return false;
+            set_constant(result, CONTENT_TYPE_INT_NUMBER, (union Value_sym){ .ival = (long)r });
+            return true;
+        }
+        case CONTENT_TYPE_FLOAT_NUMBER: {
+            double a = left->value.dval, b = right->value.dval, r;
+            switch (op) {
+                case OP_ADD: r = a + b; break;
+                case OP_SUB: r = a - b; break;
+                case OP_MUL: r = a * b; break;
+                case OP_DIV:
+                    if (b == 0) return false;
+                    r = a / b;
+                    break;
+                default:
+                    return compare(op, a, b, result);
+            }
+            if (!isfinite(r)) return false;
+            set_constant(result, CONTENT_TYPE_FLOAT_NUMBER, (union Value_sym){ .dval = r });
+            return true;
+        }
+        case CONTENT_TYPE_BOOL:
+            if (op != OP_EQ && op != OP_NE) return false;
+            set_constant(result, CONTENT_TYPE_BOOL,
+                         (union Value_sym){ .bval = (left->value.bval == right->value.bval) == (op == OP_EQ) });
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Literal C++ computes for left op right, NULL if it is not folded
+static struct AST_Node_Operand *evaluate(OP_TYPE op, struct AST_Node_Operand *left, struct AST_Node_Operand *right) {
+    struct AST_Node_Operand value;
+    if (!evaluate_constant(op, left, right, &value)) return NULL;
+    return new_literal(value.operand_type, value.value);
+}
+
+/****************** Folding *****************/
+
+static struct AST_Node_Operand *fold_operand(struct Fold_Scope *scope, struct AST_Node_Operand *operand);
+
+// Operand holding a copy of expr over other operands
+static struct AST_Node_Operand *rebuild_expression(struct AST_Node_Expression *expr,
+                                                   struct AST_Node_Operand **operands, size_t n) {
+    struct AST_Node_Expression *folded = (struct AST_Node_Expression *)CALLOC(1, sizeof(struct AST_Node_Expression));
+    struct AST_Node_Operand *operand = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    struct AST_Node_Operand **copy = n > 2 ? (struct AST_Node_Operand **)MALLOC(n * sizeof(*copy)) : NULL;
+    if (!folded || !operand || (n > 2 && !copy)) {
+        fprintf(stderr, "Error: Failed to allocate memory for folded expression\n");
+        FREE(folded);
+        FREE(operand);
+        FREE(copy);
+        return NULL;
+    }
+    folded->op = expr->op;
+    folded->expr_type = expr->expr_type;
+    folded->left_op = operands[0];
+    folded->right_op = operands[n - 1];
+    if (copy) {
+        memcpy(copy, operands, n * sizeof(*copy));
+        folded->operands = copy;
+        folded->n_operands = n;
+    }
+    operand->value.expr = share_expression(folded);
+    operand->val_type = expr->expr_type;
+    operand->operand_type = CONTENT_TYPE_EXPRESSION;
+    return share_operand(operand);
+}
+
+// && and || around their literals: the value that decides the result ends the chain, the other
+// one is dropped. Sets *n to the operands left, returns the literal the chain folds to if any.
+static struct AST_Node_Operand *simplify_logic(struct AST_Node_Expression *expr,
+                                               struct AST_Node_Operand **operands, size_t *n) {
+    bool decides = expr->op == OP_OR;
+    bool pure = true;
+    size_t kept = 0;
+    for (size_t i = 0; i < *n; i++) {
+        struct AST_Node_Operand *operand = operands[i];
+        if (operand->operand_type != CONTENT_TYPE_BOOL) {
+            pure = pure && is_pure(operand);
+            operands[kept++] = operand;
+            continue;
+        }
+        if (operand->value.bval != decides) continue;
+        if (pure) return operand;                  // nothing before it has an effect
+        operands[kept++] = operand;                // what follows is never evaluated
+        break;
+    }
+    *n = kept;
+    return kept == 0 ? bool_literal(!decides) : NULL;
+}
+
+// int + and * chains: their constants are merged into one, placed last. Sets *n to the
+// operands left, returns the literal the chain folds to if any.
+static struct AST_Node_Operand *simplify_arithmetic(struct AST_Node_Expression *expr,
+                                                    struct AST_Node_Operand **operands, size_t *n) {
+    bool is_add = expr->op == OP_ADD;
+    long long identity = is_add ? 0 : 1;
+    long long constant = identity;
+    size_t n_constants = 0;
+    bool pure = true;
+    for (size_t i = 0; i < *n; i++) {
+        if (!is_int_constant(operands[i])) {
+            pure = pure && is_pure(operands[i]);
+            continue;
+        }
+        constant = is_add ? constant + operands[i]->value.ival : constant * operands[i]->value.ival;
+        if (constant < INT_MIN || constant > INT_MAX) return NULL;   // left for the runtime
+        n_constants++;
+    }
+    if (n_constants == 0) return NULL;
+    if (!is_add && constant == 0 && pure) return int_literal(0);
+    if (n_constants == *n) return int_literal(constant);
+    if (n_constants == 1 && constant != identity) return NULL;       // nothing to merge
+
+    size_t kept = 0;
+    for (size_t i = 0; i < *n; i++) {
+        if (!is_int_constant(operands[i])) operands[kept++] = operands[i];
+    }
+    if (constant != identity) {
+        struct AST_Node_Operand *literal = int_literal(constant);
+        if (literal == NULL) return NULL;
+        operands[kept++] = literal;
+    }
+    *n = kept;
+    return NULL;
+}
+
+static bool is_chain(struct AST_Node_Expression *expr) {
+    return expr->op == OP_AND || expr->op == OP_OR ||
+           ((expr->op == OP_ADD || expr->op == OP_MUL) && expr->expr_type == DATA_TYPE_INT);
+}
+
+// Expression operand with its constants folded, a literal if all of it is constant
+static struct AST_Node_Operand *fold_expression(struct Fold_Scope *scope, struct AST_Node_Operand *operand) {
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr == NULL || !expr->left_op || !expr->right_op) return operand;
+    if (expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) return operand;
+
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for folded expression\n");
+        return operand;
+    }
+    bool changed = false;
+    for (size_t i = 0; i < n; i++) {
+        struct AST_Node_Operand *child = nth_operand(expr, i);
+        operands[i] = fold_operand(scope, child);
+        changed = changed || operands[i] != child;
+    }
+
+    struct AST_Node_Operand *result = NULL;
+    size_t kept = n;
+    if (is_chain(expr)) {
+        result = expr->op == OP_AND || expr->op == OP_OR ? simplify_logic(expr, operands, &kept)
+                                                          : simplify_arithmetic(expr, operands, &kept);
+        if (result == NULL && kept == 1) result = operands[0];
+    } else if (n == 2) {
+        result = evaluate(expr->op, operands[0], operands[1]);
+        // x - 0 on ints, x / 1 would turn the float Python computes back into an int
+        if (result == NULL && expr->expr_type == DATA_TYPE_INT &&
+            operands[1]->operand_type == CONTENT_TYPE_INT_NUMBER &&
+            expr->op == OP_SUB && operands[1]->value.ival == 0) {
+            result = operands[0];
+        }
+    }
+    if (result == NULL && (kept != n || changed)) {
+        result = rebuild_expression(expr, operands, kept);
+    }
+    if (operands != small) FREE(operands);
+    if (result == NULL) return operand;
+    scope->changes++;
+    return result;
+}
+
+// Call operand with its arguments folded
+static struct AST_Node_Operand *fold_arguments(struct Fold_Scope *scope, struct AST_Node_Operand *operand) {
+    struct AST_Node_FunctionCall *call = operand->value.funca;
+    if (call == NULL) return operand;
+    struct AST_Node_Params *first = NULL;         // first argument that folds
+    struct AST_Node_Operand *folded_first = NULL;
+    for (struct AST_Node_Params *p = call->params; p != NULL && first == NULL; p = p->next_param) {
+        struct AST_Node_Operand *folded = fold_operand(scope, p->call_param);
+        if (folded != p->call_param) {
+            first = p;
+            folded_first = folded;
+        }
+    }
+    if (first == NULL) return operand;
+
+    // copied, the call may be reached from elsewhere as well
+    struct AST_Node_FunctionCall *folded = (struct AST_Node_FunctionCall *)MALLOC(sizeof(struct AST_Node_FunctionCall));
+    struct AST_Node_Operand *result = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    if (!folded || !result) {
+        fprintf(stderr, "Error: Failed to allocate memory for folded call\n");
+        FREE(folded);
+        FREE(result);
+        return operand;
+    }
+    *folded = *call;
+    *result = *operand;
+    result->value.funca = folded;
+    struct AST_Node_Params **link = &folded->params;
+    bool past_first = false;                      // arguments before the first one that folds are kept
+    for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) {
+        struct AST_Node_Params *param = (struct AST_Node_Params *)MALLOC(sizeof(struct AST_Node_Params));
+        if (!param) {
+            fprintf(stderr, "Error: Failed to allocate memory for folded call\n");
+            *link = p;                             // the rest stays as it was
+            return result;
+        }
+        *param = *p;
+        if (p == first) {
+            param->call_param = folded_first;
+            past_first = true;
+        } else if (past_first) {
+            param->call_param = fold_operand(scope, p->call_param);
+        }
+        *link = param;
+        link = &param->next_param;
+    }
+    *link = NULL;
+    return result;
+}
+
+// Call operand with its arguments folded, the literal it returns if the eval pass runs it
+static struct AST_Node_Operand *fold_call(struct Fold_Scope *scope, struct AST_Node_Operand *operand) {
+    struct AST_Node_Operand *folded = fold_arguments(scope, operand);
+    struct AST_Node_Operand value;
+    if (!evaluate_calls || !eval_call(folded->value.funca, &value)) return folded;
+    struct AST_Node_Operand *literal = new_literal(value.operand_type, value.value);
+    if (literal == NULL) return folded;
+    scope->changes++;
+    return literal;
+}
+
+// operand with the constants in it folded and the bound names replaced, operand itself if
+// nothing changed
+static struct AST_Node_Operand *fold_operand(struct Fold_Scope *scope, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return NULL;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID: {
+            struct Fold_Name *entry = find_name(scope, operand->value.val);
+            if (entry == NULL || entry->value == NULL) return operand;
+            scope->changes++;
+            return entry->value;
+        }
+        case CONTENT_TYPE_EXPRESSION:
+            return fold_expression(scope, operand);
+        case CONTENT_TYPE_FUNCTION:
+            return fold_call(scope, operand);
+        default:
+            return operand;
+    }
+}
+
+// Fold the value of an assignment; an expression slot that must stay one (a loop increment)
+// keeps its value unless the result is still an expression
+static void fold_assignment(struct Fold_Scope *scope, struct AST_Node_Assign *assign, bool keep_expression) {
+    if (!has_value(assign)) return;
+    struct AST_Node_Operand value = assign_value(assign);
+    size_t changes = scope->changes;
+    struct AST_Node_Operand *folded = fold_operand(scope, &value);
+    if (folded == &value) return;
+    if (keep_expression && folded->operand_type != CONTENT_TYPE_EXPRESSION) {
+        scope->changes = changes;
+        return;
+    }
+    assign->a_type = folded->operand_type;
+    assign->a_val = folded->value;
+}
+
+// Folded condition; *constant is set when it folds to a literal, a condition that folds to a
+// lone name or call is kept as it was since a condition must be an expression node
+static struct AST_Node_Expression *fold_condition(struct Fold_Scope *scope, struct AST_Node_Expression *condition,
+                                                  struct AST_Node_Operand **constant) {
+    *constant = NULL;
+    if (condition == NULL) return NULL;
+    size_t changes = scope->changes;
+    struct AST_Node_Operand value = { .value.expr = condition, .val_type = condition->expr_type,
+                                      .operand_type = CONTENT_TYPE_EXPRESSION };
+    struct AST_Node_Operand *folded = fold_operand(scope, &value);
+    if (folded->operand_type == CONTENT_TYPE_EXPRESSION) return folded->value.expr;
+    if (folded->operand_type == CONTENT_TYPE_BOOL) *constant = folded;
+    scope->changes = changes;                     // counted by the caller if it uses the constant
+    return condition;
+}
+
+// Put the statements of body where the statement at *link is
+static void splice_body(struct AST_Node_Statements **link, struct AST_Node_Statements *body) {
+    struct AST_Node_Statements *rest = (*link)->right;
+    if (body == NULL) {
+        *link = rest;
+        return;
+    }
+    struct AST_Node_Statements *tail = body;
+    while (tail->right != NULL) tail = tail->right;
+    tail->right = rest;
+    *link = body;
+}
+
+// Fold an if; true if the statement at *link was replaced and is to be visited again
+static bool fold_if(struct Fold_Scope *scope, struct AST_Node_Statements **link) {
+    struct AST_Node_If *if_node = (*link)->left->value.ifNode;
+    if (if_node == NULL) return false;
+    struct AST_Node_Operand *constant;
+    if_node->condition = fold_condition(scope, if_node->condition, &constant);
+    if (constant) {
+        scope->changes++;
+        if (constant->value.bval) {
+            splice_body(link, if_node->if_body);
+        } else if (if_node->else_if) {
+            if_node->condition = if_node->else_if->condition;
+            if_node->if_body = if_node->else_if->elif_body;
+            if_node->else_if = NULL;
+        } else {
+            splice_body(link, if_node->else_body ? if_node->else_body->else_body : NULL);
+        }
+        return true;
+    }
+
+    fold_list(scope, &if_node->if_body, NULL);
+    if (if_node->else_if) {
+        if_node->else_if->condition = fold_condition(scope, if_node->else_if->condition, &constant);
+        if (constant && constant->value.bval) {
+            struct AST_Node_Else *else_node = (struct AST_Node_Else *)MALLOC(sizeof(struct AST_Node_Else));
+            if (else_node) {
+                else_node->else_body = if_node->else_if->elif_body;
+                if_node->else_body = else_node;
+                if_node->else_if = NULL;
+                scope->changes++;
+            }
+        } else if (constant) {
+            if_node->else_if = NULL;
+            scope->changes++;
+        }
+        if (if_node->else_if) fold_list(scope, &if_node->else_if->elif_body, NULL);
+    }
+    if (if_node->else_body) fold_list(scope, &if_node->else_body->else_body, NULL);
+    return false;
+}
+
+static void fold_function(struct Fold_Scope *outer, struct AST_Node_FunctionDef *func_def) {
+    if (func_def == NULL || func_def->f_body == NULL) return;
+    struct Fold_Scope scope = { 0 };
+    for (struct AST_Node_Params *p = func_def->params; p != NULL; p = p->next_param) {
+        if (p->decl_param && p->decl_param->assign) count_assign(&scope, p->decl_param->assign->var);
+    }
+    count_list(&scope, func_def->f_body->func_body);
+    count_operand(&scope, func_def->f_body->return_op);
+    fold_list(&scope, &func_def->f_body->func_body, &func_def->f_body->return_op);
+    outer->changes += scope.changes;
+    delete_scope(&scope);
+}
+
+static void fold_instruction(struct Fold_Scope *scope, struct AST_Node_Instruction *instr) {
+    switch (instr->n_type) {
+        case ASSIGN_NODE: {
+            struct AST_Node_Assign *assign = instr->value.assign;
+            if (assign == NULL) break;
+            fold_assignment(scope, assign, false);
+            struct Fold_Name *entry = find_name(scope, assign->var);
+            struct AST_Node_Operand value = { .value = assign->a_val, .operand_type = assign->a_type };
+            if (entry && entry->assigns == 1 && is_literal(&value)) {
+                struct AST_Node_Operand *literal = new_literal(assign->a_type, assign->a_val);
+                if (literal) bind_name(scope, entry, literal);
+            }
+            break;
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL) break;
+            struct AST_Node_Operand *constant;
+            fold_assignment(scope, for_node->init, false);
+            for_node->condition = fold_condition(scope, for_node->condition, &constant);
+            fold_assignment(scope, for_node->increment, true);
+            fold_list(scope, &for_node->for_body, NULL);
+            break;
+        }
+        case OUTPUT_NODE:
+            // a literal is printed as is and could not be concatenated with the other parts
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                size_t changes = scope->changes;
+                struct AST_Node_Operand *folded = fold_operand(scope, out->output_op);
+                if (is_literal(folded) && !is_literal(out->output_op)) scope->changes = changes;
+                else out->output_op = folded;
+            }
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                struct AST_Node *node = instr->value.returnNode->value;
+                node->value = fold_operand(scope, (struct AST_Node_Operand *)node->value);
+            }
+            break;
+        case FUNC_DEF_NODE:
+            fold_function(scope, instr->value.functionDef);
+            break;
+        default:
+            break;
+    }
+}
+
+// x = x, what folding x = x * 1 or x = x + 0 leaves
+static bool is_self_assignment(struct AST_Node_Instruction *instr) {
+    if (instr->n_type != ASSIGN_NODE || instr->value.assign == NULL) return false;
+    struct AST_Node_Assign *assign = instr->value.assign;
+    return assign->a_type == CONTENT_TYPE_ID && same_name(assign->a_val.val, assign->var);
+}
+
+// Fold the statements of a block; result is an operand evaluated at its end, while the
+// constants bound in the block still hold
+static void fold_list(struct Fold_Scope *scope, struct AST_Node_Statements **list, struct AST_Node_Operand **result) {
+    size_t mark = scope->n_bound;
+    struct AST_Node_Statements **link = list;
+    while (*link != NULL) {
+        struct AST_Node_Instruction *instr = (*link)->left;
+        if (instr && instr->n_type == IF_NODE && fold_if(scope, link)) continue;
+        if (instr) fold_instruction(scope, instr);
+        if (instr && is_self_assignment(instr)) {
+            *link = (*link)->right;
+            scope->changes++;
+            continue;
+        }
+        link = &(*link)->right;
+    }
+    if (result) *result = fold_operand(scope, *result);
+    unbind_names(scope, mark);
+}
+
+// Fold the whole tree, also running calls to pure functions when evaluate is set (eval.c)
+size_t fold_tree(struct AST_Node_Statements **root, bool evaluate) {
+    struct Fold_Scope scope = { 0 };
+    evaluate_calls = evaluate;
+    count_list(&scope, *root);
+    fold_list(&scope, root, NULL);
+    delete_scope(&scope);
+    evaluate_calls = false;
+    return scope.changes;
+}
+
+size_t pass_fold(struct AST_Node_Statements **root) {
+    return fold_tree(root, false);
+}
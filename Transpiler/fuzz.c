@@ -0,0 +1,109 @@
+#define _GNU_SOURCE
+#include "alloc.h"
+#include "prescan.h"
+#include "passes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+// libFuzzer entry point: every mutated input goes through the scanner, the parser, the
+// optimization passes and the emitter in-process, like a cpp2py -O2 run on a file. Besides
+// crashes, an input is a finding if it costs too much per byte:
+//
+//     CPP2PY_FUZZ_US_PER_BYTE       CPU microseconds (default 50)
+//     CPP2PY_FUZZ_ALLOCS_PER_BYTE   blocks allocated (default 8)
+//     CPP2PY_FUZZ_BYTES_PER_BYTE    bytes allocated (default 512)
+//
+// Inputs shorter than FUZZ_MIN_BYTES are charged as that long, so that the fixed cost of a
+// run does not count against tiny inputs. Linear work stays under the limits at any size;
+// a quadratic path (a list walked per statement, a lookup scanning every symbol) crosses
+// them once the input is long enough, and libFuzzer keeps and minimizes that input.
+
+#ifndef DEBUG_MEMORY
+#error "the fuzz harness counts allocations, build it with -DDEBUG_MEMORY"
+#endif
+
+#define FUZZ_MIN_BYTES 256
+
+extern char *source_text;
+extern struct Prescan *source_scan;
+extern FILE *fptr;
+int translate_source(const char *emit_ast);
+void release_translation(void);
+void scanner_reset(void);
+
+static double max_us_per_byte = 50;
+static double max_allocs_per_byte = 8;
+static double max_bytes_per_byte = 512;
+
+static double env_limit(const char *name, double fallback) {
+    const char *value = getenv(name);
+    double limit = value ? strtod(value, NULL) : 0;
+    return limit > 0 ? limit : fallback;
+}
+
+static double cpu_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Report an input over a limit and stop, libFuzzer saves it as a crash
+static void check_limit(const char *what, double used, size_t size, double limit) {
+    double charged = size < FUZZ_MIN_BYTES ? FUZZ_MIN_BYTES : (double)size;
+    if (used / charged <= limit) return;
+    fprintf(stderr, "Finding: %zu byte input took %.0f %s, %.1f per byte (limit %.1f)\n",
+            size, used, what, used / charged, limit);
+    abort();
+}
+
+int LLVMFuzzerInitialize(int *argc, char ***argv) {
+    (void)argc;
+    (void)argv;
+    max_us_per_byte = env_limit("CPP2PY_FUZZ_US_PER_BYTE", max_us_per_byte);
+    max_allocs_per_byte = env_limit("CPP2PY_FUZZ_ALLOCS_PER_BYTE", max_allocs_per_byte);
+    max_bytes_per_byte = env_limit("CPP2PY_FUZZ_BYTES_PER_BYTE", max_bytes_per_byte);
+    passes_set_level(MAX_OPT_LEVEL);      // the optimization passes are fuzzed along
+    eval_budget = 1000;                   // a fixed cost per call, kept small against the per-byte limits
+
+    // the scanner and parser trace every token on stdout
+    if (freopen("/dev/null", "w", stdout) == NULL) return 1;
+    fptr = fopen("/dev/null", "w");
+    if (fptr == NULL) {
+        fprintf(stderr, "Error: Cannot open /dev/null\n");
+        exit(1);
+    }
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    source_text = MALLOC(size + 1);
+    if (source_text == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for fuzz input\n");
+        exit(1);
+    }
+    memcpy(source_text, data, size);
+    source_text[size] = '\0';
+    source_scan = new_prescan(source_text, size);
+    if (source_scan == NULL) {
+        release_translation();
+        alloc_release_all();
+        return 0;
+    }
+
+    struct Alloc_Counters before = alloc_totals();
+    double start = cpu_us();
+    translate_source(NULL);
+    double elapsed = cpu_us() - start;
+    struct Alloc_Counters after = alloc_totals();
+
+    scanner_reset();
+    release_translation();
+    alloc_release_all();
+
+    check_limit("us", elapsed, size, max_us_per_byte);
+    check_limit("allocations", (double)(after.allocs - before.allocs), size, max_allocs_per_byte);
+    check_limit("bytes allocated", (double)(after.bytes - before.bytes), size, max_bytes_per_byte);
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <stdbool.h>
+
+// Synthetic C++ corpus for benchmarking: writes at least the requested number of bytes of
+// source in the subset cpp2py accepts (classes with public/private sections, functions with
+// nested if/for, cout and long expressions) to stdout. The same size and seed always give
+// the same program.
+//
+//     gencorpus <size>[K|M|G] [seed]
+//     gencorpus --axis <axis> <n>
+//
+// The second form grows a single dimension of the input for scaling tests: statements in one
+// block, statements in one loop body, nesting depth, expression length, classes, members of
+// one class or call sites.
+
+static uint64_t rng_state;
+
+// xorshift64*, enough to vary constants and shapes between units
+static unsigned rnd(unsigned bound) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (unsigned)((rng_state * 2685821657736338717ull) >> 33) % bound;
+}
+
+// Size with an optional binary K/M/G suffix, 0 on error
+static size_t parse_size(const char *arg) {
+    char *end;
+    errno = 0;
+    unsigned long long n = strtoull(arg, &end, 10);
+    if (errno != 0 || end == arg) return 0;
+    switch (*end) {
+        case 'k': case 'K': n <<= 10; end++; break;
+        case 'm': case 'M': n <<= 20; end++; break;
+        case 'g': case 'G': n <<= 30; end++; break;
+        default: break;
+    }
+    if (*end == 'B' || *end == 'b') end++;
+    return *end == '\0' ? (size_t)n : 0;
+}
+
+// Long arithmetic expression over the names a, b and n, terms terms long
+static int write_expression(FILE *out, int terms) {
+    static const char *names[] = { "a", "b", "n" };
+    static const char *ops[] = { " + ", " - ", " * " };
+    int len = 0;
+    for (int t = 0; t < terms; t++) {
+        if (t > 0) len += fprintf(out, "%s", ops[rnd(3)]);
+        switch (rnd(4)) {
+            case 0:
+                len += fprintf(out, "(%s + %u)", names[rnd(3)], rnd(100));
+                break;
+            case 1:
+                len += fprintf(out, "%s * %u", names[rnd(3)], 1 + rnd(9));
+                break;
+            default:
+                len += fprintf(out, "%s", names[rnd(3)]);
+                break;
+        }
+    }
+    return len;
+}
+
+// One class and one function; returns the bytes written. Function bodies are written as a
+// nested block ({{ ... }\n}), the form the grammar takes for functions other than main.
+static size_t write_unit(FILE *out, unsigned id) {
+    size_t len = 0;
+
+    // fields are declared in the enclosing scope, so their names carry the unit number too
+    len += fprintf(out, "class Shape%u {\n    public:\n        int width%u;\n        int height%u;\n", id, id, id);
+    for (unsigned f = rnd(3); f > 0; f--) len += fprintf(out, "        int extra%u%c;\n", id, (char)('a' + f));
+    len += fprintf(out, "    private:\n        int secret%u;\n}\n\n", id);
+
+    len += fprintf(out, "int calc%u(int p, int q) {{\n", id);
+    len += fprintf(out, "    int a = %u;\n    int b = %u;\n    int n = %u;\n    int total = %u;\n",
+                   1 + rnd(20), 1 + rnd(20), 5 + rnd(20), rnd(10));
+    len += fprintf(out, "    for (int i = 0; i < n; i = i + 1) {\n");
+    len += fprintf(out, "        if (i < a) {\n            total = total + a * i - b;\n");
+    len += fprintf(out, "        } else {\n            total = total - %u;\n        }\n", 1 + rnd(5));
+    len += fprintf(out, "        for (int j = 1; j <= %u; j = j + 1) {\n", 2 + rnd(4));
+    len += fprintf(out, "            total = total + i * j;\n        }\n    }\n");
+    len += fprintf(out, "    int mix = ");
+    len += (size_t)write_expression(out, 6 + (int)rnd(10));
+    len += fprintf(out, ";\n    if (mix > total) {\n        total = mix;\n    }\n");
+    len += fprintf(out, "    cout << \"calc%u \" << total << \" \" << a * b << endl;\n", id);
+    len += fprintf(out, "    return total;\n}\n}\n\n");
+    return len;
+}
+
+// Input that is n long along one axis and small along the others
+static bool write_axis(FILE *out, const char *axis, unsigned n) {
+    fprintf(out, "#include <iostream>\nusing namespace std;\n\n");
+    if (strcmp(axis, "statements") == 0) {
+        fprintf(out, "int main() {\n    int x = 0;\n");
+        for (unsigned i = 0; i < n; i++) {
+            if (i % 2 == 0) fprintf(out, "    int v%u = %u;\n", i, i);
+            else fprintf(out, "    x = x + v%u;\n", i - 1);
+        }
+    } else if (strcmp(axis, "loop") == 0) {
+        // half of the body is invariant in the loop; over parameters, it is not folded away
+        fprintf(out, "int sum(int a, int b, int n) {{\n    int s = 0;\n");
+        fprintf(out, "    for (int i = 0; i < n; i = i + 1) {\n");
+        for (unsigned i = 0; i < n; i++) {
+            if (i % 2 == 0) fprintf(out, "        int t%u = a * b + %u;\n", i, i);
+            else fprintf(out, "        s = s + t%u * i;\n", i - 1);
+        }
+        fprintf(out, "    }\n    return s;\n}\n}\n\nint main() {\n");
+    } else if (strcmp(axis, "nesting") == 0) {
+        // a hundred towers of nested if/for, n levels each
+        fprintf(out, "int main() {\n    int x = 0;\n    int y = 1;\n");
+        for (unsigned tower = 0; tower < 100; tower++) {
+            for (unsigned depth = 0; depth < n; depth++) {
+                if (depth % 2 == 0) fprintf(out, "%*sif (x < y) {\n", 4 + 4 * (int)depth, "");
+                else fprintf(out, "%*sfor (int i%u = 0; i%u < y; i%u = i%u + 1) {\n", 4 + 4 * (int)depth, "", depth, depth, depth, depth);
+                fprintf(out, "%*sx = x + %u;\n", 8 + 4 * (int)depth, "", depth);
+            }
+            for (unsigned depth = n; depth > 0; depth--) fprintf(out, "%*s}\n", 4 * (int)depth, "");
+        }
+    } else if (strcmp(axis, "expression") == 0) {
+        fprintf(out, "int main() {\n    int a = 1;\n    int b = 2;\n    int n = 3;\n    int r = a");
+        for (unsigned t = 1; t < n; t++) {
+            fprintf(out, t % 4 == 0 ? " + %s * %u" : " + %s", t % 3 == 0 ? "a" : t % 3 == 1 ? "b" : "n", t % 7 + 1);
+        }
+        fprintf(out, ";\n");
+    } else if (strcmp(axis, "classes") == 0) {
+        fprintf(out, "class Base {\n    public:\n        int origin;\n}\n\n");
+        for (unsigned i = 0; i < n; i++) {
+            if (i % 2 == 0) fprintf(out, "class Shape%u {\n", i);
+            else fprintf(out, "class Shape%u : public Base {\n", i);
+            fprintf(out, "    public:\n        int width%u;\n    private:\n        int secret%u;\n}\n\n", i, i);
+        }
+        fprintf(out, "int main() {\n");
+    } else if (strcmp(axis, "members") == 0) {
+        fprintf(out, "class Wide {\n    public:\n");
+        for (unsigned i = 0; i < n; i++) {
+            if (i == n / 2) fprintf(out, "    private:\n");
+            fprintf(out, "        int field%u;\n", i);
+        }
+        fprintf(out, "}\n\nint main() {\n");
+    } else if (strcmp(axis, "calls") == 0) {
+        fprintf(out, "int twice(int p) {{\n    int t = 2;\n    return t;\n}\n}\n\n");
+        fprintf(out, "int pair(int p, int q) {{\n    int t = 3;\n    return t;\n}\n}\n\n");
+        fprintf(out, "int main() {\n");
+        for (unsigned i = 0; i < n; i++) {
+            if (i % 2 == 0) fprintf(out, "    int r%u = twice(%u);\n", i, i);
+            else fprintf(out, "    int r%u = pair(%u, %u);\n", i, i, i + 1);
+        }
+    } else {
+        fprintf(stderr, "Unknown axis %s (statements, loop, nesting, expression, classes, members, calls)\n", axis);
+        return false;
+    }
+    fprintf(out, "    return 0;\n}\n");
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    FILE *out = stdout;
+    static char buffer[1 << 16];
+    setvbuf(out, buffer, _IOFBF, sizeof(buffer));
+
+    if (argc == 4 && strcmp(argv[1], "--axis") == 0) {
+        unsigned n = (unsigned)strtoul(argv[3], NULL, 10);
+        if (n == 0 || !write_axis(out, argv[2], n)) return 1;
+    } else {
+        size_t target = argc >= 2 ? parse_size(argv[1]) : 0;
+        if (argc < 2 || argc > 3 || target == 0) {
+            fprintf(stderr, "Usage: %s <size>[K|M|G] [seed]\n       %s --axis <axis> <n>\n", argv[0], argv[0]);
+            return 1;
+        }
+        rng_state = argc == 3 ? strtoull(argv[2], NULL, 10) : 1;
+        if (rng_state == 0) rng_state = 1;
+
+        size_t written = (size_t)fprintf(out, "#include <iostream>\nusing namespace std;\n\n");
+        const size_t main_len = 64;
+        unsigned id = 0;
+        while (written + main_len < target) {
+            written += write_unit(out, id++);
+        }
+        fprintf(out, "int main() {\n    int result = %s;\n    return 0;\n}\n", id > 0 ? "calc0(1, 2)" : "0");
+    }
+
+    if (fflush(out) != 0 || ferror(out)) {
+        fprintf(stderr, "Error: Failed to write corpus\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1010 @@
+#define _GNU_SOURCE
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "symtab.h"
+#include <string.h>
+
+// Inlining of small functions.
+//
+// A call is a Python function call: a frame, the binding of every argument and the return. A call
+// to a small function is replaced by a copy of its body, placed before the statement making the
+// call, and the call by the value the function returns. Its parameters and locals are renamed to
+// __inl<k>_<name> in copy k, so the copy cannot clash with a name of the caller, and every argument
+// is assigned once to its parameter; a parameter the function never assigns takes the name of an
+// argument that is a name instead.
+//
+// A function is inlined when it is not recursive (on no cycle of the call graph), holds at most
+// inline_limit statements besides its final return, returns only there, and reads no name other
+// than its parameters and locals: a copy reading a global would read the caller's name instead.
+// Callees are processed before their callers, so a function is measured with the calls it makes
+// already inlined. A call is inlined only where it is evaluated exactly once when its statement
+// runs (not in an operand of and / or past the first, not in a loop condition or else-if), and
+// only when its arguments are then free of calls: they are computed before the statement, ahead of
+// anything left in it. A function that prints or reads is not inlined after a call its statement
+// still makes, which would then run second. Functions defined twice (overloads that kept their
+// name) and class methods are left alone, as are class bodies.
+
+#define INLINE_PREFIX "__inl"
+
+unsigned long inline_limit = 8;
+
+// A parameter or local of a function, and whether the function assigns it
+struct Inline_Name {
+    const char *name;
+    bool param;
+    bool assigned;
+};
+
+// A function defined at the top level
+struct Inline_Function {
+    const char *name;
+    struct AST_Node_FunctionDef *def;
+    bool overloaded;                  /* defined more than once under this name */
+    size_t *callees;                  /* indices of the functions its body calls */
+    size_t n_callees, callees_capacity;
+    long index, low;                  /* call graph walk, index -1 before it is reached */
+    bool on_stack;
+    bool recursive;
+    // set once its body is final
+    bool inlinable;
+    bool effects;                     /* prints, reads or makes a call */
+    struct AST_Node_Statements *end;  /* statement ending the body copied, its final return */
+    struct AST_Node_Operand *result;  /* value returned */
+    struct Inline_Name *names;
+    size_t n_names, names_capacity;
+    long *name_table;                 /* open addressing on the name, index into names or -1 */
+    size_t name_table_size;
+};
+
+static struct {
+    struct Inline_Function *functions;
+    size_t n_functions, functions_capacity;
+    long *table;                      /* open addressing on the name, index into functions or -1 */
+    size_t table_size;
+    size_t *stack;                    /* call graph walk */
+    size_t n_stack;
+    long next_index;
+} graph;
+
+static unsigned long next_instance = 0;
+static size_t inlined = 0;
+
+// endl is printed as a newline, it names nothing
+static bool is_endl(const char *name) {
+    return same_name(name, "endl");
+}
+
+/****************** Call graph *****************/
+
+static struct AST_Node_Statements *last_statement(struct AST_Node_Statements *list) {
+    while (list != NULL && list->right != NULL) list = list->right;
+    return list;
+}
+
+static struct Inline_Function *graph_find(const char *name) {
+    if (name == NULL || graph.table_size == 0) return NULL;
+    for (size_t i = hash_name(name) & (graph.table_size - 1); graph.table[i] >= 0; i = (i + 1) & (graph.table_size - 1)) {
+        struct Inline_Function *function = &graph.functions[graph.table[i]];
+        if (same_name(function->name, name)) return function;
+    }
+    return NULL;
+}
+
+static bool graph_add(struct AST_Node_FunctionDef *def) {
+    struct Inline_Function *known = graph_find(def->func_name);
+    if (known != NULL) {
+        known->overloaded = true;
+        return true;
+    }
+    if (graph.n_functions == graph.functions_capacity) {
+        size_t capacity = graph.functions_capacity ? graph.functions_capacity * 2 : 16;
+        struct Inline_Function *functions = (struct Inline_Function *)REALLOC(graph.functions, capacity * sizeof(*functions));
+        if (!functions) return false;
+        graph.functions = functions;
+        graph.functions_capacity = capacity;
+    }
+    // the table stays at most half full
+    if (2 * (graph.n_functions + 1) > graph.table_size) {
+        size_t size = graph.table_size ? graph.table_size * 2 : 32;
+        long *table = (long *)MALLOC(size * sizeof(*table));
+        if (!table) return false;
+        for (size_t i = 0; i < size; i++) table[i] = -1;
+        for (size_t f = 0; f < graph.n_functions; f++) {
+            size_t i = hash_name(graph.functions[f].name) & (size - 1);
+            while (table[i] >= 0) i = (i + 1) & (size - 1);
+            table[i] = (long)f;
+        }
+        FREE(graph.table);
+        graph.table = table;
+        graph.table_size = size;
+    }
+    size_t i = hash_name(def->func_name) & (graph.table_size - 1);
+    while (graph.table[i] >= 0) i = (i + 1) & (graph.table_size - 1);
+    graph.table[i] = (long)graph.n_functions;
+    graph.functions[graph.n_functions++] = (struct Inline_Function){ .name = def->func_name, .def = def, .index = -1 };
+    return true;
+}
+
+static void add_callee(struct Inline_Function *caller, const char *name) {
+    struct Inline_Function *callee = graph_find(name);
+    if (callee == NULL) return;
+    size_t index = (size_t)(callee - graph.functions);
+    if (caller->n_callees == caller->callees_capacity) {
+        size_t capacity = caller->callees_capacity ? caller->callees_capacity * 2 : 4;
+        size_t *callees = (size_t *)REALLOC(caller->callees, capacity * sizeof(*callees));
+        if (!callees) {
+            // a missing edge could hide a cycle
+            fprintf(stderr, "Error: Failed to allocate memory for call graph\n");
+            caller->recursive = true;
+            return;
+        }
+        caller->callees = callees;
+        caller->callees_capacity = capacity;
+    }
+    caller->callees[caller->n_callees++] = index;
+}
+
+/****************** Scanning *****************/
+
+// What a function body does, for the call graph or to decide whether it can be inlined
+struct Inline_Scan {
+    struct Inline_Function *function;
+    bool graph;                   /* only the calls are recorded, as edges of the call graph */
+    size_t size;                  /* statements */
+    size_t returns;
+    bool effects;
+    bool unsupported;             /* a statement no copy is made of, or a name could not be recorded */
+};
+
+static struct Inline_Name *find_name(struct Inline_Function *function, const char *name) {
+    if (name == NULL || function->name_table_size == 0) return NULL;
+    size_t mask = function->name_table_size - 1;
+    for (size_t i = hash_name(name) & mask; function->name_table[i] >= 0; i = (i + 1) & mask) {
+        struct Inline_Name *known = &function->names[function->name_table[i]];
+        if (same_name(known->name, name)) return known;
+    }
+    return NULL;
+}
+
+static void forget_names(struct Inline_Function *function) {
+    function->n_names = 0;
+    for (size_t i = 0; i < function->name_table_size; i++) function->name_table[i] = -1;
+}
+
+static bool add_name(struct Inline_Function *function, struct Inline_Name name) {
+    if (function->n_names == function->names_capacity) {
+        size_t capacity = function->names_capacity ? function->names_capacity * 2 : 8;
+        struct Inline_Name *names = (struct Inline_Name *)REALLOC(function->names, capacity * sizeof(*names));
+        if (!names) return false;
+        function->names = names;
+        function->names_capacity = capacity;
+    }
+    // the table stays at most half full
+    if (2 * (function->n_names + 1) > function->name_table_size) {
+        size_t size = function->name_table_size ? function->name_table_size * 2 : 16;
+        long *table = (long *)MALLOC(size * sizeof(*table));
+        if (!table) return false;
+        for (size_t i = 0; i < size; i++) table[i] = -1;
+        for (size_t n = 0; n < function->n_names; n++) {
+            size_t i = hash_name(function->names[n].name) & (size - 1);
+            while (table[i] >= 0) i = (i + 1) & (size - 1);
+            table[i] = (long)n;
+        }
+        FREE(function->name_table);
+        function->name_table = table;
+        function->name_table_size = size;
+    }
+    size_t i = hash_name(name.name) & (function->name_table_size - 1);
+    while (function->name_table[i] >= 0) i = (i + 1) & (function->name_table_size - 1);
+    function->name_table[i] = (long)function->n_names;
+    function->names[function->n_names++] = name;
+    return true;
+}
+
+// Name read by (assigned false) or assigned in the function scanned
+static void scan_name(struct Inline_Scan *scan, const char *name, bool assigned, bool param) {
+    if (scan->graph || name == NULL || is_endl(name)) return;
+    struct Inline_Function *function = scan->function;
+    struct Inline_Name *known = find_name(function, name);
+    if (known != NULL) {
+        known->assigned = known->assigned || assigned;
+        return;
+    }
+    // a name read first is only a local if the function assigns it somewhere
+    if (!add_name(function, (struct Inline_Name){ name, param, assigned })) scan->unsupported = true;
+}
+
+static void scan_operand(struct Inline_Scan *scan, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID:
+            scan_name(scan, operand->value.val, false, false);
+            break;
+        case CONTENT_TYPE_FUNCTION:
+            if (operand->value.funca == NULL) break;
+            scan->effects = true;
+            if (scan->graph) add_callee(scan->function, operand->value.funca->func_name);
+            for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+                scan_operand(scan, p->call_param);
+            }
+            break;
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL) break;
+            if ((expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) && expr->left_op &&
+                expr->left_op->operand_type == CONTENT_TYPE_ID) {
+                scan_name(scan, expr->left_op->value.val, true, false);
+            }
+            if (!expr->left_op || !expr->right_op) break;
+            for (size_t i = 0; i < count_operands(expr); i++) scan_operand(scan, nth_operand(expr, i));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void scan_assign(struct Inline_Scan *scan, struct AST_Node_Assign *assign) {
+    if (assign == NULL) return;
+    if (has_value(assign)) {
+        struct AST_Node_Operand value = assign_value(assign);
+        scan_operand(scan, &value);
+    }
+    scan_name(scan, assign->var, true, false);
+}
+
+static void scan_condition(struct Inline_Scan *scan, struct AST_Node_Expression *condition) {
+    if (condition == NULL) return;
+    struct AST_Node_Operand operand = { .value.expr = condition, .val_type = condition->expr_type,
+                                        .operand_type = CONTENT_TYPE_EXPRESSION };
+    scan_operand(scan, &operand);
+}
+
+// Statements of list up to end, and the blocks nested in them
+static void scan_list(struct Inline_Scan *scan, struct AST_Node_Statements *list, struct AST_Node_Statements *end) {
+    for (; list != end && list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        scan->size++;
+        switch (instr->n_type) {
+            case ASSIGN_NODE:
+                scan_assign(scan, instr->value.assign);
+                break;
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    scan_assign(scan, init->assign);
+                }
+                break;
+            case INPUT_NODE:
+                scan->effects = true;
+                for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL; in = in->next_input) {
+                    if (in->input_op && in->input_op->operand_type == CONTENT_TYPE_ID) {
+                        scan_name(scan, in->input_op->value.val, true, false);
+                    }
+                }
+                break;
+            case OUTPUT_NODE:
+                scan->effects = true;
+                for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                    scan_operand(scan, out->output_op);
+                }
+                break;
+            case FUNC_CALL_NODE: {
+                struct AST_Node_Operand call = { .value.funca = instr->value.functionCall, .operand_type = CONTENT_TYPE_FUNCTION };
+                scan_operand(scan, &call);
+                break;
+            }
+            case RETURN_NODE:
+                scan->returns++;
+                if (instr->value.returnNode && instr->value.returnNode->value) {
+                    scan_operand(scan, (struct AST_Node_Operand *)instr->value.returnNode->value->value);
+                }
+                break;
+            case IF_NODE: {
+                struct AST_Node_If *if_node = instr->value.ifNode;
+                if (if_node == NULL) break;
+                scan_condition(scan, if_node->condition);
+                if (if_node->else_if) scan_condition(scan, if_node->else_if->condition);
+                break;
+            }
+            case FOR_NODE: {
+                struct AST_Node_For *for_node = instr->value.forNode;
+                if (for_node == NULL) break;
+                scan_assign(scan, for_node->init);
+                scan_condition(scan, for_node->condition);
+                scan_assign(scan, for_node->increment);
+                break;
+            }
+            default:
+                scan->unsupported = true;
+                break;
+        }
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) scan_list(scan, *bodies[i], NULL);
+    }
+}
+
+// Decide whether the function, its body now final, can be inlined
+static void analyze_function(struct Inline_Function *function) {
+    struct AST_Node_FunctionDef *def = function->def;
+    function->inlinable = false;
+    if (function->overloaded || function->recursive || def->is_class_method || def->f_body == NULL ||
+        same_name(def->func_name, "main")) {
+        return;
+    }
+
+    // the value returned: a return ending the body, or else the return expression, which is
+    // emitted only for a body without return statements
+    struct AST_Node_Statements *body = def->f_body->func_body;
+    struct AST_Node_Statements *last = last_statement(body);
+    function->result = def->f_body->return_op;
+    function->end = NULL;
+    if (last != NULL && last->left != NULL && last->left->n_type == RETURN_NODE) {
+        struct AST_Node_Return *return_node = last->left->value.returnNode;
+        if (return_node == NULL || return_node->value == NULL) return;
+        function->result = (struct AST_Node_Operand *)return_node->value->value;
+        function->end = last;
+    }
+    if (function->result == NULL) return;
+
+    forget_names(function);
+    struct Inline_Scan scan = { .function = function };
+    size_t n_params = 0;
+    for (struct AST_Node_Params *p = def->params; p != NULL; p = p->next_param, n_params++) {
+        if (p->decl_param == NULL || p->decl_param->assign == NULL) return;
+        scan_name(&scan, p->decl_param->assign->var, false, true);
+    }
+    // every parameter is bound to its own argument
+    if (function->n_names != n_params) return;
+    scan_list(&scan, body, function->end);
+    scan_operand(&scan, function->result);
+    if (scan.unsupported || scan.returns > 0 || scan.size > inline_limit) return;
+    for (size_t i = 0; i < function->n_names; i++) {
+        if (!function->names[i].param && !function->names[i].assigned) return;
+    }
+    function->effects = scan.effects;
+    function->inlinable = true;
+}
+
+/****************** Copies *****************/
+
+// Names of the function being inlined and the ones they have in the copy
+struct Inline_Copy {
+    struct Inline_Function *function;
+    const char **renamed;         /* by index into function->names */
+    bool failed;                  /* an allocation failed, the copy is dropped */
+};
+
+static const char *copy_name(struct Inline_Copy *copy, const char *name) {
+    struct Inline_Name *known = find_name(copy->function, name);
+    return known != NULL ? copy->renamed[known - copy->function->names] : name;
+}
+
+static void *copy_node(struct Inline_Copy *copy, const void *node, size_t size) {
+    void *result = MALLOC(size);
+    if (!result) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        copy->failed = true;
+        return NULL;
+    }
+    memcpy(result, node, size);
+    return result;
+}
+
+static struct AST_Node_Operand *copy_operand(struct Inline_Copy *copy, struct AST_Node_Operand *operand);
+
+static struct AST_Node_Expression *copy_expression(struct Inline_Copy *copy, struct AST_Node_Expression *expr) {
+    if (expr == NULL || !expr->left_op || !expr->right_op) return expr;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        copy->failed = true;
+        return expr;
+    }
+    bool changed = false;
+    for (size_t i = 0; i < n; i++) {
+        operands[i] = copy_operand(copy, nth_operand(expr, i));
+        changed = changed || operands[i] != nth_operand(expr, i);
+    }
+    struct AST_Node_Expression *result = expr;
+    if (changed) {
+        result = (struct AST_Node_Expression *)copy_node(copy, expr, sizeof(*expr));
+        struct AST_Node_Operand **list = expr->n_operands
+            ? (struct AST_Node_Operand **)copy_node(copy, operands, n * sizeof(*operands)) : NULL;
+        if (result && (list || !expr->n_operands)) {
+            result->left_op = operands[0];
+            result->right_op = operands[n - 1];
+            result->operands = list;
+            result = share_expression(result);
+        } else {
+            FREE(result);
+            FREE(list);
+            result = expr;
+        }
+    }
+    if (operands != small) FREE(operands);
+    return result;
+}
+
+static struct AST_Node_Params *copy_arguments(struct Inline_Copy *copy, struct AST_Node_Params *params) {
+    if (params == NULL) return NULL;
+    struct AST_Node_Params *rest = copy_arguments(copy, params->next_param);
+    struct AST_Node_Operand *argument = copy_operand(copy, params->call_param);
+    if (rest == params->next_param && argument == params->call_param) return params;
+    struct AST_Node_Params *result = (struct AST_Node_Params *)copy_node(copy, params, sizeof(*params));
+    if (!result) return params;
+    result->call_param = argument;
+    result->next_param = rest;
+    return result;
+}
+
+static struct AST_Node_FunctionCall *copy_call(struct Inline_Copy *copy, struct AST_Node_FunctionCall *call) {
+    if (call == NULL) return NULL;
+    struct AST_Node_Params *params = copy_arguments(copy, call->params);
+    if (params == call->params) return call;
+    struct AST_Node_FunctionCall *result = (struct AST_Node_FunctionCall *)copy_node(copy, call, sizeof(*call));
+    if (!result) return call;
+    result->params = params;
+    return result;
+}
+
+// operand with the names renamed, operand itself if it reads none
+static struct AST_Node_Operand *copy_operand(struct Inline_Copy *copy, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return NULL;
+    struct AST_Node_Operand result = *operand;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID: {
+            const char *name = copy_name(copy, operand->value.val);
+            if (name == operand->value.val) return operand;
+            result.value.val = (char *)name;
+            break;
+        }
+        case CONTENT_TYPE_EXPRESSION:
+            result.value.expr = copy_expression(copy, operand->value.expr);
+            if (result.value.expr == operand->value.expr) return operand;
+            break;
+        case CONTENT_TYPE_FUNCTION:
+            result.value.funca = copy_call(copy, operand->value.funca);
+            if (result.value.funca == operand->value.funca) return operand;
+            break;
+        default:
+            return operand;
+    }
+    struct AST_Node_Operand *node = (struct AST_Node_Operand *)copy_node(copy, &result, sizeof(result));
+    return node ? share_operand(node) : operand;
+}
+
+// Statement nodes are copied whether they change or not, later passes rewrite them in place
+static struct AST_Node_Assign *copy_assign(struct Inline_Copy *copy, struct AST_Node_Assign *assign) {
+    if (assign == NULL) return NULL;
+    struct AST_Node_Assign *result = (struct AST_Node_Assign *)copy_node(copy, assign, sizeof(*assign));
+    if (!result) return NULL;
+    result->var = (char *)copy_name(copy, assign->var);
+    if (!has_value(assign)) return result;
+    struct AST_Node_Operand value = assign_value(assign);
+    struct AST_Node_Operand *copied = copy_operand(copy, &value);
+    result->a_val = copied->value;
+    result->a_type = copied->operand_type;
+    return result;
+}
+
+static struct AST_Node_Statements *copy_list(struct Inline_Copy *copy, struct AST_Node_Statements *list,
+                                             struct AST_Node_Statements *end);
+
+static struct AST_Node_Instruction *copy_instruction(struct Inline_Copy *copy, struct AST_Node_Instruction *instr) {
+    struct AST_Node_Instruction *result = (struct AST_Node_Instruction *)copy_node(copy, instr, sizeof(*instr));
+    if (!result) return NULL;
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            result->value.assign = copy_assign(copy, instr->value.assign);
+            break;
+        case INIT_NODE: {
+            struct AST_Node_Init **link = &result->value.init;
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL && !copy->failed; init = init->next_init) {
+                struct AST_Node_Init *node = (struct AST_Node_Init *)copy_node(copy, init, sizeof(*init));
+                if (!node) break;
+                node->assign = copy_assign(copy, init->assign);
+                *link = node;
+                link = &node->next_init;
+            }
+            *link = NULL;
+            break;
+        }
+        case INPUT_NODE: {
+            struct AST_Node_Input **link = &result->value.inputNode;
+            for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL && !copy->failed; in = in->next_input) {
+                struct AST_Node_Input *node = (struct AST_Node_Input *)copy_node(copy, in, sizeof(*in));
+                if (!node) break;
+                node->input_op = copy_operand(copy, in->input_op);
+                *link = node;
+                link = &node->next_input;
+            }
+            *link = NULL;
+            break;
+        }
+        case OUTPUT_NODE: {
+            struct AST_Node_Output **link = &result->value.outputNode;
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL && !copy->failed; out = out->next_output) {
+                struct AST_Node_Output *node = (struct AST_Node_Output *)copy_node(copy, out, sizeof(*out));
+                if (!node) break;
+                node->output_op = copy_operand(copy, out->output_op);
+                *link = node;
+                link = &node->next_output;
+            }
+            *link = NULL;
+            break;
+        }
+        case FUNC_CALL_NODE:
+            result->value.functionCall = copy_call(copy, instr->value.functionCall);
+            break;
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL) break;
+            struct AST_Node_If *node = (struct AST_Node_If *)copy_node(copy, if_node, sizeof(*if_node));
+            if (!node) break;
+            node->condition = copy_expression(copy, if_node->condition);
+            node->if_body = copy_list(copy, if_node->if_body, NULL);
+            if (if_node->else_if) {
+                node->else_if = (struct AST_Node_Else_If *)copy_node(copy, if_node->else_if, sizeof(*if_node->else_if));
+                if (node->else_if) {
+                    node->else_if->condition = copy_expression(copy, if_node->else_if->condition);
+                    node->else_if->elif_body = copy_list(copy, if_node->else_if->elif_body, NULL);
+                }
+            }
+            if (if_node->else_body) {
+                node->else_body = (struct AST_Node_Else *)copy_node(copy, if_node->else_body, sizeof(*if_node->else_body));
+                if (node->else_body) node->else_body->else_body = copy_list(copy, if_node->else_body->else_body, NULL);
+            }
+            result->value.ifNode = node;
+            break;
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL) break;
+            struct AST_Node_For *node = (struct AST_Node_For *)copy_node(copy, for_node, sizeof(*for_node));
+            if (!node) break;
+            node->init = copy_assign(copy, for_node->init);
+            node->condition = copy_expression(copy, for_node->condition);
+            node->increment = copy_assign(copy, for_node->increment);
+            node->for_body = copy_list(copy, for_node->for_body, NULL);
+            result->value.forNode = node;
+            break;
+        }
+        default:
+            copy->failed = true;
+            break;
+    }
+    return result;
+}
+
+static struct AST_Node_Statements *copy_list(struct Inline_Copy *copy, struct AST_Node_Statements *list,
+                                             struct AST_Node_Statements *end) {
+    struct AST_Node_Statements *head = NULL;
+    struct AST_Node_Statements **link = &head;
+    for (; list != end && list != NULL && !copy->failed; list = list->right) {
+        struct AST_Node_Statements *node = (struct AST_Node_Statements *)copy_node(copy, list, sizeof(*list));
+        if (!node) break;
+        if (list->left) node->left = copy_instruction(copy, list->left);
+        *link = node;
+        link = &node->right;
+    }
+    *link = NULL;
+    return head;
+}
+
+/****************** Inlining *****************/
+
+// The statement calls are inlined in
+struct Inline_Site {
+    struct AST_Node_Statements **link;    /* link to the statement, the copies go in front of it */
+    bool calls_before;                    /* a call left in place is evaluated before the next one */
+};
+
+static bool has_call(struct AST_Node_Operand *operand) {
+    if (operand == NULL) return false;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) return true;
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION || operand->value.expr == NULL) return false;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (!expr->left_op || !expr->right_op) return false;
+    for (size_t i = 0; i < count_operands(expr); i++) {
+        if (has_call(nth_operand(expr, i))) return true;
+    }
+    return false;
+}
+
+// One-statement list assigning value to name
+static struct AST_Node_Statements *make_assign(const char *name, struct AST_Node_Operand *value) {
+    struct AST_Node_Assign *assign = (struct AST_Node_Assign *)MALLOC(sizeof(struct AST_Node_Assign));
+    struct AST_Node_Instruction *node = (struct AST_Node_Instruction *)MALLOC(sizeof(struct AST_Node_Instruction));
+    struct AST_Node_Statements *statement = (struct AST_Node_Statements *)MALLOC(sizeof(struct AST_Node_Statements));
+    if (!assign || !node || !statement) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        FREE(assign);
+        FREE(node);
+        FREE(statement);
+        return NULL;
+    }
+    assign->var = (char *)name;
+    assign->val_type = value->val_type;
+    assign->a_val = value->value;
+    assign->a_type = value->operand_type;
+    node->n_type = ASSIGN_NODE;
+    node->value.assign = assign;
+    statement->n_type = STATEMENTS_NODE;
+    statement->left = node;
+    statement->right = NULL;
+    return statement;
+}
+
+// Put the statements of list before the statement of site
+static void insert_before(struct Inline_Site *site, struct AST_Node_Statements *list) {
+    if (list == NULL) return;
+    struct AST_Node_Statements *last = list;
+    while (last->right != NULL) last = last->right;
+    last->right = *site->link;
+    *site->link = list;
+    site->link = &last->right;
+}
+
+// Replace call, its arguments free of calls, by a copy of the function it calls; the value it
+// returns, or NULL if the call stays
+static struct AST_Node_Operand *inline_call(struct Inline_Site *site, struct AST_Node_FunctionCall *call) {
+    struct Inline_Function *function = graph_find(call->func_name);
+    if (function == NULL || !function->inlinable || (function->effects && site->calls_before)) return NULL;
+    size_t n_params = 0, n_arguments = 0;
+    for (struct AST_Node_Params *p = function->def->params; p != NULL; p = p->next_param) n_params++;
+    for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) {
+        if (p->call_param == NULL || has_call(p->call_param)) return NULL;
+        n_arguments++;
+    }
+    if (n_params != n_arguments) return NULL;
+
+    const char *small[16];
+    const char **renamed = function->n_names <= 16 ? small : (const char **)MALLOC(function->n_names * sizeof(*renamed));
+    if (!renamed) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        return NULL;
+    }
+    unsigned long instance = next_instance++;
+    struct Inline_Copy copy = { .function = function, .renamed = renamed };
+    struct AST_Node_Statements *head = NULL;
+    struct AST_Node_Statements **link = &head;
+
+    // a parameter is bound to its argument: by name if it is one the function never assigns,
+    // otherwise by an assignment ahead of the body
+    struct AST_Node_Params *argument = call->params;
+    for (size_t i = 0; i < function->n_names && !copy.failed; i++) {
+        struct Inline_Name *name = &function->names[i];
+        renamed[i] = NULL;
+        if (name->param) {
+            struct AST_Node_Operand *value = argument->call_param;
+            argument = argument->next_param;
+            if (!name->assigned && value->operand_type == CONTENT_TYPE_ID) {
+                renamed[i] = value->value.val;
+                continue;
+            }
+            char *temp = NULL;
+            if (ASPRINTF(&temp, INLINE_PREFIX "%lu_%s", instance, name->name) < 0) {
+                copy.failed = true;
+                break;
+            }
+            renamed[i] = temp;
+            *link = make_assign(temp, value);
+            if (*link == NULL) {
+                copy.failed = true;
+                break;
+            }
+            link = &(*link)->right;
+        } else {
+            char *local = NULL;
+            if (ASPRINTF(&local, INLINE_PREFIX "%lu_%s", instance, name->name) < 0) {
+                copy.failed = true;
+                break;
+            }
+            renamed[i] = local;
+        }
+    }
+    struct AST_Node_Operand *result = NULL;
+    if (!copy.failed) {
+        *link = copy_list(&copy, function->def->f_body->func_body, function->end);
+        result = copy_operand(&copy, function->result);
+    }
+    if (renamed != small) FREE(renamed);
+    if (copy.failed) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        return NULL;
+    }
+    insert_before(site, head);
+    inlined++;
+    return result;
+}
+
+static struct AST_Node_Operand *inline_operand(struct Inline_Site *site, struct AST_Node_Operand *operand, bool conditional);
+
+// call with the calls in its arguments inlined, call itself if none is
+static struct AST_Node_FunctionCall *inline_arguments(struct Inline_Site *site, struct AST_Node_FunctionCall *call) {
+    struct AST_Node_Params *params = NULL;
+    struct AST_Node_Params **link = &params;
+    bool changed = false;
+    for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) {
+        struct AST_Node_Operand *argument = inline_operand(site, p->call_param, false);
+        struct AST_Node_Params *param = (struct AST_Node_Params *)MALLOC(sizeof(struct AST_Node_Params));
+        if (!param) {
+            // the copies of the arguments inlined so far are in place, their values must be read
+            fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+            exit(1);
+        }
+        *param = *p;
+        param->call_param = argument;
+        changed = changed || argument != p->call_param;
+        *link = param;
+        link = &param->next_param;
+    }
+    *link = NULL;
+    if (!changed) {
+        while (params != NULL) {
+            struct AST_Node_Params *next = params->next_param;
+            FREE(params);
+            params = next;
+        }
+        return call;
+    }
+    struct AST_Node_FunctionCall *result = (struct AST_Node_FunctionCall *)MALLOC(sizeof(struct AST_Node_FunctionCall));
+    if (!result) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        exit(1);
+    }
+    *result = *call;
+    result->params = params;
+    return result;
+}
+
+// operand with the calls in it inlined, in evaluation order; operand itself if none is
+static struct AST_Node_Operand *inline_operand(struct Inline_Site *site, struct AST_Node_Operand *operand, bool conditional) {
+    if (operand == NULL) return NULL;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) {
+        if (operand->value.funca == NULL) return operand;
+        if (conditional) {
+            site->calls_before = true;
+            return operand;
+        }
+        struct AST_Node_FunctionCall *call = inline_arguments(site, operand->value.funca);
+        struct AST_Node_Operand *result = inline_call(site, call);
+        if (result != NULL) return result;
+        site->calls_before = true;
+        if (call == operand->value.funca) return operand;
+        result = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        if (!result) {
+            fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+            exit(1);
+        }
+        *result = *operand;
+        result->value.funca = call;
+        return result;
+    }
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION) return operand;
+
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr == NULL || !expr->left_op || !expr->right_op) return operand;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        exit(1);
+    }
+    bool changed = false;
+    for (size_t i = 0; i < n; i++) {
+        operands[i] = inline_operand(site, nth_operand(expr, i), conditional || conditional_operand(expr, i));
+        changed = changed || operands[i] != nth_operand(expr, i);
+    }
+    struct AST_Node_Operand *result = operand;
+    if (changed) {
+        struct AST_Node_Expression *copy = (struct AST_Node_Expression *)MALLOC(sizeof(struct AST_Node_Expression));
+        struct AST_Node_Operand **list = expr->n_operands
+            ? (struct AST_Node_Operand **)MALLOC(n * sizeof(*list)) : NULL;
+        struct AST_Node_Operand *node = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        if (!copy || !node || (expr->n_operands && !list)) {
+            fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+            exit(1);
+        }
+        *copy = *expr;
+        copy->left_op = operands[0];
+        copy->right_op = operands[n - 1];
+        if (list) memcpy(list, operands, n * sizeof(*list));
+        copy->operands = list;
+        *node = *operand;
+        node->value.expr = share_expression(copy);
+        result = share_operand(node);
+    }
+    if (operands != small) FREE(operands);
+    return result;
+}
+
+static void inline_assign(struct Inline_Site *site, struct AST_Node_Assign *assign) {
+    if (!has_value(assign)) return;
+    struct AST_Node_Operand value = assign_value(assign);
+    struct AST_Node_Operand *result = inline_operand(site, &value, false);
+    assign->a_val = result->value;
+    assign->a_type = result->operand_type;
+}
+
+// A condition stays an expression node, only the operands in it change
+static struct AST_Node_Expression *inline_condition(struct Inline_Site *site, struct AST_Node_Expression *condition) {
+    if (condition == NULL) return NULL;
+    struct AST_Node_Operand operand = { .value.expr = condition, .val_type = condition->expr_type,
+                                        .operand_type = CONTENT_TYPE_EXPRESSION };
+    return inline_operand(site, &operand, false)->value.expr;
+}
+
+// A number printed as is could not be concatenated with the other parts, it is printed from a name
+static struct AST_Node_Operand *output_value(struct Inline_Site *site, struct AST_Node_Operand *value) {
+    if (!is_literal(value) || value->operand_type == CONTENT_TYPE_STRING) return value;
+    struct AST_Node_Operand *temp = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    char *name = NULL;
+    if (!temp || ASPRINTF(&name, INLINE_PREFIX "%lu", next_instance) < 0) {
+        fprintf(stderr, "Error: Failed to allocate memory for inlined call\n");
+        exit(1);
+    }
+    next_instance++;
+    temp->value.val = name;
+    temp->val_type = value->val_type;
+    temp->operand_type = CONTENT_TYPE_ID;
+    struct AST_Node_Statements *assign = make_assign(name, value);
+    if (assign == NULL) exit(1);
+    insert_before(site, assign);
+    return share_operand(temp);
+}
+
+// Inline the calls the statement of site makes once, in the order Python evaluates them
+static void inline_statement(struct Inline_Site *site, struct AST_Node_Instruction *instr) {
+    if (statement_increments(instr)) return;
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            inline_assign(site, instr->value.assign);
+            break;
+        case INIT_NODE:
+            // the values of the declarations after the first would move ahead of its assignment
+            if (instr->value.init) inline_assign(site, instr->value.init->assign);
+            break;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                struct AST_Node_Operand *value = inline_operand(site, out->output_op, false);
+                if (value != out->output_op) out->output_op = output_value(site, value);
+            }
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                struct AST_Node *node = instr->value.returnNode->value;
+                node->value = inline_operand(site, (struct AST_Node_Operand *)node->value, false);
+            }
+            break;
+        case FUNC_CALL_NODE:
+            if (instr->value.functionCall) instr->value.functionCall = inline_arguments(site, instr->value.functionCall);
+            break;
+        case IF_NODE:
+            if (instr->value.ifNode) instr->value.ifNode->condition = inline_condition(site, instr->value.ifNode->condition);
+            break;
+        case FOR_NODE:
+            if (instr->value.forNode) inline_assign(site, instr->value.forNode->init);
+            break;
+        default:
+            break;
+    }
+}
+
+static void inline_list(struct AST_Node_Statements **link) {
+    for (; *link != NULL; link = &(*link)->right) {
+        struct AST_Node_Instruction *instr = (*link)->left;
+        if (instr == NULL || instr->n_type == FUNC_DEF_NODE || instr->n_type == CLASS_NODE ||
+            instr->n_type == CLASS_CHILD_NODE) {
+            continue;
+        }
+        struct Inline_Site site = { .link = link };
+        inline_statement(&site, instr);
+        link = site.link;
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) inline_list(bodies[i]);
+    }
+}
+
+// Inline the calls in the body of function, then decide whether it can be inlined in turn
+static void inline_function(struct Inline_Function *function) {
+    struct AST_Node_FBody *body = function->def->f_body;
+    if (body != NULL) {
+        inline_list(&body->func_body);
+        // the return expression is evaluated after the last statement, if that is no return
+        struct AST_Node_Statements *last = last_statement(body->func_body);
+        if (body->return_op != NULL && !increments(body->return_op) &&
+            (last == NULL || last->left == NULL || last->left->n_type != RETURN_NODE)) {
+            struct Inline_Site site = { .link = last ? &last->right : &body->func_body };
+            body->return_op = inline_operand(&site, body->return_op, false);
+        }
+    }
+    analyze_function(function);
+}
+
+// Tarjan's walk of the call graph: a function is done after all the functions it reaches
+static void visit_function(size_t index) {
+    struct Inline_Function *function = &graph.functions[index];
+    function->index = function->low = graph.next_index++;
+    graph.stack[graph.n_stack++] = index;
+    function->on_stack = true;
+    for (size_t i = 0; i < function->n_callees; i++) {
+        struct Inline_Function *callee = &graph.functions[function->callees[i]];
+        if (callee->index < 0) {
+            visit_function(function->callees[i]);
+            if (callee->low < function->low) function->low = callee->low;
+        } else if (callee->on_stack && callee->index < function->low) {
+            function->low = callee->index;
+        }
+        if (callee == function) function->recursive = true;
+    }
+    if (function->low != function->index) return;
+
+    // function roots a strongly connected component, the functions above it on the stack
+    size_t first = graph.n_stack;
+    do {
+        first--;
+    } while (graph.stack[first] != index);
+    bool cycle = graph.n_stack - first > 1;
+    for (size_t i = first; i < graph.n_stack; i++) {
+        struct Inline_Function *member = &graph.functions[graph.stack[i]];
+        member->on_stack = false;
+        member->recursive = member->recursive || cycle;
+    }
+    for (size_t i = first; i < graph.n_stack; i++) inline_function(&graph.functions[graph.stack[i]]);
+    graph.n_stack = first;
+}
+
+static void free_graph(void) {
+    for (size_t i = 0; i < graph.n_functions; i++) {
+        FREE(graph.functions[i].callees);
+        FREE(graph.functions[i].names);
+        FREE(graph.functions[i].name_table);
+    }
+    FREE(graph.functions);
+    FREE(graph.table);
+    FREE(graph.stack);
+    memset(&graph, 0, sizeof(graph));
+}
+
+size_t pass_inline(struct AST_Node_Statements **root) {
+    inlined = 0;
+    for (struct AST_Node_Statements *list = *root; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL || instr->n_type != FUNC_DEF_NODE || instr->value.functionDef == NULL ||
+            instr->value.functionDef->func_name == NULL || instr->value.functionDef->is_class_method) {
+            continue;
+        }
+        if (!graph_add(instr->value.functionDef)) {
+            fprintf(stderr, "Error: Failed to allocate memory for call graph\n");
+            free_graph();
+            return 0;
+        }
+    }
+    graph.stack = graph.n_functions ? (size_t *)MALLOC(graph.n_functions * sizeof(size_t)) : NULL;
+    if (graph.n_functions && !graph.stack) {
+        fprintf(stderr, "Error: Failed to allocate memory for call graph\n");
+        free_graph();
+        return 0;
+    }
+    for (size_t i = 0; i < graph.n_functions; i++) {
+        struct Inline_Function *function = &graph.functions[i];
+        if (function->def->f_body == NULL) continue;
+        struct Inline_Scan scan = { .function = function, .graph = true };
+        scan_list(&scan, function->def->f_body->func_body, NULL);
+        scan_operand(&scan, function->def->f_body->return_op);
+    }
+    for (size_t i = 0; i < graph.n_functions; i++) {
+        if (graph.functions[i].index < 0) visit_function(i);
+    }
+    // statements outside functions, run when the module is loaded
+    inline_list(root);
+    free_graph();
+    return inlined;
+}
@@ -0,0 +1,578 @@
+#define _GNU_SOURCE
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "loops.h"
+#include <string.h>
+
+// Loop-invariant code motion.
+//
+// An expression in a for loop whose names the loop never assigns (its variable, its increment, the
+// statements of its body and the blocks nested there) has the same value in every iteration. It is
+// computed once into a temporary assigned just before the loop, and the loop reads the temporary;
+// the same expression found twice in one loop shares its temporary. Loops are handled outermost
+// first, so an expression moves out of as many loops as it is invariant in. The tree is walked
+// once, with the loops around the statement at hand on a stack.
+//
+// Only expressions over names and literals with + - * and the comparisons and logical operators
+// move: they have no effect and cannot raise in Python, so computing one the loop would not have
+// computed (in a branch not taken, or when the loop runs no iteration) changes nothing. Division
+// can raise on a zero divisor and calls may have effects, so they stay. The condition of a counted
+// loop is left alone, range() evaluates its bound once already. Temporaries are named __inv<n>.
+
+#define LICM_PREFIX "__inv"
+
+// The names the loops assign, indexed ahead of the pass
+static struct Loop_Assigns *assigned = NULL;
+
+// An invariant expression and the temporary holding it
+struct Licm_Temp {
+    struct AST_Node_Operand value;    /* a copy, the value of an assignment is taken from the stack */
+    struct AST_Node_Operand *temp;
+    unsigned int hash;                /* operand_hash of value */
+};
+
+// The loop invariant expressions are taken from
+struct Licm_Loop {
+    struct AST_Node_For *for_node;
+    struct Licm_Temp *temps;
+    size_t n_temps, temps_capacity;
+    size_t *slots;                    /* open addressing on the hash of a value: temps index + 1, 0 if free */
+    size_t n_slots;
+};
+
+// The loops around the statement being walked, outermost first, and the levels (see name_level)
+// the expressions of one statement move to
+static struct {
+    struct Licm_Loop *loops;
+    size_t depth, capacity;
+    size_t *levels;
+    size_t n_levels, levels_capacity;
+} nest;
+
+static unsigned long next_temp = 0;
+static size_t hoisted = 0;
+
+// The loop never assigns name, in its variable, its increment or its body
+static bool invariant_name(struct Licm_Loop *loop, const char *name) {
+    return !loop_assigns(assigned, loop->for_node, name);
+}
+
+// Operators that neither raise nor have an effect in Python
+static bool movable_op(OP_TYPE op) {
+    switch (op) {
+        case OP_ADD: case OP_SUB: case OP_MUL:
+        case OP_AND: case OP_OR:
+        case OP_LT: case OP_GT: case OP_LE: case OP_GE: case OP_EQ: case OP_NE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Temporary holding value, assigned before the loop
+static struct AST_Node_Operand *temp_for(struct Licm_Loop *loop, struct AST_Node_Operand *value) {
+    unsigned int hash = operand_hash(value);
+    size_t mask = loop->n_slots - 1;
+    for (size_t i = hash & mask; loop->n_slots > 0 && loop->slots[i] != 0; i = (i + 1) & mask) {
+        struct Licm_Temp *known = &loop->temps[loop->slots[i] - 1];
+        if (known->hash == hash && same_operand(&known->value, value)) return known->temp;
+    }
+    if (2 * (loop->n_temps + 1) > loop->n_slots) {
+        size_t n_slots = loop->n_slots ? loop->n_slots * 2 : 16;
+        size_t *slots = (size_t *)CALLOC(n_slots, sizeof(*slots));
+        if (!slots) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            return value;
+        }
+        for (size_t t = 0; t < loop->n_temps; t++) {
+            size_t k = loop->temps[t].hash & (n_slots - 1);
+            while (slots[k] != 0) k = (k + 1) & (n_slots - 1);
+            slots[k] = t + 1;
+        }
+        FREE(loop->slots);
+        loop->slots = slots;
+        loop->n_slots = n_slots;
+    }
+    if (loop->n_temps == loop->temps_capacity) {
+        size_t capacity = loop->temps_capacity ? loop->temps_capacity * 2 : 8;
+        struct Licm_Temp *temps = (struct Licm_Temp *)REALLOC(loop->temps, capacity * sizeof(*temps));
+        if (!temps) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            return value;
+        }
+        loop->temps = temps;
+        loop->temps_capacity = capacity;
+    }
+    struct AST_Node_Operand *temp = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+    char *name = NULL;
+    if (!temp || ASPRINTF(&name, LICM_PREFIX "%lu", next_temp) < 0) {
+        fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+        FREE(temp);
+        return value;
+    }
+    next_temp++;
+    temp->value.val = name;
+    temp->val_type = value->val_type;
+    temp->operand_type = CONTENT_TYPE_ID;
+    temp = share_operand(temp);
+    size_t k = hash & (loop->n_slots - 1);
+    while (loop->slots[k] != 0) k = (k + 1) & (loop->n_slots - 1);
+    loop->temps[loop->n_temps++] = (struct Licm_Temp){ *value, temp, hash };
+    loop->slots[k] = loop->n_temps;
+    return temp;
+}
+
+// operand with its invariant subexpressions read from temporaries, operand itself if none is.
+// *invariant is set when all of operand is invariant, it is then returned as it is for the
+// caller to move as a whole; *named when it reads a name.
+static struct AST_Node_Operand *hoist_operand(struct Licm_Loop *loop, struct AST_Node_Operand *operand,
+                                              bool *invariant, bool *named) {
+    *invariant = false;
+    *named = false;
+    if (operand == NULL) return NULL;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER:
+        case CONTENT_TYPE_FLOAT_NUMBER:
+        case CONTENT_TYPE_BOOL:
+        case CONTENT_TYPE_STRING:
+            *invariant = true;
+            return operand;
+        case CONTENT_TYPE_ID:
+            *invariant = invariant_name(loop, operand->value.val);
+            *named = true;
+            return operand;
+        case CONTENT_TYPE_EXPRESSION:
+            break;
+        case CONTENT_TYPE_FUNCTION: {
+            // the call stays, its arguments are operands of their own
+            struct AST_Node_FunctionCall *call = operand->value.funca;
+            if (call == NULL) return operand;
+            struct AST_Node_Params *params = NULL;
+            struct AST_Node_Params **link = &params;
+            bool changed = false;
+            for (struct AST_Node_Params *p = call->params; p != NULL; p = p->next_param) {
+                bool inv, nam;
+                struct AST_Node_Operand *argument = hoist_operand(loop, p->call_param, &inv, &nam);
+                if (inv && nam && argument && argument->operand_type == CONTENT_TYPE_EXPRESSION) {
+                    argument = temp_for(loop, argument);
+                }
+                struct AST_Node_Params *param = (struct AST_Node_Params *)MALLOC(sizeof(struct AST_Node_Params));
+                if (!param) {
+                    fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+                    return operand;
+                }
+                *param = *p;
+                param->call_param = argument;
+                changed = changed || argument != p->call_param;
+                *link = param;
+                link = &param->next_param;
+            }
+            *link = NULL;
+            if (!changed) {
+                while (params != NULL) {
+                    struct AST_Node_Params *next = params->next_param;
+                    FREE(params);
+                    params = next;
+                }
+                return operand;
+            }
+            struct AST_Node_FunctionCall *copy = (struct AST_Node_FunctionCall *)MALLOC(sizeof(struct AST_Node_FunctionCall));
+            struct AST_Node_Operand *result = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+            if (!copy || !result) {
+                fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+                FREE(copy);
+                FREE(result);
+                return operand;
+            }
+            *copy = *call;
+            copy->params = params;
+            *result = *operand;
+            result->value.funca = copy;
+            return result;
+        }
+        default:
+            return operand;
+    }
+
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr == NULL || !expr->left_op || !expr->right_op) return operand;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    bool small_invariant[8], small_named[8];
+    struct AST_Node_Operand **operands = small;
+    bool *invariants = small_invariant, *names = small_named;
+    if (n > 8) {
+        operands = (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+        invariants = (bool *)MALLOC(n * sizeof(bool));
+        names = (bool *)MALLOC(n * sizeof(bool));
+        if (!operands || !invariants || !names) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            FREE(operands);
+            FREE(invariants);
+            FREE(names);
+            return operand;
+        }
+    }
+    bool all_invariant = movable_op(expr->op);
+    bool any_named = false;
+    for (size_t i = 0; i < n; i++) {
+        operands[i] = hoist_operand(loop, nth_operand(expr, i), &invariants[i], &names[i]);
+        all_invariant = all_invariant && invariants[i];
+        any_named = any_named || names[i];
+    }
+
+    struct AST_Node_Operand *result = operand;
+    if (all_invariant) {
+        *invariant = true;
+        *named = any_named;
+    } else {
+        bool changed = false;
+        for (size_t i = 0; i < n; i++) {
+            if (invariants[i] && names[i] && operands[i]->operand_type == CONTENT_TYPE_EXPRESSION) {
+                operands[i] = temp_for(loop, operands[i]);
+            }
+            changed = changed || operands[i] != nth_operand(expr, i);
+        }
+        if (changed) {
+            struct AST_Node_Expression *copy = (struct AST_Node_Expression *)MALLOC(sizeof(struct AST_Node_Expression));
+            struct AST_Node_Operand **list = expr->n_operands
+                ? (struct AST_Node_Operand **)MALLOC(n * sizeof(*list)) : NULL;
+            struct AST_Node_Operand *node = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+            if (!copy || !node || (expr->n_operands && !list)) {
+                fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+                FREE(copy);
+                FREE(list);
+                FREE(node);
+            } else {
+                *copy = *expr;
+                copy->left_op = operands[0];
+                copy->right_op = operands[n - 1];
+                if (list) memcpy(list, operands, n * sizeof(*list));
+                copy->operands = list;
+                *node = *operand;
+                node->value.expr = share_expression(copy);
+                result = share_operand(node);
+            }
+        }
+    }
+    if (operands != small) {
+        FREE(operands);
+        FREE(invariants);
+        FREE(names);
+    }
+    return result;
+}
+
+// operand in a place any operand may stand: it is moved out as a whole if it is invariant
+static struct AST_Node_Operand *hoist_value(struct Licm_Loop *loop, struct AST_Node_Operand *operand) {
+    bool invariant, named;
+    struct AST_Node_Operand *result = hoist_operand(loop, operand, &invariant, &named);
+    if (invariant && named && result && result->operand_type == CONTENT_TYPE_EXPRESSION) return temp_for(loop, result);
+    return result;
+}
+
+// A condition stays an expression node, only the operands in it move
+static struct AST_Node_Expression *hoist_condition(struct Licm_Loop *loop, struct AST_Node_Expression *condition) {
+    if (condition == NULL || !condition->left_op || !condition->right_op) return condition;
+    struct AST_Node_Operand operand = { .value.expr = condition, .val_type = condition->expr_type,
+                                        .operand_type = CONTENT_TYPE_EXPRESSION };
+    bool invariant, named;
+    struct AST_Node_Operand *result = hoist_operand(loop, &operand, &invariant, &named);
+    if (!invariant) return result->value.expr;
+
+    // all of it is invariant: its operands are, one by one
+    size_t n = count_operands(condition);
+    bool changed = false;
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+        return condition;
+    }
+    for (size_t i = 0; i < n; i++) {
+        operands[i] = hoist_value(loop, nth_operand(condition, i));
+        changed = changed || operands[i] != nth_operand(condition, i);
+    }
+    struct AST_Node_Expression *copy = NULL;
+    if (changed) {
+        copy = (struct AST_Node_Expression *)MALLOC(sizeof(struct AST_Node_Expression));
+        struct AST_Node_Operand **list = condition->n_operands
+            ? (struct AST_Node_Operand **)MALLOC(n * sizeof(*list)) : NULL;
+        if (!copy || (condition->n_operands && !list)) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            FREE(copy);
+            FREE(list);
+            copy = NULL;
+        } else {
+            *copy = *condition;
+            copy->left_op = operands[0];
+            copy->right_op = operands[n - 1];
+            if (list) memcpy(list, operands, n * sizeof(*list));
+            copy->operands = list;
+            copy = share_expression(copy);
+        }
+    }
+    if (operands != small) FREE(operands);
+    return copy ? copy : condition;
+}
+
+// Assignment value moved out where it is invariant; the increment of a loop keeps an expression
+static void hoist_assign(struct Licm_Loop *loop, struct AST_Node_Assign *assign, bool keep_expression) {
+    if (assign == NULL || (assign->a_type == CONTENT_TYPE_ID && assign->a_val.val == NULL)) return;
+    struct AST_Node_Operand value = { .value = assign->a_val, .val_type = assign->val_type, .operand_type = assign->a_type };
+    struct AST_Node_Operand *result;
+    if (keep_expression && assign->a_type == CONTENT_TYPE_EXPRESSION) {
+        struct AST_Node_Expression *expr = hoist_condition(loop, assign->a_val.expr);
+        result = &value;
+        value.value.expr = expr;
+    } else {
+        result = hoist_value(loop, &value);
+    }
+    assign->a_val = result->value;
+    assign->a_type = result->operand_type;
+}
+
+// Expressions of the statement instr (not those of its body) moved out of loop
+static void hoist_statement(struct Licm_Loop *loop, struct AST_Node_Instruction *instr) {
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            hoist_assign(loop, instr->value.assign, false);
+            break;
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                hoist_assign(loop, init->assign, false);
+            }
+            break;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                out->output_op = hoist_value(loop, out->output_op);
+            }
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                struct AST_Node *node = instr->value.returnNode->value;
+                node->value = hoist_value(loop, (struct AST_Node_Operand *)node->value);
+            }
+            break;
+        case FUNC_CALL_NODE: {
+            struct AST_Node_Operand call = { .value.funca = instr->value.functionCall, .operand_type = CONTENT_TYPE_FUNCTION };
+            instr->value.functionCall = hoist_value(loop, &call)->value.funca;
+            break;
+        }
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL) break;
+            if_node->condition = hoist_condition(loop, if_node->condition);
+            if (if_node->else_if) if_node->else_if->condition = hoist_condition(loop, if_node->else_if->condition);
+            break;
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL) break;
+            hoist_assign(loop, for_node->init, false);
+            for_node->condition = hoist_condition(loop, for_node->condition);
+            hoist_assign(loop, for_node->increment, true);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// The level of a name is the number of loops around the statement that assign it: an expression
+// moves out of the loops from the largest level of its names inwards. Loops assigning a name
+// enclose one another, they are the outermost ones and a binary search finds them.
+static size_t name_level(const char *name) {
+    size_t low = 0, high = nest.depth;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (invariant_name(&nest.loops[middle], name)) high = middle;
+        else low = middle + 1;
+    }
+    return low;
+}
+
+static void add_level(size_t level) {
+    if (level >= nest.depth) return;
+    if (nest.n_levels == nest.levels_capacity) {
+        size_t capacity = nest.levels_capacity ? nest.levels_capacity * 2 : 16;
+        size_t *levels = (size_t *)REALLOC(nest.levels, capacity * sizeof(*levels));
+        if (!levels) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            return;
+        }
+        nest.levels = levels;
+        nest.levels_capacity = capacity;
+    }
+    nest.levels[nest.n_levels++] = level;
+}
+
+static void operand_levels(struct AST_Node_Operand *operand) {
+    if (operand == NULL) return;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID:
+            add_level(name_level(operand->value.val));
+            break;
+        case CONTENT_TYPE_EXPRESSION:
+            if (operand->value.expr == NULL) break;
+            for (size_t i = 0; i < count_operands(operand->value.expr); i++) operand_levels(nth_operand(operand->value.expr, i));
+            break;
+        case CONTENT_TYPE_FUNCTION:
+            if (operand->value.funca == NULL) break;
+            for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) operand_levels(p->call_param);
+            break;
+        default:
+            break;
+    }
+}
+
+static void assign_levels(struct AST_Node_Assign *assign) {
+    if (assign == NULL) return;
+    struct AST_Node_Operand value = { .value = assign->a_val, .operand_type = assign->a_type };
+    operand_levels(&value);
+}
+
+static void condition_levels(struct AST_Node_Expression *condition) {
+    struct AST_Node_Operand operand = { .value.expr = condition, .operand_type = CONTENT_TYPE_EXPRESSION };
+    operand_levels(&operand);
+}
+
+static int compare_levels(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Move the expressions of instr out of the loops around it, outermost first. Moving out of a loop
+// changes nothing at a level none of the names has: what is invariant there already was at the
+// level below and has moved, so only the levels of the names are visited.
+static void hoist_nested(struct AST_Node_Instruction *instr) {
+    nest.n_levels = 0;
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            assign_levels(instr->value.assign);
+            break;
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) assign_levels(init->assign);
+            break;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) operand_levels(out->output_op);
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                operand_levels((struct AST_Node_Operand *)instr->value.returnNode->value->value);
+            }
+            break;
+        case FUNC_CALL_NODE: {
+            struct AST_Node_Operand call = { .value.funca = instr->value.functionCall, .operand_type = CONTENT_TYPE_FUNCTION };
+            operand_levels(&call);
+            break;
+        }
+        case IF_NODE:
+            if (instr->value.ifNode == NULL) break;
+            condition_levels(instr->value.ifNode->condition);
+            if (instr->value.ifNode->else_if) condition_levels(instr->value.ifNode->else_if->condition);
+            break;
+        case FOR_NODE:
+            if (instr->value.forNode == NULL) break;
+            assign_levels(instr->value.forNode->init);
+            condition_levels(instr->value.forNode->condition);
+            assign_levels(instr->value.forNode->increment);
+            break;
+        default:
+            break;
+    }
+    if (nest.n_levels == 0) return;
+    qsort(nest.levels, nest.n_levels, sizeof(*nest.levels), compare_levels);
+    for (size_t i = 0; i < nest.n_levels; i++) {
+        if (i > 0 && nest.levels[i] == nest.levels[i - 1]) continue;
+        hoist_statement(&nest.loops[nest.levels[i]], instr);
+    }
+}
+
+static void licm_list(struct AST_Node_Statements *list);
+
+// Move the invariants of the for loop at statement to assignments before it, once its body has
+// been walked with the loop around it; the loop ends up in the last statement node of those
+static struct AST_Node_Statements *hoist_loop(struct AST_Node_Statements *statement) {
+    struct AST_Node_Instruction *instr = statement->left;
+    struct AST_Node_For *for_node = instr->value.forNode;
+    struct Counted_Loop counted;
+    if (for_node == NULL) return statement;
+    if (nest.depth == nest.capacity) {
+        size_t capacity = nest.capacity ? nest.capacity * 2 : 16;
+        struct Licm_Loop *loops = (struct Licm_Loop *)REALLOC(nest.loops, capacity * sizeof(*loops));
+        if (!loops) {
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            return statement;
+        }
+        nest.loops = loops;
+        nest.capacity = capacity;
+    }
+    size_t level = nest.depth++;
+    nest.loops[level] = (struct Licm_Loop){ .for_node = for_node };
+
+    if (!counted_loop_in(assigned, for_node, &counted)) for_node->condition = hoist_condition(&nest.loops[level], for_node->condition);
+    hoist_assign(&nest.loops[level], for_node->increment, true);
+    licm_list(for_node->for_body);
+
+    struct Licm_Loop loop = nest.loops[--nest.depth];
+    struct AST_Node_Statements *last = statement;
+    for (size_t i = 0; i < loop.n_temps; i++) {
+        struct AST_Node_Operand *value = &loop.temps[i].value;
+        struct AST_Node_Assign *assign = (struct AST_Node_Assign *)MALLOC(sizeof(struct AST_Node_Assign));
+        struct AST_Node_Instruction *node = (struct AST_Node_Instruction *)MALLOC(sizeof(struct AST_Node_Instruction));
+        struct AST_Node_Statements *next = (struct AST_Node_Statements *)MALLOC(sizeof(struct AST_Node_Statements));
+        if (!assign || !node || !next) {
+            // the loop reads the temporary, it cannot be left without its assignment
+            fprintf(stderr, "Error: Failed to allocate memory for loop invariant\n");
+            exit(1);
+        }
+        assign->var = loop.temps[i].temp->value.val;
+        assign->val_type = value->val_type;
+        assign->a_val = value->value;
+        assign->a_type = value->operand_type;
+        node->n_type = ASSIGN_NODE;
+        node->value.assign = assign;
+        // the assignment takes the loop's place, the loop moves to a new node after it
+        *next = *last;
+        last->left = node;
+        last->right = next;
+        last = next;
+        hoisted++;
+    }
+    FREE(loop.temps);
+    FREE(loop.slots);
+    return last;
+}
+
+static void licm_list(struct AST_Node_Statements *list) {
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        if (nest.depth == 0 && (instr->n_type == CLASS_NODE || instr->n_type == CLASS_CHILD_NODE)) continue;
+        if (nest.depth > 0) hoist_nested(instr);
+        if (instr->n_type == FOR_NODE && instr->value.forNode) {
+            list = hoist_loop(list);
+            continue;
+        }
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) licm_list(*bodies[i]);
+    }
+}
+
+size_t pass_licm(struct AST_Node_Statements **root) {
+    hoisted = 0;
+    assigned = index_loop_assigns(*root);
+    if (assigned == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for loop names\n");
+        return 0;
+    }
+    licm_list(*root);
+    delete_loop_assigns(assigned);
+    assigned = NULL;
+    FREE(nest.loops);
+    FREE(nest.levels);
+    memset(&nest, 0, sizeof(nest));
+    return hoisted;
+}
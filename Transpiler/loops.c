@@ -0,0 +1,455 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "loops.h"
+#include "passes.h"
+#include "symtab.h"
+#include <stdint.h>
+#include <string.h>
+
+// Counted loop recognition.
+//
+// for (i = a; i < b; i = i + s) runs i over range(a, b, s) when s is a constant of the sign the
+// comparison needs, b is an int that cannot change while the loop runs (a literal, or names and
+// arithmetic the body never assigns) and the body never assigns i. C++ evaluates b before every
+// iteration and range() once, which is the same thing under those conditions. <= and >= move
+// the stop by one, and != is taken when start and stop are literals the step reaches exactly.
+// The value i is left with after the loop does not matter: the parser ends the scope of the
+// loop variable with the loop.
+
+#define MAX_BOUND_NAMES 8
+
+// Calls visit with every name the operand increments or decrements (x++ and x-- inside an expression)
+static void operand_increments(struct AST_Node_Operand *operand, ASSIGN_VISITOR visit, void *context) {
+    if (operand == NULL) return;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) {
+        if (operand->value.funca == NULL) return;
+        for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+            operand_increments(p->call_param, visit, context);
+        }
+        return;
+    }
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION || operand->value.expr == NULL) return;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if ((expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) && expr->left_op &&
+        expr->left_op->operand_type == CONTENT_TYPE_ID && expr->left_op->value.val != NULL) {
+        visit(context, expr->left_op->value.val);
+    }
+    if (expr->n_operands == 0) {
+        operand_increments(expr->left_op, visit, context);
+        operand_increments(expr->right_op, visit, context);
+        return;
+    }
+    for (size_t i = 0; i < expr->n_operands; i++) operand_increments(expr->operands[i], visit, context);
+}
+
+static void expression_increments(struct AST_Node_Expression *expr, ASSIGN_VISITOR visit, void *context) {
+    struct AST_Node_Operand operand = { .value.expr = expr, .operand_type = CONTENT_TYPE_EXPRESSION };
+    if (expr != NULL) operand_increments(&operand, visit, context);
+}
+
+static void assign_names(struct AST_Node_Assign *assign, ASSIGN_VISITOR visit, void *context) {
+    if (assign == NULL) return;
+    if (assign->var != NULL) visit(context, assign->var);
+    struct AST_Node_Operand value = { .value = assign->a_val, .operand_type = assign->a_type };
+    if (assign->a_type != CONTENT_TYPE_ID) operand_increments(&value, visit, context);
+}
+
+// Calls visit with every name instr assigns, not counting the blocks nested in it
+void instruction_assigns(struct AST_Node_Instruction *instr, ASSIGN_VISITOR visit, void *context) {
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            assign_names(instr->value.assign, visit, context);
+            break;
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                assign_names(init->assign, visit, context);
+            }
+            break;
+        case INPUT_NODE:
+            for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL; in = in->next_input) {
+                if (in->input_op && in->input_op->operand_type == CONTENT_TYPE_ID && in->input_op->value.val != NULL) {
+                    visit(context, in->input_op->value.val);
+                }
+            }
+            break;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                operand_increments(out->output_op, visit, context);
+            }
+            break;
+        case RETURN_NODE:
+            if (instr->value.returnNode && instr->value.returnNode->value) {
+                operand_increments((struct AST_Node_Operand *)instr->value.returnNode->value->value, visit, context);
+            }
+            break;
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL) break;
+            assign_names(for_node->init, visit, context);
+            assign_names(for_node->increment, visit, context);
+            expression_increments(for_node->condition, visit, context);
+            break;
+        }
+        case REDUCE_NODE: {
+            // elements and conditions of a reduction are pure, it assigns its accumulator only
+            struct AST_Node_Reduce *reduce = instr->value.reduceNode;
+            if (reduce == NULL) break;
+            if (reduce->var != NULL) visit(context, reduce->var);
+            if (reduce->loop && reduce->loop->init && reduce->loop->init->var != NULL) visit(context, reduce->loop->init->var);
+            break;
+        }
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL) break;
+            expression_increments(if_node->condition, visit, context);
+            if (if_node->else_if) expression_increments(if_node->else_if->condition, visit, context);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+struct Assign_Search {
+    const char *name;
+    bool found;
+};
+
+static void match_name(void *context, const char *name) {
+    struct Assign_Search *search = (struct Assign_Search *)context;
+    if (same_name(name, search->name)) search->found = true;
+}
+
+static bool operand_assigns(struct AST_Node_Operand *operand, const char *name) {
+    struct Assign_Search search = { name, false };
+    operand_increments(operand, match_name, &search);
+    return search.found;
+}
+
+static void search_statements(struct AST_Node_Statements *list, struct Assign_Search *search) {
+    for (; list != NULL && !search->found; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        instruction_assigns(instr, match_name, search);
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) search_statements(*bodies[i], search);
+    }
+}
+
+// Some statement in list, or in a block nested in it, assigns name
+bool statements_assign(struct AST_Node_Statements *list, const char *name) {
+    struct Assign_Search search = { name, false };
+    if (name != NULL) search_statements(list, &search);
+    return search.found;
+}
+
+/****************** Names assigned by loops *****************/
+
+// One walk numbers the statements of a tree and records, for every name, the numbers of those
+// assigning it; the statements of a for loop, its own first, have consecutive numbers. A loop
+// assigns a name when one of these falls in its span, so the walk serves every loop of the tree
+// however deeply they nest. The index describes the tree as it was walked.
+
+// The statements assigning a name, by number
+struct Loop_Name {
+    const char *name;
+    unsigned int hash;
+    unsigned long *stamps;                     /* increasing */
+    size_t n_stamps, stamps_capacity;
+};
+
+// The statement numbers a for loop covers: its own, then those of its body
+struct Loop_Span {
+    struct AST_Node_For *loop;
+    unsigned long first, end;
+};
+
+struct Loop_Assigns {
+    struct Loop_Name *names;                   /* open addressing on the name */
+    size_t n_names, name_slots;
+    struct Loop_Span *spans;                   /* open addressing on the loop */
+    size_t n_spans, span_slots;
+    unsigned long stamp;
+    bool failed;
+};
+
+// Visitor context of the walk: the index and the number of the statement at hand
+struct Loop_Stamp {
+    struct Loop_Assigns *index;
+    unsigned long stamp;
+};
+
+static struct Loop_Name *find_loop_name(const struct Loop_Assigns *index, const char *name, unsigned int hash) {
+    size_t mask = index->name_slots - 1;
+    for (size_t i = hash & mask; index->names[i].name != NULL; i = (i + 1) & mask) {
+        if (index->names[i].hash == hash && strcmp(index->names[i].name, name) == 0) return &index->names[i];
+    }
+    return NULL;
+}
+
+static bool grow_loop_names(struct Loop_Assigns *index) {
+    size_t slots = index->name_slots ? index->name_slots * 2 : 64;
+    struct Loop_Name *names = (struct Loop_Name *)CALLOC(slots, sizeof(*names));
+    if (!names) return false;
+    for (size_t i = 0; i < index->name_slots; i++) {
+        if (index->names[i].name == NULL) continue;
+        size_t k = index->names[i].hash & (slots - 1);
+        while (names[k].name != NULL) k = (k + 1) & (slots - 1);
+        names[k] = index->names[i];
+    }
+    FREE(index->names);
+    index->names = names;
+    index->name_slots = slots;
+    return true;
+}
+
+static void record_name(void *context, const char *name) {
+    struct Loop_Stamp *at = (struct Loop_Stamp *)context;
+    struct Loop_Assigns *index = at->index;
+    if (index->failed) return;
+    if (2 * (index->n_names + 1) > index->name_slots && !grow_loop_names(index)) {
+        index->failed = true;
+        return;
+    }
+    unsigned int hash = hash_name(name);
+    struct Loop_Name *entry = find_loop_name(index, name, hash);
+    if (entry == NULL) {
+        size_t mask = index->name_slots - 1;
+        size_t i = hash & mask;
+        while (index->names[i].name != NULL) i = (i + 1) & mask;
+        entry = &index->names[i];
+        *entry = (struct Loop_Name){ .name = name, .hash = hash };
+        index->n_names++;
+    }
+    if (entry->n_stamps > 0 && entry->stamps[entry->n_stamps - 1] == at->stamp) return;
+    if (entry->n_stamps == entry->stamps_capacity) {
+        size_t capacity = entry->stamps_capacity ? entry->stamps_capacity * 2 : 4;
+        unsigned long *stamps = (unsigned long *)REALLOC(entry->stamps, capacity * sizeof(*stamps));
+        if (!stamps) {
+            index->failed = true;
+            return;
+        }
+        entry->stamps = stamps;
+        entry->stamps_capacity = capacity;
+    }
+    entry->stamps[entry->n_stamps++] = at->stamp;
+}
+
+static size_t span_slot(struct AST_Node_For *loop) {
+    return (size_t)(((uintptr_t)loop >> 4) * 2654435761u);
+}
+
+static const struct Loop_Span *find_span(const struct Loop_Assigns *index, struct AST_Node_For *loop) {
+    if (index == NULL || index->span_slots == 0) return NULL;
+    size_t mask = index->span_slots - 1;
+    for (size_t i = span_slot(loop) & mask; index->spans[i].loop != NULL; i = (i + 1) & mask) {
+        if (index->spans[i].loop == loop) return &index->spans[i];
+    }
+    return NULL;
+}
+
+static void add_span(struct Loop_Assigns *index, struct AST_Node_For *loop, unsigned long first, unsigned long end) {
+    if (2 * (index->n_spans + 1) > index->span_slots) {
+        size_t slots = index->span_slots ? index->span_slots * 2 : 64;
+        struct Loop_Span *spans = (struct Loop_Span *)CALLOC(slots, sizeof(*spans));
+        if (!spans) {
+            index->failed = true;
+            return;
+        }
+        for (size_t i = 0; i < index->span_slots; i++) {
+            if (index->spans[i].loop == NULL) continue;
+            size_t k = span_slot(index->spans[i].loop) & (slots - 1);
+            while (spans[k].loop != NULL) k = (k + 1) & (slots - 1);
+            spans[k] = index->spans[i];
+        }
+        FREE(index->spans);
+        index->spans = spans;
+        index->span_slots = slots;
+    }
+    size_t mask = index->span_slots - 1;
+    size_t i = span_slot(loop) & mask;
+    while (index->spans[i].loop != NULL) i = (i + 1) & mask;
+    index->spans[i] = (struct Loop_Span){ loop, first, end };
+    index->n_spans++;
+}
+
+static void number_list(struct Loop_Assigns *index, struct AST_Node_Statements *list) {
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        struct Loop_Stamp at = { index, index->stamp++ };
+        instruction_assigns(instr, record_name, &at);
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) number_list(index, *bodies[i]);
+        if (instr->n_type == FOR_NODE && instr->value.forNode) add_span(index, instr->value.forNode, at.stamp, index->stamp);
+    }
+}
+
+// Index of the names the for loops of root assign, NULL if memory runs out
+struct Loop_Assigns *index_loop_assigns(struct AST_Node_Statements *root) {
+    struct Loop_Assigns *index = (struct Loop_Assigns *)CALLOC(1, sizeof(struct Loop_Assigns));
+    if (index == NULL) return NULL;
+    number_list(index, root);
+    if (index->failed) {
+        delete_loop_assigns(index);
+        return NULL;
+    }
+    return index;
+}
+
+void delete_loop_assigns(struct Loop_Assigns *index) {
+    if (index == NULL) return;
+    for (size_t i = 0; i < index->name_slots; i++) FREE(index->names[i].stamps);
+    FREE(index->names);
+    FREE(index->spans);
+    FREE(index);
+}
+
+// A statement numbered in [first, end) assigns name
+static bool stamped_between(const struct Loop_Assigns *index, const char *name, unsigned long first, unsigned long end) {
+    if (index->name_slots == 0) return false;
+    struct Loop_Name *entry = find_loop_name(index, name, hash_name(name));
+    if (entry == NULL) return false;
+    size_t low = 0, high = entry->n_stamps;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (entry->stamps[middle] < first) low = middle + 1;
+        else high = middle;
+    }
+    return low < entry->n_stamps && entry->stamps[low] < end;
+}
+
+// The loop (its variable, its increment or its body) assigns name. Loops added to the tree after
+// the walk, and names it does not know, are searched for in the tree itself.
+bool loop_assigns(const struct Loop_Assigns *index, struct AST_Node_For *loop, const char *name) {
+    if (name == NULL) return true;
+    const struct Loop_Span *span = find_span(index, loop);
+    if (span == NULL) {
+        struct AST_Node_Instruction instr = { .n_type = FOR_NODE, .value.forNode = loop };
+        struct Assign_Search search = { name, false };
+        instruction_assigns(&instr, match_name, &search);
+        return search.found || statements_assign(loop->for_body, name);
+    }
+    return stamped_between(index, name, span->first, span->end);
+}
+
+// The body of the loop assigns name
+static bool body_assigns(const struct Loop_Assigns *index, struct AST_Node_For *loop, const char *name) {
+    const struct Loop_Span *span = find_span(index, loop);
+    if (span == NULL) return statements_assign(loop->for_body, name);
+    return name == NULL || stamped_between(index, name, span->first + 1, span->end);
+}
+
+// The bound is int arithmetic over literals and names, at most max of them, none of them var.
+// Division is left out: / makes a float in Python, which range() rejects
+static bool collect_bound_names(struct AST_Node_Operand *operand, const char *var, const char **names,
+                                size_t *n, size_t max) {
+    if (operand == NULL) return false;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER:
+            return true;
+        case CONTENT_TYPE_ID:
+            if (operand->val_type != DATA_TYPE_INT || operand->value.val == NULL ||
+                same_name(operand->value.val, var) || *n == max) {
+                return false;
+            }
+            names[(*n)++] = operand->value.val;
+            return true;
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL || expr->expr_type != DATA_TYPE_INT) return false;
+            if (expr->op != OP_ADD && expr->op != OP_SUB && expr->op != OP_MUL) return false;
+            if (expr->n_operands == 0) {
+                return collect_bound_names(expr->left_op, var, names, n, max) &&
+                       collect_bound_names(expr->right_op, var, names, n, max);
+            }
+            for (size_t i = 0; i < expr->n_operands; i++) {
+                if (!collect_bound_names(expr->operands[i], var, names, n, max)) return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Step of an increment var = var + c, var = c + var or var = var - c, 0 if it is none of those
+static long increment_step(struct AST_Node_Assign *increment, const char *var) {
+    if (increment == NULL || !same_name(increment->var, var) || increment->a_type != CONTENT_TYPE_EXPRESSION) return 0;
+    struct AST_Node_Expression *expr = increment->a_val.expr;
+    if (expr == NULL || (expr->op != OP_ADD && expr->op != OP_SUB)) return 0;
+    if (expr->n_operands > 2) return 0;
+    struct AST_Node_Operand *left = nth_operand(expr, 0);
+    struct AST_Node_Operand *right = nth_operand(expr, 1);
+    if (left == NULL || right == NULL) return 0;
+    if (expr->op == OP_ADD && left->operand_type == CONTENT_TYPE_INT_NUMBER) {
+        struct AST_Node_Operand *swap = left;
+        left = right;
+        right = swap;
+    }
+    if (left->operand_type != CONTENT_TYPE_ID || !same_name(left->value.val, var) ||
+        right->operand_type != CONTENT_TYPE_INT_NUMBER) {
+        return 0;
+    }
+    return expr->op == OP_ADD ? right->value.ival : -right->value.ival;
+}
+
+// Fill loop if the for loop is counted, false if it must run as a while loop. The body is searched
+// for assignments through index when there is one.
+bool counted_loop_in(const struct Loop_Assigns *index, struct AST_Node_For *for_node, struct Counted_Loop *loop) {
+    if (for_node == NULL || for_node->init == NULL || for_node->condition == NULL) return false;
+    struct AST_Node_Assign *init = for_node->init;
+    struct AST_Node_Expression *condition = for_node->condition;
+    if (init->var == NULL || init->val_type != DATA_TYPE_INT) return false;
+    if (condition->n_operands != 0 || condition->left_op == NULL || condition->right_op == NULL) return false;
+
+    // the variable on the left, i < n; n > i is read the other way round
+    OP_TYPE op = condition->op;
+    struct AST_Node_Operand *bound = condition->right_op;
+    struct AST_Node_Operand *other = condition->left_op;
+    if (bound->operand_type == CONTENT_TYPE_ID && same_name(bound->value.val, init->var)) {
+        bound = condition->left_op;
+        other = condition->right_op;
+        op = op == OP_LT ? OP_GT : op == OP_GT ? OP_LT : op == OP_LE ? OP_GE : op == OP_GE ? OP_LE : op;
+    }
+    if (other->operand_type != CONTENT_TYPE_ID || !same_name(other->value.val, init->var)) return false;
+
+    long step = increment_step(for_node->increment, init->var);
+    long adjust = 0;
+    switch (op) {
+        case OP_LT: if (step <= 0) return false; break;
+        case OP_LE: if (step <= 0) return false; adjust = 1; break;
+        case OP_GT: if (step >= 0) return false; break;
+        case OP_GE: if (step >= 0) return false; adjust = -1; break;
+        case OP_NE:
+            if ((step != 1 && step != -1) || init->a_type != CONTENT_TYPE_INT_NUMBER ||
+                bound->operand_type != CONTENT_TYPE_INT_NUMBER ||
+                (bound->value.ival - init->a_val.ival) * step < 0) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    const char *names[MAX_BOUND_NAMES];
+    size_t n_names = 0;
+    if (!collect_bound_names(bound, init->var, names, &n_names, MAX_BOUND_NAMES)) return false;
+    struct AST_Node_Operand start = assign_value(init);
+    if (body_assigns(index, for_node, init->var)) return false;
+    for (size_t i = 0; i < n_names; i++) {
+        if (body_assigns(index, for_node, names[i]) || operand_assigns(&start, names[i])) return false;
+    }
+
+    loop->var = init->var;
+    loop->start = start;
+    loop->bound = bound;
+    loop->adjust = adjust;
+    loop->step = step;
+    return true;
+}
+
+bool counted_loop(struct AST_Node_For *for_node, struct Counted_Loop *loop) {
+    return counted_loop_in(NULL, for_node, loop);
+}
@@ -0,0 +1,33 @@
+#ifndef LOOPS_H
+#define LOOPS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ast.h"
+
+// A for loop whose int variable runs over an arithmetic sequence, as range(start, stop, step) does
+struct Counted_Loop {
+    const char *var;              /* loop variable */
+    struct AST_Node_Operand start;
+    struct AST_Node_Operand *bound; /* what the condition compares the variable with */
+    long adjust;                  /* added to bound for the stop of range(): 1 for <=, -1 for >= */
+    long step;                    /* never 0 */
+};
+
+// Called with every name a statement assigns
+typedef void (*ASSIGN_VISITOR)(void *context, const char *name);
+
+// The names the for loops of a tree assign, indexed in one walk of it
+struct Loop_Assigns;
+
+// Function declarations
+bool counted_loop(struct AST_Node_For *for_node, struct Counted_Loop *loop);
+bool counted_loop_in(const struct Loop_Assigns *index, struct AST_Node_For *for_node, struct Counted_Loop *loop);
+struct Loop_Assigns *index_loop_assigns(struct AST_Node_Statements *root);
+bool loop_assigns(const struct Loop_Assigns *index, struct AST_Node_For *loop, const char *name);
+void delete_loop_assigns(struct Loop_Assigns *index);
+bool statements_assign(struct AST_Node_Statements *list, const char *name);
+void instruction_assigns(struct AST_Node_Instruction *instr, ASSIGN_VISITOR visit, void *context);
+
+#endif // LOOPS_H
@@ -0,0 +1,131 @@
+#define ALLOC_SUBSYSTEM ALLOC_SYMTAB
+#include "members.h"
+#include "symtab.h"
+
+#define MEMBER_INDEX_INITIAL_SLOTS 16
+
+// Find the slot holding name, or the empty slot where it would go
+static size_t probe_member(struct Class_Member *slots, size_t n_slots, const char *name, unsigned int hash) {
+    size_t mask = n_slots - 1;
+    size_t i = hash & mask;
+    while (slots[i].name != NULL) {
+        if (slots[i].hash == hash && strcmp(slots[i].name, name) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Double the slot array and reinsert every member
+static bool grow_members(struct Member_Index *index) {
+    size_t n_slots = index->n_slots * 2;
+    struct Class_Member *slots = (struct Class_Member *)CALLOC(n_slots, sizeof(struct Class_Member));
+    if (!slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for class member index\n");
+        return false;
+    }
+    for (size_t i = 0; i < index->n_slots; i++) {
+        if (index->slots[i].name == NULL) continue;
+        slots[probe_member(slots, n_slots, index->slots[i].name, index->slots[i].hash)] = index->slots[i];
+    }
+    FREE(index->slots);
+    index->slots = slots;
+    index->n_slots = n_slots;
+    return true;
+}
+
+// Insert a member; an existing entry with the same name is kept unless it was inherited
+static void add_member(struct Member_Index *index, struct Class_Member *member) {
+    if ((index->n_members + 1) * 4 > index->n_slots * 3 && !grow_members(index)) return;
+
+    size_t i = probe_member(index->slots, index->n_slots, member->name, member->hash);
+    if (index->slots[i].name == NULL) {
+        index->n_members++;
+    } else if (!index->slots[i].is_inherited) {
+        return;
+    }
+    index->slots[i] = *member;
+}
+
+// Create an empty member index
+struct Member_Index *new_member_index(void) {
+    struct Member_Index *index = (struct Member_Index *)MALLOC(sizeof(struct Member_Index));
+    if (!index) {
+        fprintf(stderr, "Error: Failed to allocate memory for class member index\n");
+        return NULL;
+    }
+    index->slots = (struct Class_Member *)CALLOC(MEMBER_INDEX_INITIAL_SLOTS, sizeof(struct Class_Member));
+    if (!index->slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for class member index\n");
+        FREE(index);
+        return NULL;
+    }
+    index->n_slots = MEMBER_INDEX_INITIAL_SLOTS;
+    index->n_members = 0;
+    return index;
+}
+
+// Delete a member index (member names belong to the AST)
+void delete_member_index(struct Member_Index **pindex) {
+    if (!pindex || !*pindex) return;
+    FREE((*pindex)->slots);
+    FREE(*pindex);
+    *pindex = NULL;
+}
+
+// Index every field and method declared in one public or private section
+void member_index_add_section(struct Member_Index *index, struct AST_Node_Statements *section, bool is_public) {
+    if (!index) return;
+
+    for (struct AST_Node_Statements *current = section; current != NULL; current = current->right) {
+        struct AST_Node_Instruction *instr = current->left;
+        if (instr == NULL) continue;
+
+        struct Class_Member member = { NULL, 0, false, is_public, false, instr };
+        switch (instr->n_type) {
+            case INIT_NODE:
+                for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                    if (init->assign == NULL || init->assign->var == NULL) continue;
+                    member.name = init->assign->var;
+                    member.hash = hash_name(member.name);
+                    add_member(index, &member);
+                }
+                break;
+            case ASSIGN_NODE:
+                if (instr->value.assign == NULL || instr->value.assign->var == NULL) break;
+                member.name = instr->value.assign->var;
+                member.hash = hash_name(member.name);
+                add_member(index, &member);
+                break;
+            case FUNC_DEF_NODE:
+                if (instr->value.functionDef == NULL || instr->value.functionDef->func_name == NULL) break;
+                member.name = instr->value.functionDef->func_name;
+                member.hash = hash_name(member.name);
+                member.is_method = true;
+                add_member(index, &member);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Copy the members of a parent class that the child does not redeclare
+void member_index_inherit(struct Member_Index *index, struct Member_Index *parent) {
+    if (!index || !parent) return;
+
+    for (size_t i = 0; i < parent->n_slots; i++) {
+        if (parent->slots[i].name == NULL) continue;
+        struct Class_Member member = parent->slots[i];
+        member.is_inherited = true;
+        size_t j = probe_member(index->slots, index->n_slots, member.name, member.hash);
+        if (index->slots[j].name == NULL) add_member(index, &member);
+    }
+}
+
+// Find a member by name, NULL if the class has no such member
+struct Class_Member *find_member(struct Member_Index *index, char *name) {
+    if (!index || !name) return NULL;
+
+    size_t i = probe_member(index->slots, index->n_slots, name, hash_name(name));
+    return index->slots[i].name != NULL ? &index->slots[i] : NULL;
+}
@@ -0,0 +1,34 @@
+#ifndef MEMBERS_H
+#define MEMBERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "ast.h"
+
+// One field or method reachable through a class
+struct Class_Member {
+    char *name;                   /* member name (not owned) */
+    unsigned int hash;            /* hash of name */
+    bool is_method;               /* method or field? */
+    bool is_public;               /* declared in a public section? */
+    bool is_inherited;            /* comes from a parent class? */
+    struct AST_Node_Instruction *decl; /* declaring statement */
+};
+
+// Open-addressing index of the members of one class
+struct Member_Index {
+    struct Class_Member *slots;   /* name == NULL marks an empty slot */
+    size_t n_slots;               /* always a power of two */
+    size_t n_members;
+};
+
+// Function declarations
+struct Member_Index *new_member_index(void);
+void delete_member_index(struct Member_Index **pindex);
+void member_index_add_section(struct Member_Index *index, struct AST_Node_Statements *section, bool is_public);
+void member_index_inherit(struct Member_Index *index, struct Member_Index *parent);
+struct Class_Member *find_member(struct Member_Index *index, char *name);
+
+#endif // MEMBERS_H
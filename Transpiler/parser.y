@@ -1,1592 +1,1838 @@
-%{
-/****************** Prologue *****************/ 
-	#include <math.h>
-	#include <stdio.h>
-	#include <ctype.h>
-    #include <string.h>
-	#include "symtab.h"
-    #include "ast.h" 
-    #include "translation.h"
-    #include "utils.h"
-    #include <stdbool.h>
-
-    int yylex (void);
-    int yyerror(char *s);
-    int n_error = 0;
-    extern int yylineno;
-    extern FILE *yyin;
-    // Pointer to file used for translation
-    FILE *fptr;
-
-/****************** Initialization of structs, counters and variables*****************/ 
-    struct AST_Node_Statements  *root;
-    struct SymTab *local_table  = NULL; 
-    struct AST_Node_Class       *class_array[100]       = { NULL };
-    struct AST_Node_Object      *object_array[100]      = { NULL };
-    struct AST_Node_FunctionDef *function_array[100]    = { NULL };
-    int class_counter = 0;
-    int object_counter = 0;
-    int function_counter = 0;
-    bool found = false;
-    bool in_class = false;
-    // This is a helper function to distinguish class methods from regular functions
-    bool is_inside_class = false;
-
-    // Add cleanup function
-    void cleanup_arrays() {
-        for (int i = 0; i < class_counter; i++) {
-            if (class_array[i] != NULL) {
-                free(class_array[i]);
-                class_array[i] = NULL;
-            }
-        }
-        for (int i = 0; i < object_counter; i++) {
-            if (object_array[i] != NULL) {
-                free(object_array[i]);
-                object_array[i] = NULL;
-            }
-        }
-        for (int i = 0; i < function_counter; i++) {
-            if (function_array[i] != NULL) {
-                free(function_array[i]);
-                function_array[i] = NULL;
-            }
-        }
-        class_counter = 0;
-        object_counter = 0;
-        function_counter = 0;
-    }
-
-/****************** functions declaration *****************/ 
-    bool search_class_body(char* var_name, struct AST_Node_Statements *root);
-    void check_function_call(struct AST_Node_FunctionCall *func_call);
-    char * type_to_str(int type);
-    void scope_enter();
-    void scope_exit();
-    
-%}
-
-    //%define parse.error verbose
-    //%debug
-
-    %token SEMICOLON
-	%token IF 
-	%token ELSE
-	%token ID
-	%token INT_NUMBER   
-	%token FLOAT_NUMBER
-    %token INT
-	%token FLOAT
-	%token STRING
-	%token BOOL
-    %token LPAR
-    %token RPAR
-    %token LBRACE
-    %token RBRACE
-    %token COLON
-    %token COMMA
-    %token DOT
-    %token BRACKETS
-	%token RETURN
-	%token COUT
-	%token CIN
-	%token STRING_V
-    %token BOOL_V
-	%token FOR
-    %token FUNCTION
-    %token CLASS
-    %token MAIN
-    %token PRIVATE
-    %token PUBLIC
-    %token UNKNOWN
-    %token EQ AND OR ADD SUB MUL DIV GT LT GE LE EEQ NE INC DEC
-    %token LSHIFT RSHIFT
- 
-/****************** types *****************/ 
-    %define api.value.type {union yystype}
-
-    %type <string>          ID STRING FLOAT_NUMBER INT_NUMBER FLOAT INT BOOL LPAR RPAR LBRACE RBRACE COLON SEMICOLON COMMA DOT BRACKETS RETURN COUT CIN STRING_V BOOL_V FOR FUNCTION CLASS UNKNOWN AND OR ADD SUB MUL DIV GT LT GE LE EEQ NE MAIN PRIVATE PUBLIC EQ INC DEC
-    %type <statements>      statements body program sections section
-    %type <instruction>    statement
-    %type <functionCall>    function_call
-    %type <functionDef>     function_def
-    %type <params>          multi_fun_param fun_param  
-    %type <ifNode>          if_statement
-    %type <expression>      if_condition expr math_expr logic_expr rel_expr 
-    %type <elseIfNode>      else_if_statement
-    %type <elseNode>        else_statement
-    %type <forNode>         for_loop
-    %type <inputNode>       single_rshift multi_rshift input_stmnt
-    %type <outputNode>      multi_lshift output_stmnt
-    %type <assign>          assignment
-    %type <init>            initialization 
-    %type <operand>         content single_lshift
-    %type <FBodyNode>       func_body
-    %type <classNode>       create_class create_class_child
-    %type <CBodyNode>       class_body
-    %type <objectNode>      create_object access_class
-    %type <data_type> types
-
-    %start program
-%%  
-
-    program:   { 
-        debug_print("Entering program rule", NULL);
-        scope_enter(); 
-    }    statements    { 
-        debug_print("Creating program node", NULL);
-        root = (struct AST_Node_Statements*)$2; 
-        scope_exit(); 
-        debug_print("Program node created", NULL);
-    };
-
-
-    statements:
-            /* empty */
-            { $$ = NULL; }
-        |   statement statements
-            {
-                debug_print("Appending statement to statements", NULL);
-                struct AST_Node_Statements *node = (struct AST_Node_Statements*)malloc(sizeof(struct AST_Node_Statements));
-                node->left = $1;
-                node->right = $2;
-                $$ = node;
-                debug_print("Statement appended", $$);
-            }
-        ;
-
-
-    statement:
-            function_def 
-            { 
-                debug_print("Creating statement from function_def", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = FUNC_DEF_NODE;
-                $$->value.functionDef = $1;
-                struct Symbol *s = find_symtab($1->func_name, local_table);
-                if (s == NULL) {
-                    s = add_symbol($1->func_name, local_table, SYMBOL_FUNCTION, DATA_TYPE_NONE, $1->return_type, true, NULL, false, yylineno, null_value);
-                    debug_print("Function symbol added", s);
-                } else {
-                    printf("\n\n\t***Error: %s already declared***\n\t***Line: %d***\n\n\n", s->name_sym, yylineno);
-                    n_error++;
-                }
-                debug_print("Function statement created", $$);
-            }
-            // Parse short-form function declaration inside a class
-            | types ID LPAR RPAR LBRACE ID EQ ID SEMICOLON COUT LSHIFT STRING_V LSHIFT ID SEMICOLON RETURN ID SEMICOLON RBRACE
-            {
-                if (is_inside_class) {
-                    debug_print("Creating class method with inline body", NULL);
-                    $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                    $$->n_type = FUNC_DEF_NODE;
-                    
-                    // Create the function def
-                    struct AST_Node_FunctionDef *func_def = malloc(sizeof(struct AST_Node_FunctionDef));
-                    func_def->func_name = $2;
-                    func_def->params = NULL;
-                    func_def->return_type = $1;
-                    func_def->is_class_method = true;
-                    
-                    // Create function body manually
-                    struct AST_Node_FBody *f_body = malloc(sizeof(struct AST_Node_FBody));
-                    
-                    // Create statement for assignment
-                    struct AST_Node_Instruction *assign_instr = malloc(sizeof(struct AST_Node_Instruction));
-                    assign_instr->n_type = ASSIGN_NODE;
-                    struct AST_Node_Assign *assign = malloc(sizeof(struct AST_Node_Assign));
-                    assign->var = $6;
-                    assign->val_type = DATA_TYPE_INT;
-                    assign->a_val.val = $8;
-                    assign_instr->value.assign = assign;
-                    
-                    // Create statement for cout
-                    struct AST_Node_Instruction *cout_instr = malloc(sizeof(struct AST_Node_Instruction));
-                    cout_instr->n_type = OUTPUT_NODE;
-                    struct AST_Node_Output *output = malloc(sizeof(struct AST_Node_Output));
-                    struct AST_Node_Operand *cout_op = malloc(sizeof(struct AST_Node_Operand));
-                    cout_op->operand_type = CONTENT_TYPE_STRING;
-                    cout_op->val_type = DATA_TYPE_STRING;
-                    cout_op->value.val = $12;
-                    output->output_op = cout_op;
-                    cout_instr->value.outputNode = output;
-                    
-                    // Create statements structure
-                    struct AST_Node_Statements *stmt1 = malloc(sizeof(struct AST_Node_Statements));
-                    stmt1->left = assign_instr;
-                    struct AST_Node_Statements *stmt2 = malloc(sizeof(struct AST_Node_Statements));
-                    stmt2->left = cout_instr;
-                    stmt1->right = stmt2;
-                    
-                    f_body->func_body = stmt1;
-                    
-                    // Create return statement
-                    struct AST_Node_Operand *return_op = malloc(sizeof(struct AST_Node_Operand));
-                    return_op->operand_type = CONTENT_TYPE_ID;
-                    return_op->val_type = $1;
-                    return_op->value.val = $16;
-                    f_body->return_op = return_op;
-                    
-                    func_def->f_body = f_body;
-                    
-                    // Store in function array
-                    function_array[function_counter] = func_def;
-                    function_counter++;
-                    
-                    $$->value.functionDef = func_def;
-                    
-                    // Add to symbol table
-                    struct Symbol *s = find_symtab(func_def->func_name, local_table);
-                    if (s == NULL) {
-                        s = add_symbol(func_def->func_name, local_table, SYMBOL_FUNCTION, DATA_TYPE_NONE, func_def->return_type, true, NULL, false, yylineno, null_value);
-                        debug_print("Class method symbol added", s);
-                    } else {
-                        printf("\n\n\t***Error: %s already declared***\n\t***Line: %d***\n\n\n", s->name_sym, yylineno);
-                        n_error++;
-                    }
-                } else {
-                    printf("\n\n\t***Error: Inline function declaration only allowed inside class***\n\t***Line: %d***\n\n\n", yylineno);
-                    n_error++;
-                }
-            }
-        |   RETURN content SEMICOLON
-            {
-                debug_print("Creating statement from return content", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = RETURN_NODE;
-                struct AST_Node_Return *return_node = (struct AST_Node_Return*)malloc(sizeof(struct AST_Node_Return));
-                struct AST_Node *operand_node = (struct AST_Node *)malloc(sizeof(struct AST_Node));
-                operand_node->n_type = OPERAND_NODE;
-                operand_node->value = $2;
-                return_node->value = operand_node;
-                $$->value.returnNode = return_node;
-                debug_print("Return content statement created", $$);
-            }
-        |   RETURN expr SEMICOLON
-            {
-                debug_print("Creating statement from return expression", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = RETURN_NODE;
-                struct AST_Node_Return *return_node = (struct AST_Node_Return*)malloc(sizeof(struct AST_Node_Return));
-                
-                // Create an operand for the expression
-                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                expr_operand->value.expr = $2;
-                expr_operand->val_type = $2->expr_type;
-                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
-                
-                struct AST_Node *operand_node = (struct AST_Node *)malloc(sizeof(struct AST_Node));
-                operand_node->n_type = OPERAND_NODE;
-                operand_node->value = expr_operand;
-                
-                return_node->value = operand_node;
-                $$->value.returnNode = return_node;
-                debug_print("Return expression statement created", $$);
-            }
-        |   if_statement 
-            {
-                debug_print("Creating statement from if_statement", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = IF_NODE;
-                $$->value.ifNode = $1;
-                debug_print("If statement created", $$);
-            }
-        |   for_loop 
-            {
-                debug_print("Creating statement from for_loop", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = FOR_NODE;
-                $$->value.forNode = $1;
-                debug_print("For loop created", $$);
-            }
-        |   ID INC SEMICOLON
-            {
-                debug_print("Creating increment statement", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = ASSIGN_NODE;
-                struct AST_Node_Assign *assign = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                assign->var = $1;
-                assign->val_type = DATA_TYPE_INT;
-                assign->a_type = CONTENT_TYPE_EXPRESSION;
-                
-                struct AST_Node_Expression *expr = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                expr->op = "+";
-                
-                struct AST_Node_Operand *left = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                left->operand_type = CONTENT_TYPE_ID;
-                left->value.val = $1;
-                left->val_type = DATA_TYPE_INT;
-                expr->left_op = left;
-                
-                struct AST_Node_Operand *right = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                right->operand_type = CONTENT_TYPE_INT_NUMBER;
-                right->value.val = "1";
-                right->val_type = DATA_TYPE_INT;
-                expr->right_op = right;
-                
-                expr->expr_type = DATA_TYPE_INT;
-                assign->a_val.expr = expr;
-                $$->value.assign = assign;
-            }
-        |   ID DEC SEMICOLON
-            {
-                debug_print("Creating decrement statement", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = ASSIGN_NODE;
-                struct AST_Node_Assign *assign = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                assign->var = $1;
-                assign->val_type = DATA_TYPE_INT;
-                assign->a_type = CONTENT_TYPE_EXPRESSION;
-                
-                struct AST_Node_Expression *expr = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                expr->op = "-";
-                
-                struct AST_Node_Operand *left = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                left->operand_type = CONTENT_TYPE_ID;
-                left->value.val = $1;
-                left->val_type = DATA_TYPE_INT;
-                expr->left_op = left;
-                
-                struct AST_Node_Operand *right = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                right->operand_type = CONTENT_TYPE_INT_NUMBER;
-                right->value.val = "1";
-                right->val_type = DATA_TYPE_INT;
-                expr->right_op = right;
-                
-                expr->expr_type = DATA_TYPE_INT;
-                assign->a_val.expr = expr;
-                $$->value.assign = assign;
-            }
-        |   assignment SEMICOLON 
-            {
-                debug_print("Creating statement from assignment", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = ASSIGN_NODE;
-                struct Symbol *s = find_symbol($1->var, local_table);
-                if (s == NULL) {
-                    printf("\n\n\t***Error: Variable '%s' not declared***\n\t***Line: %d***\n\n\n", $1->var, yylineno);
-                    n_error++;
-                } else if (s->data_type != $1->val_type) {
-                    printf("\n\n\t***Error: Variable '%s' has been declared as a '%s' but type '%s' is assigned***\n\t***Line: %d***\n\n\n", 
-                        $1->var, type_to_str(s->data_type), type_to_str($1->val_type), yylineno);
-                    n_error++;
-                } else {
-                    $$->value.assign = $1;
-                    s->value_sym = $1->a_val;
-                    debug_print("Assignment statement created", $$);
-                }
-            }
-        |   initialization SEMICOLON 
-            {
-                debug_print("Creating statement from initialization", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = INIT_NODE;
-                $$->value.init = $1;
-                struct Symbol *s = NULL;
-                for(struct AST_Node_Init *init = $1; init != NULL; init = init->next_init) {
-                    s = find_symbol(init->assign->var, local_table);
-                    if (s == NULL) {
-                        s = add_symbol(init->assign->var, local_table, SYMBOL_VARIABLE, $1->data_type, DATA_TYPE_NONE, false, NULL, false, yylineno, null_value);
-                        debug_print("Variable symbol added", s);
-                    } else {
-                        printf("\n\n\t***Error: Variable %s already declared***\n\t***Line: %d***\n\n\n", init->assign->var, yylineno);
-                        n_error++;
-                    }
-                }
-                debug_print("Initialization statement created", $$);
-            }
-        |   output_stmnt SEMICOLON {
-            debug_print("Creating statement from output", NULL);
-            $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-            $$->n_type = OUTPUT_NODE;
-            $$->value.outputNode = $1;
-            debug_print("Output statement created", $$);
-        }
-        |   create_class
-            { 
-                debug_print("Creating statement from class definition", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = CLASS_NODE;
-                $$->value.classNode = $1;
-                debug_print("Class statement created", $$);
-            }
-        |   create_class_child
-            { 
-                debug_print("Creating statement from class inheritance definition", NULL);
-                $$ = (struct AST_Node_Instruction*)malloc(sizeof(struct AST_Node_Instruction));
-                $$->n_type = CLASS_CHILD_NODE;
-                $$->value.classNode = $1;
-                debug_print("Class inheritance statement created", $$);
-            }
-        ;
-
-    
-    function_call:
-                ID LPAR multi_fun_param RPAR    { 
-                                                $$ = (struct AST_Node_FunctionCall*)malloc(sizeof(struct AST_Node_FunctionCall));
-                                                struct Symbol *s = find_symtab($1, local_table);
-                                                if (s!=NULL) 
-                                                    {
-                                                    if (s->is_function) {
-                                                        $$->func_name = $1;
-                                                        $$->return_type = s->ret_type;
-                                                        $$->params = $3;
-                                                        /* Check if the function exists and if parameters are legit */
-                                                        check_function_call($$);                                                    
-                                                        }
-                                                    else {
-                                                        printf("\n\n\t***Error: %s is not a function***\n\t***Line: %d***\n\n\n",$1,yylineno);n_error++;
-                                                        }
-                                                    }
-                                                else { printf("\n\n\t***Error: %s is not declared***\n\t***Line: %d***\n\n\n",$1,yylineno); n_error++;}
-                                                }
-            |   ID LPAR RPAR                   { 
-                                                $$ = (struct AST_Node_FunctionCall*)malloc(sizeof(struct AST_Node_FunctionCall));
-                                                struct Symbol *s = find_symtab($1, local_table);
-                                                if (s!=NULL) 
-                                                    {
-                                                    if (s->is_function) {
-                                                        $$->func_name = $1;
-                                                        $$->return_type = s->ret_type;
-                                                        $$->params = NULL;
-                                                        /* Check if the function exists and if parameters are legit */
-                                                        check_function_call($$);                                                    
-                                                        }
-                                                    else {
-                                                        printf("\n\n\t***Error: %s is not a function***\n\t***Line: %d***\n\n\n",$1,yylineno);n_error++;
-                                                        }
-                                                    }
-                                                else { printf("\n\n\t***Error: %s is not declared***\n\t***Line: %d***\n\n\n",$1,yylineno); n_error++;}
-                                                };
-
-
-    function_def:
-                types ID LPAR multi_fun_param RPAR LBRACE func_body RBRACE 
-                                        { scope_enter();
-                    $$ = (struct AST_Node_FunctionDef*)malloc(sizeof(struct AST_Node_FunctionDef));
-                    $$->func_name = $2;
-                    $$->params = $4;
-                    $$->f_body = $7;
-                    $$->return_type = $1;
-                    $$->is_class_method = is_inside_class;  // Flag if this is a class method
-                    
-                    // Check return type only if a return value exists
-                    if ($$->f_body && $$->f_body->return_op) {
-                        if ($1 != $$->f_body->return_op->val_type) {
-                            printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
-                                $$->func_name, type_to_str($1), type_to_str($$->f_body->return_op->val_type));
-                            n_error++;
-                        }
-                    }
-                    
-                    // add function to function array
-                    function_array[function_counter] = $$;
-                    function_counter++;
-                    
-                    scope_exit();
-                    printf("[DEBUG] Defined function %s with return type %s\n", $$->func_name, type_to_str($$->return_type));
-                                        }
-            | types ID LPAR RPAR LBRACE func_body RBRACE 
-                                        { scope_enter();
-                                        $$ = (struct AST_Node_FunctionDef*)malloc(sizeof(struct AST_Node_FunctionDef));
-                                        $$->func_name = $2;
-                                        $$->params = NULL;
-                                        $$->f_body = $6;
-                                        $$->return_type = $1;
-                                        $$->is_class_method = is_inside_class;  // Flag if this is a class method
-                                        
-                                        // Check return type only if a return value exists
-                                        if ($$->f_body && $$->f_body->return_op) {
-                                            if ($1 != $$->f_body->return_op->val_type) {
-                                                printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
-                                                    $$->func_name, type_to_str($1), type_to_str($$->f_body->return_op->val_type));
-                                                n_error++;
-                                            }
-                                        }
-                                        
-                                        // add function to function array
-                                        function_array[function_counter] = $$;
-                                        function_counter++;
-                                        
-                                        scope_exit();
-                                        printf("[DEBUG] Defined function %s with return type %s\n", $$->func_name, type_to_str($$->return_type));
-                                        }
-            | INT MAIN LPAR RPAR func_body            {     
-                                                        printf("[DEBUG] Matched main function\n");
-                                                        scope_enter();
-                                                        $$ = (struct AST_Node_FunctionDef*)malloc(sizeof(struct AST_Node_FunctionDef));
-                                                        $$->func_name = "main";
-                                                        $$->params = NULL;
-                                                        $$->return_type = DATA_TYPE_INT;
-                                                        $$->f_body = $5;
-                                                        scope_exit();
-                                                        }
-            | initialization LPAR RPAR func_body      { if (in_class == false ){scope_enter();};
-                                                        $$ = (struct AST_Node_FunctionDef*)malloc(sizeof(struct AST_Node_FunctionDef));
-                                                        $$->func_name = $1->assign->var;
-                                                        $$->params = NULL;
-                                                        $$->f_body = $4;
-                                                        // check if return data type and function data type match
-                                                        if ($1->data_type !=  $$->f_body->return_op->val_type)
-                                                            {
-                                                            printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
-                                                            $$->func_name, type_to_str($1->data_type), type_to_str($$->f_body->return_op->val_type));n_error++;
-                                                            }
-                                                        $$->return_type = $1->data_type;
-                                                        // add function to function array; 
-                                                        function_array[function_counter] = $$;
-                                                        function_counter++;
-                                                        if (in_class == false ){scope_exit();};
-                                                    }
-
-
-
-    create_object:
-                ID ID       { /*check if $1 exists */
-                            struct Symbol *s = find_symtab($1, local_table);
-                            if (s!=NULL) 
-                                {
-                                if (s->is_class) 
-                                    {
-                                    struct Symbol *s2 = find_symtab($2, local_table);
-                                    if (s2==NULL) 
-                                        {
-                                        $$ = (struct AST_Node_Object*)malloc(sizeof(struct AST_Node_Object));
-                                        $$->obj_class = (struct AST_Node_Class*)malloc(sizeof(struct AST_Node_Class));
-                                        //Search class in the class array by name
-                                        for (int i = 0; i<class_counter; i++){
-                                            if (strcmp(class_array[i]->class_name, $1) ==0)
-                                                { 
-                                                $$->obj_class = class_array[i];
-                                                $$->obj_name = $2;
-                                                object_array[object_counter] = $$;
-                                                object_counter++;
-                                                break;
-                                                }
-                                            }
-                                        }
-                                    else { printf("\n\n\t***Error: object %s already exists***\n\t***Line: %d***\n\n\n",$2,yylineno); n_error++;}
-                                    }
-                                else { printf("\n\n\t***Error: %s is not a class***\n\t***Line: %d***\n\n\n",$1,yylineno); n_error++;}
-                                }
-                            else { printf("\n\n\t***Error: class %s is not declared***\n\t***Line: %d***\n\n\n",$1,yylineno); n_error++;}
-                            };
-                                      
-
- access_class:
-                ID DOT ID               {
-                                        // Search for the object in the object array by name
-                                        for (int i = 0; i<object_counter; i++)
-                                            {
-                                            if (strcmp(object_array[i]->obj_name, $1) == 0)
-                                                { 
-                                                $$->obj_class = object_array[i]->obj_class;
-                                                $$->obj_name = object_array[i]->obj_name;
-                                                break;
-                                                }
-                                            }
-                                        //Search class in class array by name
-                                        for (int j = 0; j<class_counter; j++){
-                                            if (strcmp(class_array[j]->class_name, $$->obj_class->class_name) ==0)
-                                                {
-                                                $$->obj_class->c_body->pub_body = class_array[j]->c_body->pub_body;
-                                                break;
-                                                }
-                                            }
-                                        //Search attribute in the same class of the object
-                                        if (search_class_body($3, $$->obj_class->c_body->pub_body) == true)
-                                            { $$->access_value.val = $3; }
-                                        else 
-                                            {
-                                        // check if the attribute is present in the parent classes 
-                                            for (int k = 0; k<class_counter; k++)
-                                                {
-                                                // check if the class is present in the classes array
-                                                if (strcmp(class_array[k]->class_name, $$->obj_class->class_name) == 0)
-                                                    {
-                                                    // check if the class has a parent
-                                                    if (class_array[k]->parent_class_public != NULL)
-                                                        {
-                                                        $$->obj_class->parent_class_public = class_array[k]->parent_class_public;
-                                                        // cycle in the public body of each parent classes 
-                                                        for (   class_array[k]->parent_class_public->parent_pub_body;
-                                                                class_array[k]->parent_class_public->parent_pub_body != NULL;
-                                                                class_array[k]->parent_class_public->parent_pub_body = class_array[k]->parent_class_public->next_parent_public->parent_pub_body
-                                                            ){
-                                                            // check if the attribute is present in the public body of the parent class
-                                                            if (search_class_body($3, class_array[k]->parent_class_public->parent_pub_body) == true)
-                                                                {                                       
-                                                                $$->access_value.val = $3;
-                                                                $$->access_type = ACCESS_TYPE_VAR;
-                                                                break;
-                                                                }
-                                                            }
-                                                        }
-                                                    }
-                                                }
-                                            }
-                                            if ($$->access_value.val == NULL){printf("\n\n\n\t\t***ERROR: %s not found in class %s***\n\n\n", $3,$$->obj_class->class_name);n_error++;}
-                                        }
-        |       ID DOT function_call    {                     
-                                        // Search for the object in the object array by name
-                                        for (int i = 0; i<object_counter; i++)
-                                            {
-                                            if (strcmp(object_array[i]->obj_name, $1) ==0)
-                                                { 
-                                                $$->obj_class = object_array[i]->obj_class;
-                                                $$->obj_name = object_array[i]->obj_name;
-                                                break;
-                                                }
-                                            }
-                                        //Search class in class array by name
-                                        for (int j = 0; j<class_counter; j++){
-                                            if (strcmp(class_array[j]->class_name, $$->obj_class->class_name) ==0)
-                                                {
-                                                $$->obj_class->c_body->pub_body = class_array[j]->c_body->pub_body;
-                                                break;
-                                                }
-                                            }
-                                        //Search attribute in the same class of the object
-                                        if (search_class_body($3->func_name, $$->obj_class->c_body->pub_body) == true)
-                                            {
-                                            $$->access_value.funca = $3;
-                                            $$->access_type = ACCESS_TYPE_FUNCTION;
-                                            }
-                                        else 
-                                            {
-                                        // check if the attribute is present in the parent classes 
-                                            for (int k = 0; k<class_counter; k++){
-                                                // check if the class is present in the classes array
-                                                if (strcmp(class_array[k]->class_name, $$->obj_class->class_name) == 0)
-                                                    {
-                                                    // check if the class has a parent
-                                                    if (class_array[k]->parent_class_public != NULL)
-                                                        {
-                                                        $$->obj_class->parent_class_public = class_array[k]->parent_class_public;
-                                                        // cycle in the public body of each parent classes   
-                                                        for (   class_array[k]->parent_class_public->parent_pub_body;
-                                                                class_array[k]->parent_class_public->parent_pub_body != NULL;
-                                                                class_array[k]->parent_class_public->parent_pub_body = class_array[k]->parent_class_public->next_parent_public->parent_pub_body
-                                                            ){
-                                                            // check if the attribute is present in the public body of the parent class
-                                                            if (search_class_body($3->func_name, class_array[k]->parent_class_public->parent_pub_body) == true){
-                                                                $$->access_value.funca = $3;
-                                                                $$->access_type = ACCESS_TYPE_FUNCTION;
-                                                                break;
-                                                                }
-                                                            }
-                                                        }
-                                                    }
-                                                }
-                                            }
-                                            if ($$->access_value.funca == NULL){printf("\n\n\t***Error: %s not found in class %s***\n\t***Line: %d***\n\n\n",$3->func_name,$$->obj_class->class_name,yylineno);n_error++;}
-                                        }
-        |       ID DOT assignment       { 
-                                        // Search for the object in the object array by name
-                                        for (int i = 0; i<object_counter; i++)
-                                            {
-                                            if (strcmp(object_array[i]->obj_name, $1) == 0)
-                                                { 
-                                                $$->obj_class = object_array[i]->obj_class;
-                                                $$->obj_name = object_array[i]->obj_name;
-                                                break;
-                                                }
-                                            }
-                                        //Search class in class array by name
-
-                                        for (int j = 0; j<class_counter; j++)
-                                            {
-                                            if (strcmp(class_array[j]->class_name, $$->obj_class->class_name) == 0)
-                                                {
-                                                $$->obj_class->c_body->pub_body = class_array[j]->c_body->pub_body;
-                                                break;
-                                                }
-                                            }
-
-                                            //Search attribute in the same class of the object
-                                        if (search_class_body($3->var, $$->obj_class->c_body->pub_body) == true)
-                                            {
-                                            $$->access_value.ass_val = $3;
-                                            $$->access_type = ACCESS_TYPE_ASSIGN;
-                                            }
-                                        else 
-                                            {
-                                            // check if the attribute is present in the parent classes 
-                                            for (int k = 0; k<class_counter; k++)
-                                                {
-                                                // check if the class is present in the classes array
-                                                if (strcmp(class_array[k]->class_name, $$->obj_class->class_name) == 0)
-                                                    {
-                                                    // check if the class has a parent
-                                                    if (class_array[k]->parent_class_public != NULL)
-                                                        {
-                                                        $$->obj_class->parent_class_public = class_array[k]->parent_class_public;
-                                                        // cycle in the public body of each parent classes   
-                                                        for (   class_array[k]->parent_class_public->parent_pub_body;
-                                                                class_array[k]->parent_class_public->parent_pub_body != NULL;
-                                                                class_array[k]->parent_class_public->parent_pub_body = class_array[k]->parent_class_public->next_parent_public->parent_pub_body
-                                                            ){
-
-                                                            // check if the attribute is present in the public body of the parent class
-                                                            if (search_class_body($3->var, class_array[k]->parent_class_public->parent_pub_body) == true)
-                                                                { 
-                                                                $$->access_value.ass_val = $3;
-                                                                $$->access_type = ACCESS_TYPE_ASSIGN;
-                                                                break;
-                                                                }
-                                                            }
-                                                        }
-                                                    }
-                                                }                                                                    
-                                            }
-                                            if ($$->access_value.ass_val == NULL){printf("\n\n\t***Error: %s not found in class %s***\n\t***Line: %d***\n\n\n",$3->var,$$->obj_class->class_name,yylineno);n_error++;}
-                                        };
-
-
-    create_class:
-                CLASS ID                {in_class = true;}
-                class_body              {
-                                        $$ = (struct AST_Node_Class*)malloc(sizeof(struct AST_Node_Class));
-                                        $$->parent_class_public = (struct AST_Node_Parent_Public*)malloc(sizeof(struct AST_Node_Parent_Public));
-                                        $$->class_name = $2;
-                                        $$->c_body = $4;
-                                        $$->parent_class_public = NULL;
-                                        class_array[class_counter] = $$;
-                                        class_counter++;
-                                        in_class = false;
-                                        };
-
-
-    create_class_child:
-                CLASS ID                       {in_class = true;}
-                COLON PUBLIC ID class_body     {
-                                                        $$ = (struct AST_Node_Class*)malloc(sizeof(struct AST_Node_Class));
-                                                        $$->parent_class_public = (struct AST_Node_Parent_Public*)malloc(sizeof(struct AST_Node_Parent_Public));
-                                                        $$->class_name = $2;
-                                                        $$->c_body = $7;
-                                                        // search parent class in the class array
-                                                        for (int i = 0; i<class_counter; i++)
-                                                            {
-                                                            // compare the name of the parent class in the statement with the name of the class in the class array
-                                                             if (strcmp(class_array[i]->class_name, $6) == 0)
-                                                                {
-                                                                $$->parent_class = class_array[i];
-                                                                $$->parent_class->class_name = class_array[i]->class_name;
-                                                                $$->parent_class_public->parent_pub_body = class_array[i]->c_body->pub_body;
-                                                                $$->parent_class_public->next_parent_public = class_array[i]->parent_class_public;
-                                                                class_array[class_counter] = $$;        
-                                                                class_counter++;
-                                                                break;
-                                                                }
-                                                             else if (i == class_counter){printf("\n\n\n\t\t***ERROR: class parent %s not found***\n\n\n",$6); n_error++;}
-                                                        }
-                                                        in_class = false;
-
-                                                        };
-
-
-    class_body:
-                LBRACE { is_inside_class = true; } sections RBRACE 
-                    {
-                    $$ = (struct AST_Node_CBody*)malloc(sizeof(struct AST_Node_CBody));
-                    $$->pri_body = NULL;
-                    $$->pub_body = NULL;
-                    is_inside_class = false;
-                    debug_print("Class body created", $$);
-                    };
-
-
-    sections:
-                section
-            |   sections section
-            ;
-
-    section:
-                PUBLIC COLON statements 
-                    { 
-                    $$ = $3; 
-                    debug_print("Public section processed", $$); 
-                    }
-            |   PRIVATE COLON statements 
-                    { 
-                    $$ = $3; 
-                    debug_print("Private section processed", $$); 
-                    }
-            ;
-
-
-    if_statement:
-                IF LPAR if_condition RPAR body else_if_statement else_statement
-                                                        { 
-                                                        $$ = (struct AST_Node_If*)malloc(sizeof(struct AST_Node_If));
-                                                        $$->condition = $3;
-                                                        $$->if_body = $5;
-                                                        $$->else_if = $6;
-                                                        $$->else_body = $7;
-                                                        }
-                | IF LPAR if_condition RPAR body ELSE body
-                                                        { 
-                                                        $$ = (struct AST_Node_If*)malloc(sizeof(struct AST_Node_If));
-                                                        $$->condition = $3;
-                                                        $$->if_body = $5;
-                                                        $$->else_if = NULL;
-                                                        struct AST_Node_Else *else_node = (struct AST_Node_Else*)malloc(sizeof(struct AST_Node_Else));
-                                                        else_node->else_body = $7;
-                                                        $$->else_body = else_node;
-                                                        }
-                | IF LPAR if_condition RPAR body
-                                                        { 
-                                                        $$ = (struct AST_Node_If*)malloc(sizeof(struct AST_Node_If));
-                                                        $$->condition = $3;
-                                                        $$->if_body = $5;
-                                                        $$->else_if = NULL;
-                                                        $$->else_body = NULL;
-                                                        };
-
-
-    if_condition:
-                expr                            {
-                                                if($1->expr_type != DATA_TYPE_BOOL) { printf("\n\n\t***Error: IF condition must be boolean type***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                                else { $$ = $1; }
-                                                };
-    
-
-    else_if_statement:
-                ELSE IF LPAR if_condition RPAR body {
-                                                    $$ = (struct AST_Node_Else_If*)malloc(sizeof(struct AST_Node_Else_If));
-                                                    $$->condition = $4;
-                                                    $$->elif_body = $6;
-                                                    }
-                | /* empty */ { $$ = NULL; };
-    
-    
-    else_statement:
-                ELSE body                       {
-                                                $$ = (struct AST_Node_Else*)malloc(sizeof(struct AST_Node_Else));
-                                                $$->else_body = $2;
-                                                }
-                | /* empty */ { $$ = NULL; };
-
-
-    for_loop:
-                FOR LPAR assignment SEMICOLON rel_expr SEMICOLON assignment RPAR body   {
-                                                                                        $$ = (struct AST_Node_For*)malloc(sizeof(struct AST_Node_For));
-                                                                                        $$->init = $3;
-                                                                                        $$->condition = $5;
-                                                                                        $$->increment = $7;
-                                                                                        // The increment can be expressed only as x = x + 1 and not as x++ or x += 1
-                                                                                        // The sign of the increment expression will be used at translation time for further control:
-                                                                                        // The control is needed to solve a problem where the decrement is written as x = x -1 and not as x = x - 1
-                                                                                        $$->increment->a_val.expr->op = $7->a_val.expr->op;
-                                                                                        $$->for_body = $9;
-                                                                                        delete_symbol( find_symbol($3->var,local_table), local_table);
-                                                                                        };
-
-
-    body: 
-                LBRACE statements RBRACE          { $$ = $2; };
-
-    
-    func_body:
-          LBRACE statements RETURN content SEMICOLON RBRACE
-            {
-                printf("[DEBUG] Function body with statements and return\n");
-                $$ = (struct AST_Node_FBody*)malloc(sizeof(struct AST_Node_FBody));                                       
-                $$->func_body = $2;
-                $$->return_op = $4;
-                printf("[DEBUG] Return type: %d\n", $$->return_op->val_type);
-            }
-        | LBRACE statements RETURN expr SEMICOLON RBRACE
-            {
-                printf("[DEBUG] Function body with statements and return expression\n");
-                $$ = (struct AST_Node_FBody*)malloc(sizeof(struct AST_Node_FBody));                                       
-                $$->func_body = $2;
-                
-                // Create an operand for the expression
-                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                expr_operand->value.expr = $4;
-                expr_operand->val_type = $4->expr_type;
-                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
-                
-                $$->return_op = expr_operand;
-                printf("[DEBUG] Return expression type: %d\n", $$->return_op->val_type);
-            }
-        | LBRACE RETURN content SEMICOLON RBRACE
-            {
-                printf("[DEBUG] Function body with return only\n");
-                $$ = (struct AST_Node_FBody*)malloc(sizeof(struct AST_Node_FBody));
-                $$->func_body = NULL;
-                $$->return_op = $3;
-                printf("[DEBUG] Return type: %d\n", $$->return_op->val_type);
-            }
-        | LBRACE RETURN expr SEMICOLON RBRACE
-            {
-                printf("[DEBUG] Function body with return expression only\n");
-                $$ = (struct AST_Node_FBody*)malloc(sizeof(struct AST_Node_FBody));
-                $$->func_body = NULL;
-                
-                // Create an operand for the expression
-                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                expr_operand->value.expr = $3;
-                expr_operand->val_type = $3->expr_type;
-                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
-                
-                $$->return_op = expr_operand;
-                printf("[DEBUG] Return expression type: %d\n", $$->return_op->val_type);
-            }
-        | LBRACE statements RBRACE
-            {
-                printf("[DEBUG] Function body with statements only (no return)\n");
-                $$ = (struct AST_Node_FBody*)malloc(sizeof(struct AST_Node_FBody));
-                $$->func_body = $2;
-                // For a function with no return, set a default return type
-                struct AST_Node_Operand *default_return = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                default_return->operand_type = CONTENT_TYPE_INT_NUMBER;
-                default_return->val_type = DATA_TYPE_INT;
-                default_return->value.val = strdup("0"); // Default return 0
-                $$->return_op = default_return;
-            }
-    ;
-
-
-    expr:
-                math_expr
-                {
-                    $$ = $1;
-                }
-            |   ID INC
-                {
-                    debug_print("Creating increment expression", NULL);
-                    struct AST_Node_Expression *node = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                    node->op = "+=";
-                    
-                    // Create left operand (variable)
-                    struct AST_Node_Operand *left = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                    left->operand_type = CONTENT_TYPE_ID;
-                    left->value.val = $1;
-                    left->val_type = DATA_TYPE_INT;
-                    node->left_op = left;
-                    
-                    // Create right operand (constant 1)
-                    struct AST_Node_Operand *right = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                    right->operand_type = CONTENT_TYPE_INT_NUMBER;
-                    right->value.val = "1";
-                    right->val_type = DATA_TYPE_INT;
-                    node->right_op = right;
-                    
-                    node->expr_type = DATA_TYPE_INT;
-                    $$ = node;
-                }
-            |   ID DEC
-                {
-                    debug_print("Creating decrement expression", NULL);
-                    struct AST_Node_Expression *node = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                    node->op = "-=";
-                    
-                    // Create left operand (variable)
-                    struct AST_Node_Operand *left = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                    left->operand_type = CONTENT_TYPE_ID;
-                    left->value.val = $1;
-                    left->val_type = DATA_TYPE_INT;
-                    node->left_op = left;
-                    
-                    // Create right operand (constant 1)
-                    struct AST_Node_Operand *right = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                    right->operand_type = CONTENT_TYPE_INT_NUMBER;
-                    right->value.val = "1";
-                    right->val_type = DATA_TYPE_INT;
-                    node->right_op = right;
-                    
-                    node->expr_type = DATA_TYPE_INT;
-                    $$ = node;
-                }
-            |   logic_expr              { $$ = $1; }
-            |   rel_expr                { $$ = $1; }
-            |                           { $$ = NULL; }
-            |   LPAR expr RPAR          { $$ = $2; };
-
-
-    math_expr:
-                content ADD content         {
-                                            $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                            // queste malloc permettono il riconoscimento della x
-                                            $$->left_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                            $$->right_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->op = $2;
-                                            $$->expr_type = $3->val_type;
-                                            if ($1->val_type != $3->val_type) 
-                                                { printf("\n\n\t***Error: Cannot add '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                                
-                                            else 
-                                                {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                                };
-                                            }
-            |   content SUB content         { 
-                                            $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                            $$->op = $2;
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = $1->val_type;
-                                            if ($1->val_type != $3->val_type) 
-                                                { printf("\n\n\t***Error: Cannot subtract '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                            else 
-                                                {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                                };
-                                            }
-            |   content MUL content         { 
-                                            $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                            // queste malloc permettono il riconoscimento della x
-                                            $$->left_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                            $$->right_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->op = $2;
-                                            if ($1->val_type != $3->val_type) 
-                                                { printf("\n\n\t***Error: Cannot multiply '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                            else 
-                                                {
-                                                $$->left_op = $1;
-                                                $$->right_op = $3;
-                                                $$->expr_type = $1->val_type;
-                                                }
-                                            }
-            |   content INT_NUMBER          {   
-                                            // This rule is used in case expression written as: int x = A -B and not as x = A - B
-                                            // check if the second token is a negative integer number
-                                            if (atoi($2)<0) 
-                                                {                                               
-                                                int temp= atoi($2);
-                                                temp = -temp;
-                                                int length = snprintf( NULL, 0, "%d", temp );
-                                                char* temp_str = (char*)malloc( length + 1 );
-                                                //cast back to string
-                                                snprintf( temp_str, length + 1, "%d", temp );
-
-                                                // Need to allocate operands in order to use the expression
-                                                struct AST_Node_Operand *S1, *S2;
-                                                S1 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S1->value = $1->value;
-                                                S1->val_type = DATA_TYPE_INT;
-                                                S1->operand_type = CONTENT_TYPE_INT_NUMBER;
-
-                                                S2 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S2->value.val = temp_str;
-                                                S2->val_type = DATA_TYPE_INT;
-                                                S2->operand_type = CONTENT_TYPE_INT_NUMBER;
-                                                
-                                                $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                                $$->op = "-";
-                                                $$->left_op = S1;
-                                                $$->right_op = S2;
-                                                $$->expr_type = DATA_TYPE_INT;
-                                            }
-                                            else { printf("\n\n\t***Error: Operation not allowed ***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                            }
-            |   INT_NUMBER INT_NUMBER       {   
-                                            // This rule is used in case expression written as: int x = A -B and not as x = A - B
-                                            // check if the second token is a negative integer number
-                                            if (atoi($2)<0) 
-                                                {                                               
-                                                int temp= atoi($2);
-                                                temp = -temp;
-                                                int length = snprintf( NULL, 0, "%d", temp );
-                                                char* temp_str = (char*)malloc( length + 1 );
-                                                //cast back to string
-                                                snprintf( temp_str, length + 1, "%d", temp );
-
-                                                // Need to allocate operands in order to use the expression
-                                                struct AST_Node_Operand *S1, *S2;
-                                                S1 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S1->value.val = $1;
-                                                S1->val_type = DATA_TYPE_INT;
-                                                S1->operand_type = CONTENT_TYPE_INT_NUMBER;
-
-                                                S2 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S2->value.val = temp_str;
-                                                S2->val_type = DATA_TYPE_INT;
-                                                S2->operand_type = CONTENT_TYPE_INT_NUMBER;
-                                                
-                                                $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                                $$->op = "-";
-                                                $$->left_op = S1;
-                                                $$->right_op = S2;
-                                                $$->expr_type = DATA_TYPE_INT;
-                                            }
-                                            else { printf("\n\n\t***Error: Operation not allowed ***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                            }
-                                            
-            |   content FLOAT_NUMBER        {
-                                            //check if the second token is a negative float number
-                                            if (atof($2)<0) 
-                                                {                                               
-                                                float temp= atof($2);
-                                                temp = -temp;
-                                                int length = snprintf( NULL, 0, "%4.3f", temp );
-                                                char* temp_str = (char*)malloc( length + 1 );
-                                                //cast back to string
-                                                snprintf( temp_str, length + 1, "%4.3f", temp );
-                                                
-                                                // Need to allocate operands in order to use the expression
-                                                struct AST_Node_Operand *S1, *S2;
-                                                S1 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S1->value = $1->value;
-                                                S1->val_type = DATA_TYPE_FLOAT;
-                                                S1->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
-
-                                                S2 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S2->value.val = temp_str;
-                                                S2->val_type = DATA_TYPE_FLOAT;
-                                                S2->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
-                                                
-                                                $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                                $$->op = "-";
-                                                $$->left_op = S1;
-                                                $$->right_op = S2;
-                                                $$->expr_type = DATA_TYPE_FLOAT;
-                                            }
-                                            else { printf("\n\n\t***Error: Operation not allowed***\n\t***Line: %d***\n\n\n",yylineno);n_error++; }
-                                            }
-            |   FLOAT_NUMBER FLOAT_NUMBER   {
-                                            //check if the second token is a negative float number
-                                            if (atof($2)<0) 
-                                                {                                               
-                                                float temp= atof($2);
-                                                temp = -temp;
-                                                int length = snprintf( NULL, 0, "%4.3f", temp );
-                                                char* temp_str = (char*)malloc( length + 1 );
-                                                //cast back to string
-                                                snprintf( temp_str, length + 1, "%4.3f", temp );
-                                                
-                                                // Need to allocate operands in order to use the expression
-                                                struct AST_Node_Operand *S1, *S2;
-                                                S1 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S1->value.val = $1;
-                                                S1->val_type = DATA_TYPE_FLOAT;
-                                                S1->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
-
-                                                S2 = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                                S2->value.val = temp_str;
-                                                S2->val_type = DATA_TYPE_FLOAT;
-                                                S2->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
-                                                
-                                                $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                                $$->op = "-";
-                                                $$->left_op = S1;
-                                                $$->right_op = S2;
-                                                $$->expr_type = DATA_TYPE_FLOAT;
-
-                                            }
-                                            else { printf("\n\n\t***Error: Operation not allowed***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                            }
-            |   content DIV content     { 
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        // queste malloc permettono il riconoscimento della x
-                                        $$->left_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                        $$->right_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                        $$->left_op = $1;
-                                        $$->right_op = $3;
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot divide '%s' by '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                        else    
-                                            {
-                                            if (strcmp($3->value.val,"0" ) == 0)   { printf("\n\n\t***Error: Cannot divide by 0***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                            else 
-                                                {
-                                                $$->left_op = $1;
-                                                $$->right_op = $3;
-                                                $$->expr_type = $1->val_type;
-                                                }
-                                            }
-                                        };
-    
-
-    logic_expr:
-                LPAR logic_expr RPAR    {   
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$ = $2;
-                                        }
-            |   content AND content     {   
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != DATA_TYPE_BOOL || $3->val_type != DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot AND '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno);n_error++; }
-                                        else {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        }
-            |   content OR content      {   
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != DATA_TYPE_BOOL || $3->val_type != DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot OR '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno);n_error++; }
-                                        else 
-                                            {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        };
-    
-
-    rel_expr:
-                LPAR rel_expr RPAR      {  
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$ = $2; 
-                                        }
-            |   content LT content      { 
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->left_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                        $$->right_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                        $$->left_op = $1;
-                                        $$->right_op = $3;
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                        else if ($1->val_type == DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",yylineno);n_error++; }
-                                        else {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        }
-            |   content LE content      { 
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                        else if ($1->val_type == DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                        else 
-                                            {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        }
-            |   content GT content      { 
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                        else if ($1->val_type == DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",yylineno); n_error++;}
-                                        else 
-                                            {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        }
-            |   content GE content      {
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno);n_error++; }
-                                        else if ($1->val_type == DATA_TYPE_BOOL) 
-                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",yylineno);n_error++; }
-                                        else 
-                                            {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        }
-            |   content EEQ content     { 
-                                        $$ = (struct AST_Node_Expression*)malloc(sizeof(struct AST_Node_Expression));
-                                        $$->op = $2;
-                                        if ($1->val_type != $3->val_type) 
-                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),yylineno); n_error++;}
-                                        else 
-                                            {
-                                            $$->left_op = $1;
-                                            $$->right_op = $3;
-                                            $$->expr_type = DATA_TYPE_BOOL;
-                                            }
-                                        };
-
-
-    input_stmnt:
-                CIN multi_rshift  { $$=$2; };
-        
-    
-    output_stmnt:
-                COUT multi_lshift {
-                    debug_print("Creating output statement", NULL);
-                    $$ = $2;
-                    debug_print("Output statement created", $$);
-                }
-                ;
-    
-    
-    multi_rshift:
-                single_rshift multi_rshift  {                     
-                                            $1->next_input = $2;
-                                            $$ = $1; 
-                                            }
-            |                               { $$=NULL; };
-    
-    
-    multi_lshift:
-                single_lshift { // Base case for the recursion
-                    debug_print("multi_lshift: single_lshift base case", $1);
-                    $$ = (struct AST_Node_Output*)malloc(sizeof(struct AST_Node_Output));
-                    $$->output_op = $1; // $1 is an AST_Node_Operand from single_lshift
-                    $$->next_output = NULL;
-                }
-            |   single_lshift multi_lshift { // Recursive step
-                    debug_print("multi_lshift: single_lshift multi_lshift recursive step", $1);
-                    $$ = (struct AST_Node_Output*)malloc(sizeof(struct AST_Node_Output));
-                    $$->output_op = $1; // $1 is an AST_Node_Operand from single_lshift
-                    $$->next_output = $2; // $2 is the AST_Node_Output from the recursive call
-                }
-                ;
-
-
-    single_rshift:
-                RSHIFT ID               {
-                                        $$ = (struct AST_Node_Input*)malloc(sizeof(struct AST_Node_Input));
-                                        $$->input_op = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                        struct Symbol *s = find_symbol($2, local_table);
-                                        if(s == NULL) { $$->input_op->val_type = DATA_TYPE_NONE; }
-                                        else    
-                                            {
-                                        $$->input_op->value.val = $2;
-                                        $$->input_op->val_type = s->data_type;
-                                        $$->input_op->operand_type = CONTENT_TYPE_ID;
-                                            }
-                                        };
-    
-    
-    single_lshift:
-                LSHIFT content  {
-                    $$ = $2;
-                }
-                ;
-
-
-    multi_fun_param:
-                fun_param                          {
-                                                    $1->next_param = NULL;
-                                                    $$ = $1;
-                                                    }
-            |   fun_param COMMA  multi_fun_param    {
-                                                    $1->next_param = $3;
-                                                    $$ = $1;
-                                                    };
-
-
-    fun_param:
-                types ID        { 
-                                $$ = (struct AST_Node_Params*)malloc(sizeof(struct AST_Node_Params));
-                                $$->decl_param = (struct AST_Node_Init*)malloc(sizeof(struct AST_Node_Init));
-                                $$->decl_param->data_type = $1;
-                                $$->decl_param->assign = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                                $$->decl_param->assign->val_type = $1;
-                                $$->decl_param->assign->var = $2;
-                                $$->decl_param->assign->a_val.val = NULL;
-                                $$->decl_param->assign->a_type = CONTENT_TYPE_ID;
-                                }
-            |   content         { 
-                                $$ = (struct AST_Node_Params*)malloc(sizeof(struct AST_Node_Params));
-                                //$$->call_param = malloc(sizeof(struct AST_Node_Operand));
-                                $$->call_param = $1;
-                                //$$->call_param->val_type = $1->val_type;
-                                };
-                                        
-
-    initialization:
-                types ID        {
-                                $$ = (struct AST_Node_Init*)malloc(sizeof(struct AST_Node_Init));
-                                $$->data_type = $1;
-                                $$->next_init = NULL;
-                                $$->assign = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                                $$->assign->val_type = $1;
-                                $$->assign->var = $2;
-                                $$->assign->a_val.val = NULL;
-                                $$->assign->a_type = CONTENT_TYPE_ID;
-                                };
-
-
-    assignment:
-                ID EQ ID            { 
-                                    $$ = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                                    $$->var = $1;
-                                    $$->a_val.val = $3;
-                                    $$->a_type = CONTENT_TYPE_ID;
-                                    struct Symbol *s = find_symbol($3, local_table);
-                                    if (s==NULL) { $$->val_type = DATA_TYPE_NONE; }
-                                    else { $$-> val_type = s->data_type; }
-                                    }
-           |  types ID EQ content   { 
-                                    struct Symbol *s = NULL;
-                                    s = find_symbol($2, local_table);
-                                    if (s == NULL)  
-                                        { s = add_symbol($2, local_table, SYMBOL_VARIABLE, $1, $1, false, NULL, false, yylineno, $4->value); }
-                                    else { printf("\n\n\t***Error: Variable %s already declared, value is %s***\n\t***Line: %d***\n\n\n",$2,s->value_sym.val,yylineno); n_error++;}
-                                    if(($1 != $4->val_type))
-                                        { printf("\n\n\t***Error: Cannot assign type %s to type %s***\n\t***Line: %d***\n\n\n",type_to_str($4->val_type),type_to_str($1),yylineno); n_error++;}
-                                    else
-                                        {
-                                        $$ = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                                        $$->a_type = $4->operand_type;
-                                        $$->var = $2;
-                                        $$->a_val = $4->value;
-                                        $$->val_type = $1;
-                                        }
-                                    }
-           | ID EQ content          { 
-                                    $$ = (struct AST_Node_Assign*)malloc(sizeof(struct AST_Node_Assign));
-                                    $$->var = $1;
-                                    $$->a_val = $3->value;
-                                    $$->val_type = $3->val_type;
-                                    $$->a_type = $3->operand_type;
-                                    };
-
-
-    content:
-                ID              { 
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                struct Symbol *s = find_symtab($1, local_table);
-                                if(s==NULL) { $$->val_type = DATA_TYPE_NONE; }
-                                else 
-                                    {
-                                    $$->value.val = $1;
-                                    $$->val_type = s->data_type;
-                                    $$->operand_type = CONTENT_TYPE_ID;
-                                    }
-                                }
-            |   FLOAT_NUMBER    {
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                $$->value.val = $1;
-                                $$->val_type = DATA_TYPE_FLOAT;
-                                $$->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
-                                }
-            |   INT_NUMBER      {
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                $$->value.val = $1;
-                                $$->val_type = DATA_TYPE_INT;
-                                $$->operand_type = CONTENT_TYPE_INT_NUMBER;
-                                }
-            |   STRING_V        { 
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                $$->value.val = $1;
-                                $$->val_type = DATA_TYPE_STRING;
-                                $$->operand_type = CONTENT_TYPE_STRING;
-                                }
-            |   BOOL_V          { 
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                if (strcmp($1,"false")==0){$$->value.val = "False";}
-                                else if (strcmp($1,"true")==0){$$->value.val = "True";}
-                                $$->val_type = DATA_TYPE_BOOL;
-                                $$->operand_type = CONTENT_TYPE_BOOL;
-                                }
-            |   function_call   {
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                $$->value.funca = $1;
-                                $$->val_type = $1->return_type;
-                                $$->operand_type = CONTENT_TYPE_FUNCTION;
-                                }
-            |   expr            { 
-                                $$ = (struct AST_Node_Operand*)malloc(sizeof(struct AST_Node_Operand));
-                                $$->value.expr = $1;
-                                $$->val_type = $1->expr_type;
-                                $$->operand_type = CONTENT_TYPE_EXPRESSION;
-                                };
-
-
-    types:
-            FLOAT   { $$ = DATA_TYPE_FLOAT; }
-        |   INT     { $$ = DATA_TYPE_INT; }
-        |   STRING  { $$ = DATA_TYPE_STRING; }
-        |   BOOL    { $$ = DATA_TYPE_BOOL; };
-%%
-
-/****************** Functions *****************/ 
-
-int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        printf("Usage: %s input_file output_file\n", argv[0]);
-        return 1;
-    }
-
-    yyin = fopen(argv[1], "r");
-    if (yyin == NULL) {
-        printf("Error: Cannot open input file %s\n", argv[1]);
-        return 1;
-    }
-
-    fptr = fopen(argv[2], "w");
-    if (fptr == NULL) {
-        printf("Error: Cannot open output file %s\n", argv[2]);
-        fclose(yyin);
-        return 1;
-    }
-
-    yyparse();
-
-    if (n_error == 0) {
-        traverse(root);
-    }
-
-    // Clean up arrays before exiting
-    cleanup_arrays();
-
-    fclose(yyin);
-    fclose(fptr);
-    return 0;
-}
-
-int yyerror(char *s) {
-    fprintf(stderr, "Error: %s\n", s);
-    return 0;
-}
-
-/****************** Scope handling *****************/ 
-
-void scope_enter(){
-    local_table = new_symtab(indent_counter, local_table);
-    indent_counter++;
-}
-
-void scope_exit(){
-    delete_symtab(local_table);
-    indent_counter--;
-}
-
-/****************** Convert Data Type to String and viceversa *****************/ 
-
-char * type_to_str(int type) {
-    switch (type) {
-        case DATA_TYPE_STRING:
-            return strdup("string");
-        case DATA_TYPE_FLOAT:
-            return strdup("float");
-        case DATA_TYPE_INT:
-            return strdup("int");
-        case DATA_TYPE_BOOL:
-            return strdup("bool");
-        case DATA_TYPE_NONE:
-            return strdup("Type none");
-        default:
-            return strdup("Type not defined");
-    }
-}
-
-// Debug print function
-void debug_print(const char *msg, void *ptr) {
-    printf("[DEBUG] %s: %p\n", msg, ptr);
-}
-
-void debug_token(const char *token_name, const char *token_value) {
-    printf("[TOKEN] %s: '%s'\n", token_name, token_value);
-}
+%{
+/****************** Prologue *****************/ 
+    #define ALLOC_SUBSYSTEM ALLOC_AST
+	#include <math.h>
+	#include <stdio.h>
+	#include <ctype.h>
+    #include <string.h>
+	#include "symtab.h"
+    #include "ast.h" 
+    #include "translation.h"
+    #include "utils.h"
+    #include "prescan.h"
+    #include "members.h"
+    #include "astimage.h"
+    #include "stats.h"
+    #include "trace.h"
+    #include "passes.h"
+    #include <stdbool.h>
+
+    // Statement lists are right recursive, so the parser stack holds every statement of a block
+    // until the block ends; it is grown on the heap without bison's default limit of 10000
+    #define YYMAXDEPTH 100000000
+
+    int yylex (void);
+    int scan_token(void);
+    int yyerror(char *s);
+    int n_error = 0;
+    extern FILE *yyin;
+    // Pointer to file used for translation
+    FILE *fptr;
+    // Whole input text and its pre-scan (line index, comment/string/directive regions)
+    char *source_text = NULL;
+    struct Prescan *source_scan = NULL;
+
+/****************** Initialization of structs, counters and variables*****************/ 
+    struct AST_Node_Statements  *root;
+    struct SymTab *local_table  = NULL; 
+    // Every class, object and function declared; looked up by name through the symbol table
+    struct AST_Node_Class       **class_array           = NULL;
+    struct AST_Node_Object      **object_array          = NULL;
+    struct AST_Node_FunctionDef **function_array        = NULL;
+    int class_counter = 0;
+    int object_counter = 0;
+    int function_counter = 0;
+    int class_capacity = 0;
+    int object_capacity = 0;
+    int function_capacity = 0;
+    // Append node to one of the arrays above, doubling it when full
+    #define REGISTER(array, counter, capacity, node)                                          \
+        do {                                                                                  \
+            if ((counter) == (capacity)) {                                                    \
+                int grown = (capacity) ? (capacity) * 2 : 64;                                 \
+                void *p = REALLOC((array), grown * sizeof(*(array)));                         \
+                if (p == NULL) {                                                              \
+                    fprintf(stderr, "Error: Failed to allocate memory for " #array "\n");     \
+                    exit(1);                                                                  \
+                }                                                                             \
+                (array) = p;                                                                  \
+                (capacity) = grown;                                                           \
+            }                                                                                 \
+            (array)[(counter)++] = (node);                                                    \
+        } while (0)
+    bool found = false;
+    bool in_class = false;
+    // This is a helper function to distinguish class methods from regular functions
+    bool is_inside_class = false;
+    // Member index of the class being parsed, handed to its AST_Node_Class when the class is reduced
+    struct Member_Index *class_members = NULL;
+    // Parameters of the function being defined, declared by scope_open in the scope of its body
+    struct AST_Node_Params *body_params = NULL;
+    size_t body_params_offset = 0;
+
+    // Add cleanup function
+    void cleanup_arrays() {
+        for (int i = 0; i < class_counter; i++) {
+            if (class_array[i] != NULL) {
+                delete_member_index(&class_array[i]->members);
+                FREE(class_array[i]);
+                class_array[i] = NULL;
+            }
+        }
+        for (int i = 0; i < object_counter; i++) {
+            if (object_array[i] != NULL) {
+                FREE(object_array[i]);
+                object_array[i] = NULL;
+            }
+        }
+        for (int i = 0; i < function_counter; i++) {
+            if (function_array[i] != NULL) {
+                FREE(function_array[i]);
+                function_array[i] = NULL;
+            }
+        }
+        FREE(class_array);
+        FREE(object_array);
+        FREE(function_array);
+        class_array = NULL;
+        object_array = NULL;
+        function_array = NULL;
+        class_counter = class_capacity = 0;
+        object_counter = object_capacity = 0;
+        function_counter = function_capacity = 0;
+    }
+
+/****************** functions declaration *****************/ 
+    struct AST_Node_Object *access_object(char *obj_name, size_t offset);
+    int translate_ast_image(const char *image_path, const char *output_path);
+    int translate_source(const char *emit_ast);
+    void release_translation(void);
+    void scanner_reset(void);
+    bool report_stats(bool time_report, const char *stats_json, const char *input_path);
+    struct Symbol *check_function_call(struct AST_Node_FunctionCall *func_call, size_t offset);
+    char * type_to_str(int type);
+    void scope_enter();
+    void scope_exit();
+    void declare_params(struct AST_Node_Params *params, size_t offset);
+    void declare_function(struct AST_Node_FunctionDef *def, size_t offset);
+    struct AST_Node_Assign *step_assign(char *var, OP_TYPE op, long amount);
+    
+%}
+
+    //%define parse.error verbose
+    //%debug
+
+/****************** locations *****************/ 
+    // Tokens only carry byte offsets into the source; lines are looked up when a diagnostic needs one
+    %code requires {
+        #include <stddef.h>
+        typedef struct YYLTYPE {
+            size_t first_offset;
+            size_t last_offset;
+        } YYLTYPE;
+        #define YYLTYPE_IS_DECLARED 1
+        #define YYLLOC_DEFAULT(Current, Rhs, N)                                   \
+            do {                                                                  \
+                if (N) {                                                          \
+                    (Current).first_offset = YYRHSLOC(Rhs, 1).first_offset;       \
+                    (Current).last_offset  = YYRHSLOC(Rhs, N).last_offset;        \
+                } else {                                                          \
+                    (Current).first_offset = (Current).last_offset =              \
+                        YYRHSLOC(Rhs, 0).last_offset;                             \
+                }                                                                 \
+            } while (0)
+    }
+    %locations
+
+    %token SEMICOLON
+	%token IF 
+	%token ELSE
+	%token ID
+	%token INT_NUMBER   
+	%token FLOAT_NUMBER
+    %token INT
+	%token FLOAT
+	%token STRING
+	%token BOOL
+    %token LPAR
+    %token RPAR
+    %token LBRACE
+    %token RBRACE
+    %token COLON
+    %token COMMA
+    %token DOT
+    %token BRACKETS
+	%token RETURN
+	%token COUT
+	%token CIN
+	%token STRING_V
+    %token BOOL_V
+	%token FOR
+    %token FUNCTION
+    %token CLASS
+    %token MAIN
+    %token PRIVATE
+    %token PUBLIC
+    %token UNKNOWN
+    %token EQ AND OR ADD SUB MUL DIV GT LT GE LE EEQ NE INC DEC
+    %token LSHIFT RSHIFT
+ 
+/****************** types *****************/ 
+    %define api.value.type {union yystype}
+
+    %type <string>          ID STRING FLOAT INT BOOL LPAR RPAR LBRACE RBRACE COLON SEMICOLON COMMA DOT BRACKETS RETURN COUT CIN STRING_V FOR FUNCTION CLASS UNKNOWN MAIN PRIVATE PUBLIC EQ INC DEC
+    %type <int_value>       INT_NUMBER
+    %type <float_value>     FLOAT_NUMBER
+    %type <bool_value>      BOOL_V
+    %type <op>              AND OR ADD SUB MUL DIV GT LT GE LE EEQ NE
+    %type <statements>      statements body program sections section
+    %type <instruction>    statement
+    %type <functionCall>    function_call
+    %type <functionDef>     function_def
+    %type <params>          multi_fun_param fun_param  
+    %type <ifNode>          if_statement
+    %type <expression>      if_condition expr math_expr logic_expr rel_expr 
+    %type <elseIfNode>      else_if_statement
+    %type <elseNode>        else_statement
+    %type <forNode>         for_loop
+    %type <inputNode>       single_rshift multi_rshift input_stmnt
+    %type <outputNode>      multi_lshift output_stmnt
+    %type <assign>          assignment for_step
+    %type <init>            initialization 
+    %type <operand>         content single_lshift
+    %type <FBodyNode>       func_body
+    %type <classNode>       create_class create_class_child
+    %type <CBodyNode>       class_body
+    %type <objectNode>      create_object access_class
+    %type <data_type> types
+
+/****************** precedence *****************/ 
+    // C++ operator precedence, loosest first: the expression rules are flat, so without it
+    // every conflict was resolved by shifting and a - b - c was grouped as a - (b - c)
+    %left OR
+    %left AND
+    %left EEQ NE
+    %left GT LT GE LE
+    %left ADD SUB
+    %left MUL DIV
+
+    %start program
+%%  
+
+    program:   { 
+        debug_print("Entering program rule", NULL);
+        scope_enter(); 
+    }    statements    { 
+        debug_print("Creating program node", NULL);
+        root = (struct AST_Node_Statements*)$2; 
+        scope_exit(); 
+        debug_print("Program node created", NULL);
+    };
+
+
+    statements:
+            /* empty */
+            { $$ = NULL; }
+        |   statement statements
+            {
+                debug_print("Appending statement to statements", NULL);
+                struct AST_Node_Statements *node = (struct AST_Node_Statements*)MALLOC(sizeof(struct AST_Node_Statements));
+                node->left = $1;
+                node->right = $2;
+                $$ = node;
+                debug_print("Statement appended", $$);
+            }
+        ;
+
+
+    statement:
+            function_def 
+            { 
+                debug_print("Creating statement from function_def", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = FUNC_DEF_NODE;
+                $$->value.functionDef = $1;
+                debug_print("Function statement created", $$);
+            }
+            // Parse short-form function declaration inside a class
+            | types ID LPAR RPAR LBRACE ID EQ ID SEMICOLON COUT LSHIFT STRING_V LSHIFT ID SEMICOLON RETURN ID SEMICOLON RBRACE
+            {
+                if (is_inside_class) {
+                    debug_print("Creating class method with inline body", NULL);
+                    $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                    $$->n_type = FUNC_DEF_NODE;
+                    
+                    // Create the function def
+                    struct AST_Node_FunctionDef *func_def = MALLOC(sizeof(struct AST_Node_FunctionDef));
+                    func_def->func_name = $2;
+                    func_def->params = NULL;
+                    func_def->return_type = $1;
+                    func_def->is_class_method = true;
+                    
+                    // Create function body manually
+                    struct AST_Node_FBody *f_body = MALLOC(sizeof(struct AST_Node_FBody));
+                    
+                    // Create statement for assignment
+                    struct AST_Node_Instruction *assign_instr = MALLOC(sizeof(struct AST_Node_Instruction));
+                    assign_instr->n_type = ASSIGN_NODE;
+                    struct AST_Node_Assign *assign = MALLOC(sizeof(struct AST_Node_Assign));
+                    assign->var = $6;
+                    assign->val_type = DATA_TYPE_INT;
+                    assign->a_val.val = $8;
+                    assign_instr->value.assign = assign;
+                    
+                    // Create statement for cout
+                    struct AST_Node_Instruction *cout_instr = MALLOC(sizeof(struct AST_Node_Instruction));
+                    cout_instr->n_type = OUTPUT_NODE;
+                    struct AST_Node_Output *output = MALLOC(sizeof(struct AST_Node_Output));
+                    struct AST_Node_Operand *cout_op = MALLOC(sizeof(struct AST_Node_Operand));
+                    cout_op->operand_type = CONTENT_TYPE_STRING;
+                    cout_op->val_type = DATA_TYPE_STRING;
+                    cout_op->value.val = $12;
+                    output->output_op = cout_op;
+                    cout_instr->value.outputNode = output;
+                    
+                    // Create statements structure
+                    struct AST_Node_Statements *stmt1 = MALLOC(sizeof(struct AST_Node_Statements));
+                    stmt1->left = assign_instr;
+                    struct AST_Node_Statements *stmt2 = MALLOC(sizeof(struct AST_Node_Statements));
+                    stmt2->left = cout_instr;
+                    stmt1->right = stmt2;
+                    
+                    f_body->func_body = stmt1;
+                    
+                    // Create return statement
+                    struct AST_Node_Operand *return_op = MALLOC(sizeof(struct AST_Node_Operand));
+                    return_op->operand_type = CONTENT_TYPE_ID;
+                    return_op->val_type = $1;
+                    return_op->value.val = $16;
+                    f_body->return_op = return_op;
+                    
+                    func_def->f_body = f_body;
+                    
+                    // Store in function array
+                    REGISTER(function_array, function_counter, function_capacity, func_def);
+                    
+                    $$->value.functionDef = func_def;
+                    
+                    // Add to symbol table
+                    struct Symbol *s = add_function(func_def->func_name, local_table, func_def->return_type, 0, 0, func_def, @2.first_offset);
+                    if (s != NULL) {
+                        if (s->overload > 0) {
+                            func_def->func_name = STRDUP(s->py_name);
+                        }
+                        debug_print("Class method symbol added", s);
+                    } else {
+                        printf("\n\n\t***Error: %s already declared***\n\t***Line: %d***\n\n\n", func_def->func_name, source_line(@2.first_offset));
+                        n_error++;
+                    }
+                } else {
+                    printf("\n\n\t***Error: Inline function declaration only allowed inside class***\n\t***Line: %d***\n\n\n", source_line(@1.first_offset));
+                    n_error++;
+                }
+            }
+        |   RETURN content SEMICOLON
+            {
+                debug_print("Creating statement from return content", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = RETURN_NODE;
+                struct AST_Node_Return *return_node = (struct AST_Node_Return*)MALLOC(sizeof(struct AST_Node_Return));
+                struct AST_Node *operand_node = (struct AST_Node *)MALLOC(sizeof(struct AST_Node));
+                operand_node->n_type = OPERAND_NODE;
+                operand_node->value = $2;
+                return_node->value = operand_node;
+                $$->value.returnNode = return_node;
+                debug_print("Return content statement created", $$);
+            }
+        |   RETURN expr SEMICOLON
+            {
+                debug_print("Creating statement from return expression", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = RETURN_NODE;
+                struct AST_Node_Return *return_node = (struct AST_Node_Return*)MALLOC(sizeof(struct AST_Node_Return));
+                
+                // Create an operand for the expression
+                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                expr_operand->value.expr = $2;
+                expr_operand->val_type = $2->expr_type;
+                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
+                
+                struct AST_Node *operand_node = (struct AST_Node *)MALLOC(sizeof(struct AST_Node));
+                operand_node->n_type = OPERAND_NODE;
+                operand_node->value = expr_operand;
+                
+                return_node->value = operand_node;
+                $$->value.returnNode = return_node;
+                debug_print("Return expression statement created", $$);
+            }
+        |   if_statement 
+            {
+                debug_print("Creating statement from if_statement", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = IF_NODE;
+                $$->value.ifNode = $1;
+                debug_print("If statement created", $$);
+            }
+        |   for_loop 
+            {
+                debug_print("Creating statement from for_loop", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = FOR_NODE;
+                $$->value.forNode = $1;
+                debug_print("For loop created", $$);
+            }
+        |   ID INC SEMICOLON
+            {
+                debug_print("Creating increment statement", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = ASSIGN_NODE;
+                struct AST_Node_Assign *assign = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                assign->var = $1;
+                assign->val_type = DATA_TYPE_INT;
+                assign->a_type = CONTENT_TYPE_EXPRESSION;
+                
+                struct AST_Node_Expression *expr = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                expr->op = OP_ADD;
+                
+                struct AST_Node_Operand *left = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                left->operand_type = CONTENT_TYPE_ID;
+                left->value.val = $1;
+                left->val_type = DATA_TYPE_INT;
+                expr->left_op = left;
+                
+                struct AST_Node_Operand *right = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                right->operand_type = CONTENT_TYPE_INT_NUMBER;
+                right->value.ival = 1;
+                right->val_type = DATA_TYPE_INT;
+                expr->right_op = right;
+                
+                expr->expr_type = DATA_TYPE_INT;
+                assign->a_val.expr = expr;
+                $$->value.assign = assign;
+            }
+        |   ID DEC SEMICOLON
+            {
+                debug_print("Creating decrement statement", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = ASSIGN_NODE;
+                struct AST_Node_Assign *assign = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                assign->var = $1;
+                assign->val_type = DATA_TYPE_INT;
+                assign->a_type = CONTENT_TYPE_EXPRESSION;
+                
+                struct AST_Node_Expression *expr = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                expr->op = OP_SUB;
+                
+                struct AST_Node_Operand *left = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                left->operand_type = CONTENT_TYPE_ID;
+                left->value.val = $1;
+                left->val_type = DATA_TYPE_INT;
+                expr->left_op = left;
+                
+                struct AST_Node_Operand *right = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                right->operand_type = CONTENT_TYPE_INT_NUMBER;
+                right->value.ival = 1;
+                right->val_type = DATA_TYPE_INT;
+                expr->right_op = right;
+                
+                expr->expr_type = DATA_TYPE_INT;
+                assign->a_val.expr = expr;
+                $$->value.assign = assign;
+            }
+        |   assignment SEMICOLON 
+            {
+                debug_print("Creating statement from assignment", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = ASSIGN_NODE;
+                struct Symbol *s = find_symbol($1->var, local_table);
+                if (s == NULL) {
+                    printf("\n\n\t***Error: Variable '%s' not declared***\n\t***Line: %d***\n\n\n", $1->var, source_line(@1.first_offset));
+                    n_error++;
+                } else if (s->data_type != $1->val_type) {
+                    printf("\n\n\t***Error: Variable '%s' has been declared as a '%s' but type '%s' is assigned***\n\t***Line: %d***\n\n\n", 
+                        $1->var, type_to_str(s->data_type), type_to_str($1->val_type), source_line(@1.first_offset));
+                    n_error++;
+                } else {
+                    $$->value.assign = $1;
+                    s->value_sym = $1->a_val;
+                    debug_print("Assignment statement created", $$);
+                }
+            }
+        |   initialization SEMICOLON 
+            {
+                debug_print("Creating statement from initialization", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = INIT_NODE;
+                $$->value.init = $1;
+                struct Symbol *s = NULL;
+                for(struct AST_Node_Init *init = $1; init != NULL; init = init->next_init) {
+                    s = find_symbol(init->assign->var, local_table);
+                    if (s == NULL) {
+                        s = add_symbol(init->assign->var, local_table, SYMBOL_VARIABLE, $1->data_type, DATA_TYPE_NONE, false, NULL, false, @1.first_offset, null_value);
+                        debug_print("Variable symbol added", s);
+                    } else {
+                        printf("\n\n\t***Error: Variable %s already declared***\n\t***Line: %d***\n\n\n", init->assign->var, source_line(@1.first_offset));
+                        n_error++;
+                    }
+                }
+                debug_print("Initialization statement created", $$);
+            }
+        |   output_stmnt SEMICOLON {
+            debug_print("Creating statement from output", NULL);
+            $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+            $$->n_type = OUTPUT_NODE;
+            $$->value.outputNode = $1;
+            debug_print("Output statement created", $$);
+        }
+        |   create_class
+            { 
+                debug_print("Creating statement from class definition", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = CLASS_NODE;
+                $$->value.classNode = $1;
+                debug_print("Class statement created", $$);
+            }
+        |   create_class_child
+            { 
+                debug_print("Creating statement from class inheritance definition", NULL);
+                $$ = (struct AST_Node_Instruction*)MALLOC(sizeof(struct AST_Node_Instruction));
+                $$->n_type = CLASS_CHILD_NODE;
+                $$->value.classNode = $1;
+                debug_print("Class inheritance statement created", $$);
+            }
+        ;
+
+    
+    function_call:
+                ID LPAR multi_fun_param RPAR    { 
+                                                $$ = (struct AST_Node_FunctionCall*)MALLOC(sizeof(struct AST_Node_FunctionCall));
+                                                struct Symbol *s = find_symtab($1, local_table);
+                                                if (s!=NULL) 
+                                                    {
+                                                    if (s->is_function) {
+                                                        $$->func_name = $1;
+                                                        $$->return_type = s->ret_type;
+                                                        $$->params = $3;
+                                                        /* Resolve the overload and check the parameters against its signature */
+                                                        struct Symbol *f = check_function_call($$, @1.first_offset);
+                                                        if (f != NULL) { $$->return_type = f->ret_type; }
+                                                        }
+                                                    else {
+                                                        printf("\n\n\t***Error: %s is not a function***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset));n_error++;
+                                                        }
+                                                    }
+                                                else { printf("\n\n\t***Error: %s is not declared***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset)); n_error++;}
+                                                }
+            |   ID LPAR RPAR                   { 
+                                                $$ = (struct AST_Node_FunctionCall*)MALLOC(sizeof(struct AST_Node_FunctionCall));
+                                                struct Symbol *s = find_symtab($1, local_table);
+                                                if (s!=NULL) 
+                                                    {
+                                                    if (s->is_function) {
+                                                        $$->func_name = $1;
+                                                        $$->return_type = s->ret_type;
+                                                        $$->params = NULL;
+                                                        /* Resolve the overload and check the parameters against its signature */
+                                                        struct Symbol *f = check_function_call($$, @1.first_offset);
+                                                        if (f != NULL) { $$->return_type = f->ret_type; }
+                                                        }
+                                                    else {
+                                                        printf("\n\n\t***Error: %s is not a function***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset));n_error++;
+                                                        }
+                                                    }
+                                                else { printf("\n\n\t***Error: %s is not declared***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset)); n_error++;}
+                                                };
+
+
+    function_def:
+                types ID LPAR multi_fun_param RPAR LBRACE
+                                        {
+                    // declared ahead of its body, which may call it
+                    $<functionDef>$ = (struct AST_Node_FunctionDef*)MALLOC(sizeof(struct AST_Node_FunctionDef));
+                    $<functionDef>$->func_name = $2;
+                    $<functionDef>$->params = $4;
+                    $<functionDef>$->f_body = NULL;
+                    $<functionDef>$->return_type = $1;
+                    $<functionDef>$->is_class_method = is_inside_class;  // Flag if this is a class method
+                    declare_function($<functionDef>$, @2.first_offset);
+                    body_params = $4;
+                    body_params_offset = @4.first_offset;
+                                        }
+                func_body RBRACE 
+                                        {
+                    $$ = $<functionDef>7;
+                    $$->f_body = $8;
+                    
+                    // Check return type only if a return value exists
+                    if ($$->f_body && $$->f_body->return_op) {
+                        if ($1 != $$->f_body->return_op->val_type) {
+                            printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
+                                $2, type_to_str($1), type_to_str($$->f_body->return_op->val_type));
+                            n_error++;
+                        }
+                    }
+                    
+                    // add function to function array
+                    REGISTER(function_array, function_counter, function_capacity, $$);
+                    printf("[DEBUG] Defined function %s with return type %s\n", $$->func_name, type_to_str($$->return_type));
+                                        }
+            | types ID LPAR RPAR LBRACE
+                                        {
+                                        $<functionDef>$ = (struct AST_Node_FunctionDef*)MALLOC(sizeof(struct AST_Node_FunctionDef));
+                                        $<functionDef>$->func_name = $2;
+                                        $<functionDef>$->params = NULL;
+                                        $<functionDef>$->f_body = NULL;
+                                        $<functionDef>$->return_type = $1;
+                                        $<functionDef>$->is_class_method = is_inside_class;  // Flag if this is a class method
+                                        declare_function($<functionDef>$, @2.first_offset);
+                                        }
+                func_body RBRACE 
+                                        {
+                                        $$ = $<functionDef>6;
+                                        $$->f_body = $7;
+                                        
+                                        // Check return type only if a return value exists
+                                        if ($$->f_body && $$->f_body->return_op) {
+                                            if ($1 != $$->f_body->return_op->val_type) {
+                                                printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
+                                                    $2, type_to_str($1), type_to_str($$->f_body->return_op->val_type));
+                                                n_error++;
+                                            }
+                                        }
+                                        
+                                        // add function to function array
+                                        REGISTER(function_array, function_counter, function_capacity, $$);
+                                        printf("[DEBUG] Defined function %s with return type %s\n", $$->func_name, type_to_str($$->return_type));
+                                        }
+            | INT MAIN LPAR RPAR func_body            {     
+                                                        printf("[DEBUG] Matched main function\n");
+                                                        $$ = (struct AST_Node_FunctionDef*)MALLOC(sizeof(struct AST_Node_FunctionDef));
+                                                        $$->func_name = "main";
+                                                        $$->params = NULL;
+                                                        $$->return_type = DATA_TYPE_INT;
+                                                        $$->f_body = $5;
+                                                        $$->is_class_method = false;
+                                                        declare_function($$, @1.first_offset);
+                                                        }
+            | initialization LPAR RPAR func_body      {
+                                                        $$ = (struct AST_Node_FunctionDef*)MALLOC(sizeof(struct AST_Node_FunctionDef));
+                                                        $$->func_name = $1->assign->var;
+                                                        $$->params = NULL;
+                                                        $$->f_body = $4;
+                                                        $$->is_class_method = is_inside_class;
+                                                        // check if return data type and function data type match
+                                                        if ($1->data_type !=  $$->f_body->return_op->val_type)
+                                                            {
+                                                            printf("\n\n\t***Error: Function %s has been declared as a '%s' but type '%s' is returned ***\n\n\n", 
+                                                            $$->func_name, type_to_str($1->data_type), type_to_str($$->f_body->return_op->val_type));n_error++;
+                                                            }
+                                                        $$->return_type = $1->data_type;
+                                                        declare_function($$, @1.first_offset);
+                                                        // add function to function array; 
+                                                        REGISTER(function_array, function_counter, function_capacity, $$);
+                                                    }
+
+
+
+    create_object:
+                ID ID       { /*check if $1 exists */
+                            struct Symbol *s = find_symtab($1, local_table);
+                            if (s!=NULL) 
+                                {
+                                if (s->is_class) 
+                                    {
+                                    struct Symbol *s2 = find_symtab($2, local_table);
+                                    if (s2==NULL) 
+                                        {
+                                        $$ = (struct AST_Node_Object*)MALLOC(sizeof(struct AST_Node_Object));
+                                        $$->obj_class = (struct AST_Node_Class*)MALLOC(sizeof(struct AST_Node_Class));
+                                        struct AST_Node_Class *c = find_class($1, local_table);
+                                        if (c != NULL)
+                                            { 
+                                            $$->obj_class = c;
+                                            $$->obj_name = $2;
+                                            REGISTER(object_array, object_counter, object_capacity, $$);
+                                            register_object($2, $$, local_table);
+                                            }
+                                        }
+                                    else { printf("\n\n\t***Error: object %s already exists***\n\t***Line: %d***\n\n\n",$2,source_line(@2.first_offset)); n_error++;}
+                                    }
+                                else { printf("\n\n\t***Error: %s is not a class***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset)); n_error++;}
+                                }
+                            else { printf("\n\n\t***Error: class %s is not declared***\n\t***Line: %d***\n\n\n",$1,source_line(@1.first_offset)); n_error++;}
+                            };
+                                      
+
+ access_class:
+                ID DOT ID               {
+                                        $$ = access_object($1, @1.first_offset);
+                                        struct Class_Member *m = ($$->obj_class != NULL) ? find_member($$->obj_class->members, $3) : NULL;
+                                        if (m != NULL && m->is_public)
+                                            {
+                                            $$->access_value.val = $3;
+                                            $$->access_type = ACCESS_TYPE_VAR;
+                                            }
+                                        else if ($$->obj_class != NULL) {printf("\n\n\t***Error: %s not found in class %s***\n\t***Line: %d***\n\n\n",$3,$$->obj_class->class_name,source_line(@3.first_offset));n_error++;}
+                                        }
+        |       ID DOT function_call    {
+                                        $$ = access_object($1, @1.first_offset);
+                                        struct Class_Member *m = ($$->obj_class != NULL) ? find_member($$->obj_class->members, $3->func_name) : NULL;
+                                        if (m != NULL && m->is_public)
+                                            {
+                                            $$->access_value.funca = $3;
+                                            $$->access_type = ACCESS_TYPE_FUNCTION;
+                                            }
+                                        else if ($$->obj_class != NULL) {printf("\n\n\t***Error: %s not found in class %s***\n\t***Line: %d***\n\n\n",$3->func_name,$$->obj_class->class_name,source_line(@3.first_offset));n_error++;}
+                                        }
+        |       ID DOT assignment       {
+                                        $$ = access_object($1, @1.first_offset);
+                                        struct Class_Member *m = ($$->obj_class != NULL) ? find_member($$->obj_class->members, $3->var) : NULL;
+                                        if (m != NULL && m->is_public)
+                                            {
+                                            $$->access_value.ass_val = $3;
+                                            $$->access_type = ACCESS_TYPE_ASSIGN;
+                                            }
+                                        else if ($$->obj_class != NULL) {printf("\n\n\t***Error: %s not found in class %s***\n\t***Line: %d***\n\n\n",$3->var,$$->obj_class->class_name,source_line(@3.first_offset));n_error++;}
+                                        };
+
+
+    create_class:
+                CLASS ID                {in_class = true; class_members = new_member_index();}
+                class_body              {
+                                        $$ = (struct AST_Node_Class*)MALLOC(sizeof(struct AST_Node_Class));
+                                        $$->class_name = $2;
+                                        $$->c_body = $4;
+                                        $$->parent_class = NULL;
+                                        $$->parent_class_public = NULL;
+                                        $$->members = class_members;
+                                        class_members = NULL;
+                                        REGISTER(class_array, class_counter, class_capacity, $$);
+                                        register_class($2, $$, local_table);
+                                        in_class = false;
+                                        };
+
+
+    create_class_child:
+                CLASS ID                       {in_class = true; class_members = new_member_index();}
+                COLON PUBLIC ID class_body     {
+                                                        $$ = (struct AST_Node_Class*)MALLOC(sizeof(struct AST_Node_Class));
+                                                        $$->parent_class_public = (struct AST_Node_Parent_Public*)MALLOC(sizeof(struct AST_Node_Parent_Public));
+                                                        $$->parent_class_public->parent_pub_body = NULL;
+                                                        $$->parent_class_public->next_parent_public = NULL;
+                                                        $$->parent_class = NULL;
+                                                        $$->class_name = $2;
+                                                        $$->c_body = $7;
+                                                        $$->members = class_members;
+                                                        class_members = NULL;
+                                                        struct AST_Node_Class *parent = find_class($6, local_table);
+                                                        if (parent != NULL)
+                                                            {
+                                                            $$->parent_class = parent;
+                                                            $$->parent_class_public->parent_pub_body = parent->c_body->pub_body;
+                                                            $$->parent_class_public->next_parent_public = parent->parent_class_public;
+                                                            // inherited members are indexed once here, the parent index already holds its own ancestors
+                                                            member_index_inherit($$->members, parent->members);
+                                                            REGISTER(class_array, class_counter, class_capacity, $$);
+                                                            register_class($2, $$, local_table);
+                                                            }
+                                                        else {printf("\n\n\n\t\t***ERROR: class parent %s not found***\n\n\n",$6); n_error++;}
+                                                        in_class = false;
+
+                                                        };
+
+
+    class_body:
+                LBRACE { is_inside_class = true; } sections RBRACE 
+                    {
+                    $$ = (struct AST_Node_CBody*)MALLOC(sizeof(struct AST_Node_CBody));
+                    $$->pri_body = NULL;
+                    $$->pub_body = NULL;
+                    is_inside_class = false;
+                    debug_print("Class body created", $$);
+                    };
+
+
+    sections:
+                section
+            |   sections section
+            ;
+
+    section:
+                PUBLIC COLON statements 
+                    { 
+                    $$ = $3; 
+                    member_index_add_section(class_members, $3, true);
+                    debug_print("Public section processed", $$); 
+                    }
+            |   PRIVATE COLON statements 
+                    { 
+                    $$ = $3;
+                    member_index_add_section(class_members, $3, false);
+                    debug_print("Private section processed", $$);
+                    }
+            ;
+
+
+    if_statement:
+                IF LPAR if_condition RPAR body else_if_statement else_statement
+                                                        { 
+                                                        $$ = (struct AST_Node_If*)MALLOC(sizeof(struct AST_Node_If));
+                                                        $$->condition = $3;
+                                                        $$->if_body = $5;
+                                                        $$->else_if = $6;
+                                                        $$->else_body = $7;
+                                                        }
+                | IF LPAR if_condition RPAR body ELSE body
+                                                        { 
+                                                        $$ = (struct AST_Node_If*)MALLOC(sizeof(struct AST_Node_If));
+                                                        $$->condition = $3;
+                                                        $$->if_body = $5;
+                                                        $$->else_if = NULL;
+                                                        struct AST_Node_Else *else_node = (struct AST_Node_Else*)MALLOC(sizeof(struct AST_Node_Else));
+                                                        else_node->else_body = $7;
+                                                        $$->else_body = else_node;
+                                                        }
+                | IF LPAR if_condition RPAR body
+                                                        { 
+                                                        $$ = (struct AST_Node_If*)MALLOC(sizeof(struct AST_Node_If));
+                                                        $$->condition = $3;
+                                                        $$->if_body = $5;
+                                                        $$->else_if = NULL;
+                                                        $$->else_body = NULL;
+                                                        };
+
+
+    if_condition:
+                expr                            {
+                                                if($1->expr_type != DATA_TYPE_BOOL) { printf("\n\n\t***Error: IF condition must be boolean type***\n\t***Line: %d***\n\n\n",source_line(@1.first_offset)); n_error++;}
+                                                else { $$ = $1; }
+                                                };
+    
+
+    else_if_statement:
+                ELSE IF LPAR if_condition RPAR body {
+                                                    $$ = (struct AST_Node_Else_If*)MALLOC(sizeof(struct AST_Node_Else_If));
+                                                    $$->condition = $4;
+                                                    $$->elif_body = $6;
+                                                    }
+                | /* empty */ { $$ = NULL; };
+    
+    
+    else_statement:
+                ELSE body                       {
+                                                $$ = (struct AST_Node_Else*)MALLOC(sizeof(struct AST_Node_Else));
+                                                $$->else_body = $2;
+                                                }
+                | /* empty */ { $$ = NULL; };
+
+
+    for_loop:
+                FOR LPAR assignment SEMICOLON rel_expr SEMICOLON for_step RPAR body   {
+                                                                                        $$ = (struct AST_Node_For*)MALLOC(sizeof(struct AST_Node_For));
+                                                                                        $$->init = $3;
+                                                                                        $$->condition = share_expression($5);
+                                                                                        $$->increment = $7;
+                                                                                        $$->for_body = $9;
+                                                                                        delete_symbol( find_symbol($3->var,local_table), local_table);
+                                                                                        };
+
+
+    // x++, x--, x += 2 and x -= 2 are kept as x = x + 1, ... like the statements of that form
+    for_step:
+                assignment                      { $$ = $1; }
+            |   ID INC                          { $$ = step_assign($1, OP_ADD, 1); }
+            |   ID DEC                          { $$ = step_assign($1, OP_SUB, 1); }
+            |   ID ADD EQ INT_NUMBER            { $$ = step_assign($1, OP_ADD, $4); }
+            |   ID SUB EQ INT_NUMBER            { $$ = step_assign($1, OP_SUB, $4); };
+
+
+    body: 
+                LBRACE statements RBRACE          { $$ = $2; };
+
+    
+    func_body:
+          LBRACE scope_open statements RETURN content SEMICOLON RBRACE
+            {
+                printf("[DEBUG] Function body with statements and return\n");
+                $$ = (struct AST_Node_FBody*)MALLOC(sizeof(struct AST_Node_FBody));                                       
+                $$->func_body = $3;
+                $$->return_op = $5;
+                printf("[DEBUG] Return type: %d\n", $$->return_op->val_type);
+                scope_exit();
+            }
+        | LBRACE scope_open statements RETURN expr SEMICOLON RBRACE
+            {
+                printf("[DEBUG] Function body with statements and return expression\n");
+                $$ = (struct AST_Node_FBody*)MALLOC(sizeof(struct AST_Node_FBody));                                       
+                $$->func_body = $3;
+                
+                // Create an operand for the expression
+                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                expr_operand->value.expr = $5;
+                expr_operand->val_type = $5->expr_type;
+                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
+                
+                $$->return_op = expr_operand;
+                printf("[DEBUG] Return expression type: %d\n", $$->return_op->val_type);
+                scope_exit();
+            }
+        | LBRACE scope_open RETURN content SEMICOLON RBRACE
+            {
+                printf("[DEBUG] Function body with return only\n");
+                $$ = (struct AST_Node_FBody*)MALLOC(sizeof(struct AST_Node_FBody));
+                $$->func_body = NULL;
+                $$->return_op = $4;
+                printf("[DEBUG] Return type: %d\n", $$->return_op->val_type);
+                scope_exit();
+            }
+        | LBRACE scope_open RETURN expr SEMICOLON RBRACE
+            {
+                printf("[DEBUG] Function body with return expression only\n");
+                $$ = (struct AST_Node_FBody*)MALLOC(sizeof(struct AST_Node_FBody));
+                $$->func_body = NULL;
+                
+                // Create an operand for the expression
+                struct AST_Node_Operand *expr_operand = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                expr_operand->value.expr = $4;
+                expr_operand->val_type = $4->expr_type;
+                expr_operand->operand_type = CONTENT_TYPE_EXPRESSION;
+                
+                $$->return_op = expr_operand;
+                printf("[DEBUG] Return expression type: %d\n", $$->return_op->val_type);
+                scope_exit();
+            }
+        | LBRACE scope_open statements RBRACE
+            {
+                printf("[DEBUG] Function body with statements only (no return)\n");
+                $$ = (struct AST_Node_FBody*)MALLOC(sizeof(struct AST_Node_FBody));
+                $$->func_body = $3;
+                // For a function with no return, set a default return type
+                struct AST_Node_Operand *default_return = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                default_return->operand_type = CONTENT_TYPE_INT_NUMBER;
+                default_return->val_type = DATA_TYPE_INT;
+                default_return->value.ival = 0; // Default return 0
+                $$->return_op = default_return;
+                scope_exit();
+            }
+    ;
+
+
+    // Opens the scope of a block, closed again by the block's own action; the parameters of the
+    // function the block is the body of are declared there
+    scope_open:
+                /* empty */                     {
+                                                scope_enter();
+                                                declare_params(body_params, body_params_offset);
+                                                body_params = NULL;
+                                                };
+
+
+    expr:
+                math_expr
+                {
+                    $$ = share_expression(flatten_expression($1));
+                }
+            |   ID INC
+                {
+                    debug_print("Creating increment expression", NULL);
+                    struct AST_Node_Expression *node = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                    node->op = OP_ADD_ASSIGN;
+                    
+                    // Create left operand (variable)
+                    struct AST_Node_Operand *left = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                    left->operand_type = CONTENT_TYPE_ID;
+                    left->value.val = $1;
+                    left->val_type = DATA_TYPE_INT;
+                    node->left_op = share_operand(left);
+                    
+                    // Create right operand (constant 1)
+                    struct AST_Node_Operand *right = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                    right->operand_type = CONTENT_TYPE_INT_NUMBER;
+                    right->value.ival = 1;
+                    right->val_type = DATA_TYPE_INT;
+                    node->right_op = share_operand(right);
+                    
+                    node->expr_type = DATA_TYPE_INT;
+                    $$ = share_expression(node);
+                }
+            |   ID DEC
+                {
+                    debug_print("Creating decrement expression", NULL);
+                    struct AST_Node_Expression *node = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                    node->op = OP_SUB_ASSIGN;
+                    
+                    // Create left operand (variable)
+                    struct AST_Node_Operand *left = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                    left->operand_type = CONTENT_TYPE_ID;
+                    left->value.val = $1;
+                    left->val_type = DATA_TYPE_INT;
+                    node->left_op = share_operand(left);
+                    
+                    // Create right operand (constant 1)
+                    struct AST_Node_Operand *right = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                    right->operand_type = CONTENT_TYPE_INT_NUMBER;
+                    right->value.ival = 1;
+                    right->val_type = DATA_TYPE_INT;
+                    node->right_op = share_operand(right);
+                    
+                    node->expr_type = DATA_TYPE_INT;
+                    $$ = share_expression(node);
+                }
+            |   logic_expr              { $$ = share_expression(flatten_expression($1)); }
+            |   rel_expr                { $$ = share_expression($1); }
+            |                           { $$ = NULL; }
+            |   LPAR expr RPAR          { $$ = $2; };
+
+
+    math_expr:
+                content ADD content         {
+                                            $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                            // queste malloc permettono il riconoscimento della x
+                                            $$->left_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                            $$->right_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->op = $2;
+                                            $$->expr_type = $3->val_type;
+                                            if ($1->val_type != $3->val_type) 
+                                                { printf("\n\n\t***Error: Cannot add '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                                
+                                            else 
+                                                {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                                };
+                                            }
+            |   content SUB content         { 
+                                            $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                            $$->op = $2;
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = $1->val_type;
+                                            if ($1->val_type != $3->val_type) 
+                                                { printf("\n\n\t***Error: Cannot subtract '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                            else 
+                                                {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                                };
+                                            }
+            |   content MUL content         { 
+                                            $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                            // queste malloc permettono il riconoscimento della x
+                                            $$->left_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                            $$->right_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->op = $2;
+                                            if ($1->val_type != $3->val_type) 
+                                                { printf("\n\n\t***Error: Cannot multiply '%s' to '%s'***\n\t***Line: %d***\n\n\n",type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                            else 
+                                                {
+                                                $$->left_op = $1;
+                                                $$->right_op = $3;
+                                                $$->expr_type = $1->val_type;
+                                                }
+                                            }
+            |   content INT_NUMBER          {   
+                                            // This rule is used in case expression written as: int x = A -B and not as x = A - B
+                                            // check if the second token is a negative integer number
+                                            if ($2 < 0) 
+                                                {                                               
+
+                                                // Need to allocate operands in order to use the expression
+                                                struct AST_Node_Operand *S1, *S2;
+                                                S1 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S1->value = $1->value;
+                                                S1->val_type = DATA_TYPE_INT;
+                                                S1->operand_type = $1->operand_type;
+
+                                                S2 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S2->value.ival = -$2;
+                                                S2->val_type = DATA_TYPE_INT;
+                                                S2->operand_type = CONTENT_TYPE_INT_NUMBER;
+                                                
+                                                $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                                $$->op = OP_SUB;
+                                                $$->left_op = S1;
+                                                $$->right_op = S2;
+                                                $$->expr_type = DATA_TYPE_INT;
+                                            }
+                                            else { printf("\n\n\t***Error: Operation not allowed ***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset)); n_error++;}
+                                            }
+            |   INT_NUMBER INT_NUMBER       {   
+                                            // This rule is used in case expression written as: int x = A -B and not as x = A - B
+                                            // check if the second token is a negative integer number
+                                            if ($2 < 0) 
+                                                {                                               
+
+                                                // Need to allocate operands in order to use the expression
+                                                struct AST_Node_Operand *S1, *S2;
+                                                S1 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S1->value.ival = $1;
+                                                S1->val_type = DATA_TYPE_INT;
+                                                S1->operand_type = CONTENT_TYPE_INT_NUMBER;
+
+                                                S2 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S2->value.ival = -$2;
+                                                S2->val_type = DATA_TYPE_INT;
+                                                S2->operand_type = CONTENT_TYPE_INT_NUMBER;
+                                                
+                                                $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                                $$->op = OP_SUB;
+                                                $$->left_op = S1;
+                                                $$->right_op = S2;
+                                                $$->expr_type = DATA_TYPE_INT;
+                                            }
+                                            else { printf("\n\n\t***Error: Operation not allowed ***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset)); n_error++;}
+                                            }
+                                            
+            |   content FLOAT_NUMBER        {
+                                            //check if the second token is a negative float number
+                                            if ($2 < 0) 
+                                                {                                               
+                                                // Need to allocate operands in order to use the expression
+                                                struct AST_Node_Operand *S1, *S2;
+                                                S1 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S1->value = $1->value;
+                                                S1->val_type = DATA_TYPE_FLOAT;
+                                                S1->operand_type = $1->operand_type;
+
+                                                S2 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S2->value.dval = -$2;
+                                                S2->val_type = DATA_TYPE_FLOAT;
+                                                S2->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
+                                                
+                                                $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                                $$->op = OP_SUB;
+                                                $$->left_op = S1;
+                                                $$->right_op = S2;
+                                                $$->expr_type = DATA_TYPE_FLOAT;
+                                            }
+                                            else { printf("\n\n\t***Error: Operation not allowed***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset));n_error++; }
+                                            }
+            |   FLOAT_NUMBER FLOAT_NUMBER   {
+                                            //check if the second token is a negative float number
+                                            if ($2 < 0) 
+                                                {                                               
+                                                // Need to allocate operands in order to use the expression
+                                                struct AST_Node_Operand *S1, *S2;
+                                                S1 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S1->value.dval = $1;
+                                                S1->val_type = DATA_TYPE_FLOAT;
+                                                S1->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
+
+                                                S2 = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                                S2->value.dval = -$2;
+                                                S2->val_type = DATA_TYPE_FLOAT;
+                                                S2->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
+                                                
+                                                $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                                $$->op = OP_SUB;
+                                                $$->left_op = S1;
+                                                $$->right_op = S2;
+                                                $$->expr_type = DATA_TYPE_FLOAT;
+
+                                            }
+                                            else { printf("\n\n\t***Error: Operation not allowed***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset)); n_error++;}
+                                            }
+            |   content DIV content     { 
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        // queste malloc permettono il riconoscimento della x
+                                        $$->left_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                        $$->right_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                        $$->left_op = $1;
+                                        $$->right_op = $3;
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot divide '%s' by '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                        else    
+                                            {
+                                            if (($3->operand_type == CONTENT_TYPE_INT_NUMBER && $3->value.ival == 0) ||
+                                                ($3->operand_type == CONTENT_TYPE_FLOAT_NUMBER && $3->value.dval == 0.0))   { printf("\n\n\t***Error: Cannot divide by 0***\n\t***Line: %d***\n\n\n",source_line(@3.first_offset)); n_error++;}
+                                            else 
+                                                {
+                                                $$->left_op = $1;
+                                                $$->right_op = $3;
+                                                $$->expr_type = $1->val_type;
+                                                }
+                                            }
+                                        };
+    
+
+    logic_expr:
+                LPAR logic_expr RPAR    {   
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$ = $2;
+                                        }
+            |   content AND content     {   
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != DATA_TYPE_BOOL || $3->val_type != DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot AND '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset));n_error++; }
+                                        else {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        }
+            |   content OR content      {   
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != DATA_TYPE_BOOL || $3->val_type != DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot OR '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset));n_error++; }
+                                        else 
+                                            {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        };
+    
+
+    rel_expr:
+                LPAR rel_expr RPAR      {  
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$ = $2; 
+                                        }
+            |   content LT content      { 
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->left_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                        $$->right_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                        $$->left_op = $1;
+                                        $$->right_op = $3;
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                        else if ($1->val_type == DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset));n_error++; }
+                                        else {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        }
+            |   content LE content      { 
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                        else if ($1->val_type == DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset)); n_error++;}
+                                        else 
+                                            {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        }
+            |   content GT content      { 
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                        else if ($1->val_type == DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset)); n_error++;}
+                                        else 
+                                            {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        }
+            |   content GE content      {
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset));n_error++; }
+                                        else if ($1->val_type == DATA_TYPE_BOOL) 
+                                            { printf("\n\n\t***Error: Cannot compare boolean values***\n\t***Line: %d***\n\n\n",source_line(@2.first_offset));n_error++; }
+                                        else 
+                                            {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        }
+            |   content EEQ content     { 
+                                        $$ = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+                                        $$->op = $2;
+                                        if ($1->val_type != $3->val_type) 
+                                            { printf("\n\n\t***Error: Cannot compare '%s' with '%s'***\n\t***Line: %d***\n\n\n", type_to_str($1->val_type), type_to_str($3->val_type),source_line(@2.first_offset)); n_error++;}
+                                        else 
+                                            {
+                                            $$->left_op = $1;
+                                            $$->right_op = $3;
+                                            $$->expr_type = DATA_TYPE_BOOL;
+                                            }
+                                        };
+
+
+    input_stmnt:
+                CIN multi_rshift  { $$=$2; };
+        
+    
+    output_stmnt:
+                COUT multi_lshift {
+                    debug_print("Creating output statement", NULL);
+                    $$ = $2;
+                    debug_print("Output statement created", $$);
+                }
+                ;
+    
+    
+    multi_rshift:
+                single_rshift multi_rshift  {                     
+                                            $1->next_input = $2;
+                                            $$ = $1; 
+                                            }
+            |                               { $$=NULL; };
+    
+    
+    multi_lshift:
+                single_lshift { // Base case for the recursion
+                    debug_print("multi_lshift: single_lshift base case", $1);
+                    $$ = (struct AST_Node_Output*)MALLOC(sizeof(struct AST_Node_Output));
+                    $$->output_op = $1; // $1 is an AST_Node_Operand from single_lshift
+                    $$->next_output = NULL;
+                }
+            |   single_lshift multi_lshift { // Recursive step
+                    debug_print("multi_lshift: single_lshift multi_lshift recursive step", $1);
+                    $$ = (struct AST_Node_Output*)MALLOC(sizeof(struct AST_Node_Output));
+                    $$->output_op = $1; // $1 is an AST_Node_Operand from single_lshift
+                    $$->next_output = $2; // $2 is the AST_Node_Output from the recursive call
+                }
+                ;
+
+
+    single_rshift:
+                RSHIFT ID               {
+                                        $$ = (struct AST_Node_Input*)MALLOC(sizeof(struct AST_Node_Input));
+                                        $$->input_op = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                        struct Symbol *s = find_symbol($2, local_table);
+                                        if(s == NULL) { $$->input_op->val_type = DATA_TYPE_NONE; }
+                                        else    
+                                            {
+                                        $$->input_op->value.val = $2;
+                                        $$->input_op->val_type = s->data_type;
+                                        $$->input_op->operand_type = CONTENT_TYPE_ID;
+                                            }
+                                        };
+    
+    
+    single_lshift:
+                LSHIFT content  {
+                    $$ = $2;
+                }
+                ;
+
+
+    multi_fun_param:
+                fun_param                          {
+                                                    $1->next_param = NULL;
+                                                    $$ = $1;
+                                                    }
+            |   fun_param COMMA  multi_fun_param    {
+                                                    $1->next_param = $3;
+                                                    $$ = $1;
+                                                    };
+
+
+    fun_param:
+                types ID        { 
+                                $$ = (struct AST_Node_Params*)MALLOC(sizeof(struct AST_Node_Params));
+                                $$->decl_param = (struct AST_Node_Init*)MALLOC(sizeof(struct AST_Node_Init));
+                                $$->decl_param->data_type = $1;
+                                $$->decl_param->next_init = NULL;
+                                $$->call_param = NULL;
+                                $$->decl_param->assign = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                                $$->decl_param->assign->val_type = $1;
+                                $$->decl_param->assign->var = $2;
+                                $$->decl_param->assign->a_val.val = NULL;
+                                $$->decl_param->assign->a_type = CONTENT_TYPE_ID;
+                                }
+            |   content         { 
+                                $$ = (struct AST_Node_Params*)MALLOC(sizeof(struct AST_Node_Params));
+                                //$$->call_param = malloc(sizeof(struct AST_Node_Operand));
+                                $$->decl_param = NULL;
+                                $$->call_param = $1;
+                                //$$->call_param->val_type = $1->val_type;
+                                };
+                                        
+
+    initialization:
+                types ID        {
+                                $$ = (struct AST_Node_Init*)MALLOC(sizeof(struct AST_Node_Init));
+                                $$->data_type = $1;
+                                $$->next_init = NULL;
+                                $$->assign = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                                $$->assign->val_type = $1;
+                                $$->assign->var = $2;
+                                $$->assign->a_val.val = NULL;
+                                $$->assign->a_type = CONTENT_TYPE_ID;
+                                };
+
+
+    assignment:
+                ID EQ ID            { 
+                                    $$ = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                                    $$->var = $1;
+                                    $$->a_val.val = $3;
+                                    $$->a_type = CONTENT_TYPE_ID;
+                                    struct Symbol *s = find_symbol($3, local_table);
+                                    if (s==NULL) { $$->val_type = DATA_TYPE_NONE; }
+                                    else { $$-> val_type = s->data_type; }
+                                    }
+           |  types ID EQ content   { 
+                                    struct Symbol *s = NULL;
+                                    s = find_symbol($2, local_table);
+                                    if (s == NULL)  
+                                        { s = add_symbol($2, local_table, SYMBOL_VARIABLE, $1, $1, false, NULL, false, @2.first_offset, $4->value); }
+                                    else { printf("\n\n\t***Error: Variable %s already declared***\n\t***Line: %d***\n\n\n",$2,source_line(@2.first_offset)); n_error++;}
+                                    if(($1 != $4->val_type))
+                                        { printf("\n\n\t***Error: Cannot assign type %s to type %s***\n\t***Line: %d***\n\n\n",type_to_str($4->val_type),type_to_str($1),source_line(@4.first_offset)); n_error++;}
+                                    else
+                                        {
+                                        $$ = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                                        $$->a_type = $4->operand_type;
+                                        $$->var = $2;
+                                        $$->a_val = $4->value;
+                                        $$->val_type = $1;
+                                        }
+                                    }
+           | ID EQ content          { 
+                                    $$ = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+                                    $$->var = $1;
+                                    $$->a_val = $3->value;
+                                    $$->val_type = $3->val_type;
+                                    $$->a_type = $3->operand_type;
+                                    };
+
+
+    content:
+                ID              { 
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                struct Symbol *s = find_symtab($1, local_table);
+                                // undeclared names such as endl keep their text, with no type
+                                $$->value.val = $1;
+                                $$->operand_type = CONTENT_TYPE_ID;
+                                if(s==NULL) { $$->val_type = DATA_TYPE_NONE; }
+                                else
+                                    {
+                                    $$->val_type = s->data_type;
+                                    $$ = share_operand($$);
+                                    }
+                                }
+            |   FLOAT_NUMBER    {
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.dval = $1;
+                                $$->val_type = DATA_TYPE_FLOAT;
+                                $$->operand_type = CONTENT_TYPE_FLOAT_NUMBER;
+                                $$ = share_operand($$);
+                                }
+            |   INT_NUMBER      {
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.ival = $1;
+                                $$->val_type = DATA_TYPE_INT;
+                                $$->operand_type = CONTENT_TYPE_INT_NUMBER;
+                                $$ = share_operand($$);
+                                }
+            |   STRING_V        { 
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.val = $1;
+                                $$->val_type = DATA_TYPE_STRING;
+                                $$->operand_type = CONTENT_TYPE_STRING;
+                                $$ = share_operand($$);
+                                }
+            |   BOOL_V          { 
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.bval = $1;
+                                $$->val_type = DATA_TYPE_BOOL;
+                                $$->operand_type = CONTENT_TYPE_BOOL;
+                                $$ = share_operand($$);
+                                }
+            |   function_call   {
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.funca = $1;
+                                $$->val_type = $1->return_type;
+                                $$->operand_type = CONTENT_TYPE_FUNCTION;
+                                }
+            |   expr            { 
+                                $$ = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+                                $$->value.expr = $1;
+                                $$->val_type = $1->expr_type;
+                                $$->operand_type = CONTENT_TYPE_EXPRESSION;
+                                $$ = share_operand($$);
+                                };
+
+
+    types:
+            FLOAT   { $$ = DATA_TYPE_FLOAT; }
+        |   INT     { $$ = DATA_TYPE_INT; }
+        |   STRING  { $$ = DATA_TYPE_STRING; }
+        |   BOOL    { $$ = DATA_TYPE_BOOL; };
+%%
+
+/****************** Functions *****************/ 
+
+// Tokens come from the flex scanner, the time spent there is the lexing phase
+int yylex(void) {
+    STATS_PHASE outer = stats_enter(PHASE_LEX);
+    int token = scan_token();
+    stats_leave(outer);
+    stats.tokens++;
+    return token;
+}
+
+// Translate a previously parsed AST image without touching the C++ source
+int translate_ast_image(const char *image_path, const char *output_path) {
+    STATS_PHASE outer = stats_enter(PHASE_PARSE);
+    struct AST_Image *image = load_ast_image(image_path);
+    stats_leave(outer);
+    stats_step(STEP_FRONT_END);
+    if (image == NULL) {
+        trace_instant("error", "AST image not loaded");
+        return 1;
+    }
+    trace_instant("ast image loaded", image_path);   // the source is not parsed again
+
+    fptr = fopen(output_path, "w");
+    if (fptr == NULL) {
+        printf("Error: Cannot open output file %s\n", output_path);
+        unload_ast_image(&image);
+        return 1;
+    }
+
+    // images hold the tree as parsed, the passes run on every translation of it
+    run_passes(&image->root);
+    stats_step(STEP_OPTIMIZE);
+
+    outer = stats_enter(PHASE_EMIT);
+    translate_program(image->root);
+    stats.bytes_emitted = (size_t)ftell(fptr);
+    stats_leave(outer);
+    stats_step(STEP_EMIT);
+
+    delete_expression_texts();
+    unload_ast_image(&image);
+    fclose(fptr);
+    return 0;
+}
+
+// Parse the source in source_text/source_scan and write its translation to fptr; nonzero if
+// the AST image could not be written or the symbol table not created
+int translate_source(const char *emit_ast) {
+    local_table = new_symtab();
+    if (local_table == NULL) {
+        return 1;
+    }
+
+    STATS_PHASE outer = stats_enter(PHASE_PARSE);
+    yyparse();
+    stats_leave(outer);
+    stats_step(STEP_FRONT_END);
+    if (n_error > 0) {
+        char message[64];
+        snprintf(message, sizeof(message), "%d semantic errors", n_error);
+        trace_instant("error", message);
+    }
+
+    int status = 0;
+    if (n_error == 0) {
+        outer = stats_enter(PHASE_EMIT);
+        if (emit_ast != NULL && !write_ast_image(emit_ast, root)) {
+            status = 1;
+        }
+        stats_leave(outer);
+        run_passes(&root);
+        stats_step(STEP_OPTIMIZE);
+        outer = stats_enter(PHASE_EMIT);
+        translate_program(root);
+        stats.bytes_emitted = (size_t)ftell(fptr);
+        stats_leave(outer);
+        stats_step(STEP_EMIT);
+    } else if (emit_ast != NULL) {
+        fprintf(stderr, "Error: AST image %s not written, the input has errors\n", emit_ast);
+        status = 1;
+    }
+    return status;
+}
+
+// Free what a translation left behind and reset the parser state for the next source
+void release_translation(void) {
+    cleanup_arrays();
+    delete_shared_expressions();
+    delete_expression_texts();
+    delete_symtab(&local_table);
+    delete_prescan(&source_scan);
+    FREE(source_text);
+    source_text = NULL;
+    root = NULL;
+    n_error = 0;
+    found = false;
+    in_class = false;
+    is_inside_class = false;
+    class_members = NULL;
+    body_params = NULL;
+    indent_counter = 0;
+}
+
+// The fuzz harness (fuzz.c) brings its own entry point
+#ifndef CPP2PY_FUZZ
+int main(int argc, char *argv[]) {
+    const char *emit_ast = NULL;
+    const char *from_ast = NULL;
+    const char *stats_json = NULL;
+    const char *trace_out = NULL;
+    bool time_report = false;
+    const char *paths[2];
+    int n_paths = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--emit-ast") == 0 && i + 1 < argc) {
+            emit_ast = argv[++i];
+        } else if (strcmp(argv[i], "--from-ast") == 0 && i + 1 < argc) {
+            from_ast = argv[++i];
+        } else if (strcmp(argv[i], "--share-expressions") == 0) {
+            share_expressions = true;
+        } else if (strcmp(argv[i], "--time-report") == 0) {
+            time_report = true;
+        } else if (strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc) {
+            stats_json = argv[++i];
+        } else if (strcmp(argv[i], "--trace-out") == 0 && i + 1 < argc) {
+            trace_out = argv[++i];
+        } else if (strncmp(argv[i], "-O", 2) == 0 && argv[i][2] >= '0' && argv[i][2] <= '0' + MAX_OPT_LEVEL && argv[i][3] == '\0') {
+            passes_set_level(argv[i][2] - '0');
+        } else if (strncmp(argv[i], "--passes=", 9) == 0) {
+            if (!passes_select(argv[i] + 9)) return 1;
+        } else if (strncmp(argv[i], "--print-after=", 14) == 0) {
+            if (!passes_print_after(argv[i] + 14)) return 1;
+        } else if (strncmp(argv[i], "--eval-budget=", 14) == 0 && argv[i][14] >= '0' && argv[i][14] <= '9') {
+            eval_budget = strtoul(argv[i] + 14, NULL, 10);
+        } else if (strncmp(argv[i], "--unroll-limit=", 15) == 0 && argv[i][15] >= '0' && argv[i][15] <= '9') {
+            unroll_limit = strtoul(argv[i] + 15, NULL, 10);
+        } else if (strncmp(argv[i], "--inline-limit=", 15) == 0 && argv[i][15] >= '0' && argv[i][15] <= '9') {
+            inline_limit = strtoul(argv[i] + 15, NULL, 10);
+        } else if (argv[i][0] != '-' && n_paths < 2) {
+            paths[n_paths++] = argv[i];
+        } else {
+            n_paths = -1;
+            break;
+        }
+    }
+    if (from_ast != NULL ? (n_paths != 1 || emit_ast != NULL) : n_paths != 2) {
+        printf("Usage: %s [options] [--emit-ast ast_file] input_file output_file\n", argv[0]);
+        printf("       %s [options] --from-ast ast_file output_file\n", argv[0]);
+        printf("Options: --share-expressions --time-report --stats-json stats_file --trace-out trace_file\n");
+        printf("         -O0 -O1 -O2 --passes=pass,... --print-after=pass|all --eval-budget=steps\n");
+        printf("         --unroll-limit=statements --inline-limit=statements\n");
+        return 1;
+    }
+    if (trace_out != NULL && !trace_open(trace_out, from_ast != NULL ? from_ast : paths[0])) {
+        return 1;
+    }
+    if (time_report || stats_json != NULL || trace_out != NULL) {
+        stats_start();
+    }
+    if (from_ast != NULL) {
+        int status = translate_ast_image(from_ast, paths[0]);
+        if (status == 0 && !report_stats(time_report, stats_json, from_ast)) status = 1;
+        if (!trace_close()) status = 1;
+        alloc_report_leaks(stderr);
+        return status;
+    }
+
+    yyin = fopen(paths[0], "r");
+    if (yyin == NULL) {
+        printf("Error: Cannot open input file %s\n", paths[0]);
+        trace_instant("error", "cannot open input file");
+        trace_close();
+        return 1;
+    }
+
+    fptr = fopen(paths[1], "w");
+    if (fptr == NULL) {
+        printf("Error: Cannot open output file %s\n", paths[1]);
+        trace_instant("error", "cannot open output file");
+        trace_close();
+        fclose(yyin);
+        return 1;
+    }
+
+    // reading and pre-scanning the input belong to the lexing phase
+    STATS_PHASE outer = stats_enter(PHASE_LEX);
+    size_t source_len = 0;
+    source_text = read_source_file(yyin, &source_len);
+    if (source_text == NULL) {
+        fclose(yyin);
+        fclose(fptr);
+        return 1;
+    }
+    source_scan = new_prescan(source_text, source_len);
+    if (source_scan == NULL) {
+        rewind(yyin);  // the scanner falls back to reading the file itself
+    }
+    stats.source_bytes = source_len;
+    stats.source_lines = source_scan ? source_scan->n_lines : 0;
+    stats_leave(outer);
+    stats_step(STEP_READ);
+
+    int status = translate_source(emit_ast);
+    if (!report_stats(time_report, stats_json, paths[0])) {
+        status = 1;
+    }
+    if (!trace_close()) {
+        status = 1;
+    }
+
+    release_translation();
+    fclose(yyin);
+    fclose(fptr);
+    alloc_report_leaks(stderr);
+    return status;
+}
+#endif
+
+// Print the phase times and/or write the counters, as asked on the command line
+bool report_stats(bool time_report, const char *stats_json, const char *input_path) {
+    if (time_report) {
+        stats_print_report(stderr);
+    }
+    return stats_json == NULL || stats_write_json(stats_json, input_path);
+}
+
+int yyerror(char *s) {
+    fprintf(stderr, "Error: %s\n", s);
+    trace_instant("error", s);
+    return 0;
+}
+
+/****************** Scope handling *****************/ 
+
+void scope_enter(){
+    symtab_enter_scope(local_table);
+    indent_counter++;
+}
+
+void scope_exit(){
+    symtab_exit_scope(local_table);
+    indent_counter--;
+}
+
+// var = var op amount as the step of a for loop
+struct AST_Node_Assign *step_assign(char *var, OP_TYPE op, long amount){
+    struct AST_Node_Assign *assign = (struct AST_Node_Assign*)MALLOC(sizeof(struct AST_Node_Assign));
+    struct AST_Node_Expression *expr = (struct AST_Node_Expression*)CALLOC(1, sizeof(struct AST_Node_Expression));
+    struct AST_Node_Operand *left = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+    struct AST_Node_Operand *right = (struct AST_Node_Operand*)MALLOC(sizeof(struct AST_Node_Operand));
+    if (!assign || !expr || !left || !right) {
+        fprintf(stderr, "Error: Failed to allocate memory for loop step\n");
+        exit(1);
+    }
+    struct Symbol *s = find_symbol(var, local_table);
+    DATA_TYPE type = s != NULL ? s->data_type : DATA_TYPE_INT;
+    right->operand_type = CONTENT_TYPE_INT_NUMBER;
+    right->val_type = DATA_TYPE_INT;
+    right->value.ival = amount;
+    left->operand_type = CONTENT_TYPE_ID;
+    left->value.val = var;
+    left->val_type = type;
+    expr->op = op;
+    expr->left_op = share_operand(left);
+    expr->right_op = share_operand(right);
+    expr->expr_type = type;
+    assign->var = var;
+    assign->val_type = type;
+    assign->a_type = CONTENT_TYPE_EXPRESSION;
+    assign->a_val.expr = share_expression(expr);
+    return assign;
+}
+
+// Parameters are visible in the body of their function, declared in its scope
+void declare_params(struct AST_Node_Params *params, size_t offset){
+    for (struct AST_Node_Params *p = params; p != NULL; p = p->next_param) {
+        if (p->decl_param == NULL) continue;
+        char *name = p->decl_param->assign->var;
+        if (find_symbol(name, local_table) != NULL) {
+            printf("\n\n\t***Error: Parameter %s already declared***\n\t***Line: %d***\n\n\n", name, source_line(offset));
+            n_error++;
+            continue;
+        }
+        add_symbol(name, local_table, SYMBOL_PARAMETER, p->decl_param->data_type, DATA_TYPE_NONE, false, NULL, false, offset, null_value);
+    }
+}
+
+// Functions are keyed by name and packed parameter types so that overloads can coexist
+void declare_function(struct AST_Node_FunctionDef *def, size_t offset){
+    for (struct AST_Node_Params *p = def->params; p != NULL; p = p->next_param) {
+        if (p->decl_param == NULL) {
+            printf("\n\n\t***Error: parameter of %s is not a declaration***\n\t***Line: %d***\n\n\n", def->func_name, source_line(offset));
+            n_error++;
+            return;
+        }
+    }
+    int arity = 0;
+    SIG_KEY sig_key = pack_signature(def->params, true, &arity);
+    struct Symbol *s = add_function(def->func_name, local_table, def->return_type, arity, sig_key, def, offset);
+    if (s == NULL) {
+        printf("\n\n\t***Error: %s already declared***\n\t***Line: %d***\n\n\n", def->func_name, source_line(offset));
+        n_error++;
+        return;
+    }
+    if (s->overload > 0) {
+        def->func_name = STRDUP(s->py_name);
+    }
+    debug_print("Function symbol added", s);
+}
+
+/****************** Object member access *****************/ 
+
+// New access node for an object, its class is NULL (and an error is reported) if the object is unknown
+struct AST_Node_Object *access_object(char *obj_name, size_t offset){
+    struct AST_Node_Object *access = (struct AST_Node_Object*)MALLOC(sizeof(struct AST_Node_Object));
+    if (access == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for object access\n");
+        exit(1);
+    }
+    access->obj_name = obj_name;
+    access->obj_class = NULL;
+    access->access_value.val = NULL;
+    access->access_type = ACCESS_TYPE_VAR;
+    struct AST_Node_Object *object = find_object(obj_name, local_table);
+    if (object != NULL) {
+        access->obj_class = object->obj_class;
+        access->obj_name = object->obj_name;
+    }
+    if (access->obj_class == NULL) {
+        printf("\n\n\t***Error: object %s is not declared***\n\t***Line: %d***\n\n\n", obj_name, source_line(offset));
+        n_error++;
+    }
+    return access;
+}
+
+/****************** Convert Data Type to String and viceversa *****************/ 
+
+char * type_to_str(int type) {
+    switch (type) {
+        case DATA_TYPE_STRING:
+            return STRDUP("string");
+        case DATA_TYPE_FLOAT:
+            return STRDUP("float");
+        case DATA_TYPE_INT:
+            return STRDUP("int");
+        case DATA_TYPE_BOOL:
+            return STRDUP("bool");
+        case DATA_TYPE_NONE:
+            return STRDUP("Type none");
+        default:
+            return STRDUP("Type not defined");
+    }
+}
+
+// Debug print function
+void debug_print(const char *msg, void *ptr) {
+    printf("[DEBUG] %s: %p\n", msg, ptr);
+}
+
+void debug_token(const char *token_name, const char *token_value) {
+    printf("[TOKEN] %s: '%s'\n", token_name, token_value);
+}
@@ -0,0 +1,365 @@
+#define _GNU_SOURCE
+#include "passes.h"
+#include "stats.h"
+#include "symtab.h"
+#include "trace.h"
+#include "translation.h"
+#include <string.h>
+#include <time.h>
+
+// Every pass, in pipeline order. -O<n> runs those with a level up to n, --passes= names them.
+static const struct Pass passes[] = {
+    { "unroll", 2, "replace small loops over constant ranges by copies of their body", pass_unroll },
+    { "fold", 1, "fold constant expressions, propagate constants and prune constant branches", pass_fold },
+    { "eval", 2, "run calls to pure functions with constant arguments and fold their results", pass_eval },
+    { "inline", 2, "replace calls to small non-recursive functions by a copy of their body", pass_inline },
+    { "licm", 2, "compute expressions a for loop does not change once, before the loop", pass_licm },
+    { "reduce", 2, "replace loops that sum, multiply, take the min or max of or search over a range by one builtin call", pass_reduce },
+    { "cse", 2, "compute an expression repeated in a block of straight-line statements once, into a temporary", pass_cse },
+    { "dce", 1, "drop statements after a return in the same block", pass_dce },
+};
+#define N_PASSES (sizeof(passes) / sizeof(passes[0]))
+#define MAX_PIPELINE 64
+
+// One run of a pass
+struct Pass_Run {
+    const struct Pass *pass;
+    double wall;                  /* seconds */
+    double cpu;                   /* seconds */
+    size_t changes;
+};
+
+static int opt_level = 0;
+static const struct Pass *selected[MAX_PIPELINE];
+static int n_selected = -1;               /* -1 until --passes= is given, -O decides then */
+static const struct Pass *print_after = NULL;
+static bool print_after_all = false;
+static struct Pass_Run runs[MAX_PIPELINE];
+static int n_runs = 0;
+
+static const struct Pass *find_pass(const char *name, size_t len) {
+    for (size_t i = 0; i < N_PASSES; i++) {
+        if (strlen(passes[i].name) == len && strncmp(passes[i].name, name, len) == 0) return &passes[i];
+    }
+    return NULL;
+}
+
+static void print_pass_names(FILE *out) {
+    for (size_t i = 0; i < N_PASSES; i++) {
+        fprintf(out, "  %-10s -O%d  %s\n", passes[i].name, passes[i].level, passes[i].description);
+    }
+}
+
+static double cpu_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static double wall_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// -O<level>, passes up to that level run unless --passes= chose them
+void passes_set_level(int level) {
+    opt_level = level < 0 ? 0 : level > MAX_OPT_LEVEL ? MAX_OPT_LEVEL : level;
+}
+
+// --passes=name,name,... runs exactly those passes in that order, false on an unknown name
+bool passes_select(const char *list) {
+    n_selected = 0;
+    while (*list) {
+        size_t len = strcspn(list, ",");
+        if (len > 0) {
+            const struct Pass *pass = find_pass(list, len);
+            if (pass == NULL) {
+                fprintf(stderr, "Error: Unknown pass '%.*s', the passes are:\n", (int)len, list);
+                print_pass_names(stderr);
+                return false;
+            }
+            if (n_selected == MAX_PIPELINE) {
+                fprintf(stderr, "Error: More than %d passes given\n", MAX_PIPELINE);
+                return false;
+            }
+            selected[n_selected++] = pass;
+        }
+        list += len;
+        if (*list == ',') list++;
+    }
+    return true;
+}
+
+// --print-after=name shows the translation after that pass on stderr, "all" after every pass
+bool passes_print_after(const char *name) {
+    if (strcmp(name, "all") == 0) {
+        print_after_all = true;
+        return true;
+    }
+    print_after = find_pass(name, strlen(name));
+    if (print_after == NULL) {
+        fprintf(stderr, "Error: Unknown pass '%s', the passes are:\n", name);
+        print_pass_names(stderr);
+        return false;
+    }
+    return true;
+}
+
+// Python the tree translates to at this point; the emitter's node counters are left as they were
+static void print_tree(const char *pass_name, struct AST_Node_Statements *root) {
+    size_t nodes[N_NODE_TYPES];
+    memcpy(nodes, stats.nodes, sizeof(nodes));
+    FILE *out = fptr;
+    fptr = stderr;
+    fprintf(stderr, "# ---- after %s ----\n", pass_name);
+    translate_program(root);
+    fptr = out;
+    memcpy(stats.nodes, nodes, sizeof(nodes));
+}
+
+// Run the pipeline over the tree, timing every pass
+void run_passes(struct AST_Node_Statements **root) {
+    if (n_selected < 0) {
+        n_selected = 0;
+        for (size_t i = 0; i < N_PASSES; i++) {
+            if (passes[i].level <= opt_level) selected[n_selected++] = &passes[i];
+        }
+    }
+
+    STATS_PHASE outer = stats_enter(PHASE_OPTIMIZE);
+    n_runs = 0;
+    for (int i = 0; i < n_selected; i++) {
+        const struct Pass *pass = selected[i];
+        uint64_t trace_start = trace_now();
+        double wall = wall_seconds();
+        double cpu = cpu_seconds();
+        size_t changes = pass->run(root);
+        runs[n_runs].pass = pass;
+        runs[n_runs].wall = wall_seconds() - wall;
+        runs[n_runs].cpu = cpu_seconds() - cpu;
+        runs[n_runs].changes = changes;
+        n_runs++;
+
+        if (trace_enabled) {
+            char args[64];
+            snprintf(args, sizeof(args), "{\"changes\":%zu}", changes);
+            trace_span(pass->name, trace_start, args);
+        }
+        if (print_after_all || print_after == pass) {
+            print_tree(pass->name, *root);
+        }
+    }
+    stats_leave(outer);
+}
+
+// Time and rewrites of every pass run, for --time-report
+void passes_print_report(FILE *out) {
+    if (n_runs == 0) return;
+    fprintf(out, "%-10s %12s %12s %10s\n", "pass", "wall (ms)", "cpu (ms)", "changes");
+    for (int i = 0; i < n_runs; i++) {
+        fprintf(out, "%-10s %12.3f %12.3f %10zu\n", runs[i].pass->name,
+                runs[i].wall * 1e3, runs[i].cpu * 1e3, runs[i].changes);
+    }
+}
+
+// Level and pass runs, as members of the stats file
+void passes_write_json(FILE *out) {
+    fprintf(out, "  \"opt_level\": %d,\n  \"passes\": [", opt_level);
+    for (int i = 0; i < n_runs; i++) {
+        fprintf(out, "%s\n    { \"name\": \"%s\", \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"changes\": %zu }",
+                i ? "," : "", runs[i].pass->name, runs[i].wall * 1e3, runs[i].cpu * 1e3, runs[i].changes);
+    }
+    fprintf(out, "%s]", n_runs ? "\n  " : " ");
+}
+
+// Pointers to the statement lists an instruction holds, at most max of them
+size_t nested_bodies(struct AST_Node_Instruction *instr, struct AST_Node_Statements ***bodies, size_t max) {
+    size_t n = 0;
+    if (instr == NULL || max < 4) return 0;
+    switch (instr->n_type) {
+        case FUNC_DEF_NODE:
+            if (instr->value.functionDef && instr->value.functionDef->f_body) {
+                bodies[n++] = &instr->value.functionDef->f_body->func_body;
+            }
+            break;
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL) break;
+            bodies[n++] = &if_node->if_body;
+            if (if_node->else_if) bodies[n++] = &if_node->else_if->elif_body;
+            if (if_node->else_body) bodies[n++] = &if_node->else_body->else_body;
+            break;
+        }
+        case ELSE_IF_NODE:
+            if (instr->value.elseIfNode) bodies[n++] = &instr->value.elseIfNode->elif_body;
+            break;
+        case ELSE_NODE:
+            if (instr->value.elseNode) bodies[n++] = &instr->value.elseNode->else_body;
+            break;
+        case FOR_NODE:
+            if (instr->value.forNode) bodies[n++] = &instr->value.forNode->for_body;
+            break;
+        case CLASS_NODE:
+        case CLASS_CHILD_NODE:
+            if (instr->value.classNode && instr->value.classNode->c_body) {
+                bodies[n++] = &instr->value.classNode->c_body->pub_body;
+                bodies[n++] = &instr->value.classNode->c_body->pri_body;
+            }
+            break;
+        default:
+            break;
+    }
+    return n;
+}
+
+bool same_name(const char *a, const char *b) {
+    return a != NULL && b != NULL && strcmp(a, b) == 0;
+}
+
+// Operands of an expression, binary or n-ary
+size_t count_operands(struct AST_Node_Expression *expr) {
+    return expr->n_operands ? expr->n_operands : 2;
+}
+
+struct AST_Node_Operand *nth_operand(struct AST_Node_Expression *expr, size_t i) {
+    return expr->n_operands ? expr->operands[i] : (i == 0 ? expr->left_op : expr->right_op);
+}
+
+// Structurally the same operand. Floats compare by their bits: 0.0 and -0.0 differ, a NaN
+// matches itself
+bool same_operand(struct AST_Node_Operand *a, struct AST_Node_Operand *b) {
+    if (a == b) return true;
+    if (a == NULL || b == NULL || a->operand_type != b->operand_type) return false;
+    switch (a->operand_type) {
+        case CONTENT_TYPE_ID:
+        case CONTENT_TYPE_STRING: return same_name(a->value.val, b->value.val);
+        case CONTENT_TYPE_INT_NUMBER: return a->value.ival == b->value.ival;
+        case CONTENT_TYPE_FLOAT_NUMBER: return memcmp(&a->value.dval, &b->value.dval, sizeof(double)) == 0;
+        case CONTENT_TYPE_BOOL: return a->value.bval == b->value.bval;
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *x = a->value.expr, *y = b->value.expr;
+            if (x == y) return true;
+            if (x == NULL || y == NULL || x->op != y->op || x->n_operands != y->n_operands) return false;
+            for (size_t i = 0; i < count_operands(x); i++) {
+                if (!same_operand(nth_operand(x, i), nth_operand(y, i))) return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static unsigned int mix_hash(unsigned int hash, unsigned long long value) {
+    hash ^= (unsigned int)(value ^ (value >> 32));
+    return hash * 16777619u;
+}
+
+// Hash of operand, the same for operands same_operand takes for one another
+unsigned int operand_hash(struct AST_Node_Operand *operand) {
+    if (operand == NULL) return 0;
+    unsigned int hash = mix_hash(2166136261u, operand->operand_type);
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID:
+        case CONTENT_TYPE_STRING:
+            return operand->value.val ? mix_hash(hash, hash_name(operand->value.val)) : hash;
+        case CONTENT_TYPE_INT_NUMBER:
+            return mix_hash(hash, (unsigned long long)operand->value.ival);
+        case CONTENT_TYPE_FLOAT_NUMBER: {
+            unsigned long long bits;
+            memcpy(&bits, &operand->value.dval, sizeof(bits));
+            return mix_hash(hash, bits);
+        }
+        case CONTENT_TYPE_BOOL:
+            return mix_hash(hash, operand->value.bval);
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL) return hash;
+            hash = mix_hash(mix_hash(hash, expr->op), expr->n_operands);
+            for (size_t i = 0; i < count_operands(expr); i++) hash = mix_hash(hash, operand_hash(nth_operand(expr, i)));
+            return hash;
+        }
+        default:
+            return hash;
+    }
+}
+
+// The assignment has a value: a declaration without one holds an ID with no name
+bool has_value(struct AST_Node_Assign *assign) {
+    return assign != NULL && !(assign->a_type == CONTENT_TYPE_ID && assign->a_val.val == NULL);
+}
+
+// The value of an assignment as an operand, built on the stack
+struct AST_Node_Operand assign_value(struct AST_Node_Assign *assign) {
+    return (struct AST_Node_Operand){ .value = assign->a_val, .val_type = assign->val_type, .operand_type = assign->a_type };
+}
+
+// Python evaluates operand i of expr only sometimes: past the first of and / or
+bool conditional_operand(struct AST_Node_Expression *expr, size_t i) {
+    return i > 0 && (expr->op == OP_AND || expr->op == OP_OR);
+}
+
+// The operand changes a name while it is evaluated (x++ and x-- inside an expression)
+bool increments(struct AST_Node_Operand *operand) {
+    if (operand == NULL) return false;
+    if (operand->operand_type == CONTENT_TYPE_FUNCTION) {
+        if (operand->value.funca == NULL) return false;
+        for (struct AST_Node_Params *p = operand->value.funca->params; p != NULL; p = p->next_param) {
+            if (increments(p->call_param)) return true;
+        }
+        return false;
+    }
+    if (operand->operand_type != CONTENT_TYPE_EXPRESSION || operand->value.expr == NULL) return false;
+    struct AST_Node_Expression *expr = operand->value.expr;
+    if (expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) return true;
+    if (!expr->left_op || !expr->right_op) return false;
+    for (size_t i = 0; i < count_operands(expr); i++) {
+        if (increments(nth_operand(expr, i))) return true;
+    }
+    return false;
+}
+
+// The statement changes a name while computing its values, halfway through the names it reads
+bool statement_increments(struct AST_Node_Instruction *instr) {
+    switch (instr->n_type) {
+        case ASSIGN_NODE: {
+            if (!has_value(instr->value.assign)) return false;
+            struct AST_Node_Operand value = assign_value(instr->value.assign);
+            return increments(&value);
+        }
+        case INIT_NODE:
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL; init = init->next_init) {
+                if (!has_value(init->assign)) continue;
+                struct AST_Node_Operand value = assign_value(init->assign);
+                if (increments(&value)) return true;
+            }
+            return false;
+        case OUTPUT_NODE:
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL; out = out->next_output) {
+                if (increments(out->output_op)) return true;
+            }
+            return false;
+        case RETURN_NODE:
+            return instr->value.returnNode && instr->value.returnNode->value &&
+                   increments((struct AST_Node_Operand *)instr->value.returnNode->value->value);
+        case FUNC_CALL_NODE: {
+            struct AST_Node_Operand call = { .value.funca = instr->value.functionCall, .operand_type = CONTENT_TYPE_FUNCTION };
+            return increments(&call);
+        }
+        case IF_NODE: {
+            if (instr->value.ifNode == NULL || instr->value.ifNode->condition == NULL) return false;
+            struct AST_Node_Operand condition = { .value.expr = instr->value.ifNode->condition,
+                                                  .operand_type = CONTENT_TYPE_EXPRESSION };
+            return increments(&condition);
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL || !has_value(for_node->init)) return false;
+            struct AST_Node_Operand value = assign_value(for_node->init);
+            return increments(&value);
+        }
+        default:
+            return false;
+    }
+}
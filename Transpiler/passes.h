@@ -0,0 +1,72 @@
+#ifndef PASSES_H
+#define PASSES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ast.h"
+
+// AST-to-AST optimization passes, run between parsing and emission. A pass rewrites the tree
+// by replacing pointers with new nodes: expressions and operands may be shared
+// (--share-expressions) or reached from several places, and are never modified in place.
+// It returns the number of rewrites it made.
+//
+// Names a pass introduces start with __ and a prefix of its own (__inv<n> for licm, __cse<n> for
+// cse, __inl<k>_<name> for inline): an identifier starting with __ is reserved in C++, so no source
+// declares one and they cannot clash. Every pass but dce leaves class bodies alone: a name
+// assigned there is a class attribute, not a local.
+typedef size_t (*PASS_FUNCTION)(struct AST_Node_Statements **root);
+
+struct Pass {
+    const char *name;             /* as given to --passes= and --print-after= */
+    int level;                    /* lowest -O level that runs it */
+    const char *description;
+    PASS_FUNCTION run;
+};
+
+#define MAX_OPT_LEVEL 2
+
+// Function declarations
+void passes_set_level(int level);
+bool passes_select(const char *list);
+bool passes_print_after(const char *name);
+void run_passes(struct AST_Node_Statements **root);
+void passes_print_report(FILE *out);
+void passes_write_json(FILE *out);
+
+// Statement lists reached from an instruction: function, branch, loop and class bodies
+size_t nested_bodies(struct AST_Node_Instruction *instr, struct AST_Node_Statements ***bodies, size_t max);
+
+// Tree helpers shared by the passes
+bool same_name(const char *a, const char *b);
+size_t count_operands(struct AST_Node_Expression *expr);
+struct AST_Node_Operand *nth_operand(struct AST_Node_Expression *expr, size_t i);
+bool same_operand(struct AST_Node_Operand *a, struct AST_Node_Operand *b);
+unsigned int operand_hash(struct AST_Node_Operand *operand);
+bool has_value(struct AST_Node_Assign *assign);
+struct AST_Node_Operand assign_value(struct AST_Node_Assign *assign);
+bool conditional_operand(struct AST_Node_Expression *expr, size_t i);
+bool increments(struct AST_Node_Operand *operand);
+bool statement_increments(struct AST_Node_Instruction *instr);
+
+// Shared by the fold and eval passes
+bool is_literal(const struct AST_Node_Operand *operand);
+bool evaluate_constant(OP_TYPE op, const struct AST_Node_Operand *left, const struct AST_Node_Operand *right,
+                       struct AST_Node_Operand *result);
+size_t fold_tree(struct AST_Node_Statements **root, bool evaluate);
+bool eval_call(struct AST_Node_FunctionCall *call, struct AST_Node_Operand *result);
+extern unsigned long eval_budget;         /* steps the eval pass may run, --eval-budget= */
+extern unsigned long unroll_limit;        /* statements an unrolled loop may become, --unroll-limit= */
+extern unsigned long inline_limit;        /* statements an inlined function may hold, --inline-limit= */
+
+// Passes
+size_t pass_unroll(struct AST_Node_Statements **root);
+size_t pass_fold(struct AST_Node_Statements **root);
+size_t pass_eval(struct AST_Node_Statements **root);
+size_t pass_inline(struct AST_Node_Statements **root);
+size_t pass_licm(struct AST_Node_Statements **root);
+size_t pass_reduce(struct AST_Node_Statements **root);
+size_t pass_cse(struct AST_Node_Statements **root);
+size_t pass_dce(struct AST_Node_Statements **root);
+
+#endif // PASSES_H
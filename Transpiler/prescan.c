@@ -0,0 +1,409 @@
+#define _GNU_SOURCE
+#define ALLOC_SUBSYSTEM ALLOC_SCANNER
+#include "prescan.h"
+#include "alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PRESCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#define PRESCAN_BLOCK 64
+
+// Bytes the region state machine has to look at in one 64-byte block
+struct Block_Masks {
+    uint64_t newline;   /* '\n' */
+    uint64_t special;   /* '/', '"' and '#' */
+};
+
+typedef void (*classify_fn)(const char *block, struct Block_Masks *masks);
+
+// Portable classifier, used when no vector unit is available
+static void classify_scalar(const char *block, struct Block_Masks *masks) {
+    uint64_t newline = 0, special = 0;
+    for (int i = 0; i < PRESCAN_BLOCK; i++) {
+        char c = block[i];
+        if (c == '\n') {
+            newline |= 1ULL << i;
+        } else if (c == '/' || c == '"' || c == '#') {
+            special |= 1ULL << i;
+        }
+    }
+    masks->newline = newline;
+    masks->special = special;
+}
+
+#ifdef PRESCAN_X86
+__attribute__((target("sse2")))
+static void classify_sse2(const char *block, struct Block_Masks *masks) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i hash = _mm_set1_epi8('#');
+    uint64_t nl_mask = 0, sp_mask = 0;
+
+    for (int i = 0; i < PRESCAN_BLOCK / 16; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(block + 16 * i));
+        __m128i sp = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, slash), _mm_cmpeq_epi8(v, quote)),
+                                  _mm_cmpeq_epi8(v, hash));
+        nl_mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)) << (16 * i);
+        sp_mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(sp) << (16 * i);
+    }
+    masks->newline = nl_mask;
+    masks->special = sp_mask;
+}
+
+__attribute__((target("avx2")))
+static void classify_avx2(const char *block, struct Block_Masks *masks) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i hash = _mm256_set1_epi8('#');
+    uint64_t nl_mask = 0, sp_mask = 0;
+
+    for (int i = 0; i < PRESCAN_BLOCK / 32; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(block + 32 * i));
+        __m256i sp = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, slash), _mm256_cmpeq_epi8(v, quote)),
+                                     _mm256_cmpeq_epi8(v, hash));
+        nl_mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)) << (32 * i);
+        sp_mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(sp) << (32 * i);
+    }
+    masks->newline = nl_mask;
+    masks->special = sp_mask;
+}
+#endif
+
+// Pick the widest classifier the running CPU supports
+static classify_fn select_classifier(void) {
+#ifdef PRESCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return classify_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return classify_sse2;
+    }
+#endif
+    return classify_scalar;
+}
+
+// Set bits [start, end) of a bitmap
+static void set_bits(uint64_t *bits, size_t start, size_t end) {
+    while (start < end && (start & 63)) {
+        bits[start >> 6] |= 1ULL << (start & 63);
+        start++;
+    }
+    while (start + 64 <= end) {
+        bits[start >> 6] = ~0ULL;
+        start += 64;
+    }
+    while (start < end) {
+        bits[start >> 6] |= 1ULL << (start & 63);
+        start++;
+    }
+}
+
+static bool test_bit(const uint64_t *bits, size_t offset) {
+    return (bits[offset >> 6] >> (offset & 63)) & 1;
+}
+
+// Offset of the next newline at or after pos, or the end of the buffer
+static size_t end_of_line(struct Prescan *scan, size_t pos) {
+    const char *nl = memchr(scan->buf + pos, '\n', scan->len - pos);
+    return nl ? (size_t)(nl - scan->buf) : scan->len;
+}
+
+// Mark the region opened by the special byte at pos and return the offset just past it.
+// Follows the scanner rules: strings have no escapes, an unterminated string is a lone
+// unknown '"', '//' and '#' run to the end of the line, '/*' runs to '*/' or end of input.
+static size_t mark_region(struct Prescan *scan, size_t pos) {
+    const char *buf = scan->buf;
+    size_t len = scan->len;
+    size_t end;
+
+    switch (buf[pos]) {
+        case '"': {
+            const char *close = memchr(buf + pos + 1, '"', len - pos - 1);
+            if (close == NULL) {
+                return pos + 1;
+            }
+            end = (size_t)(close - buf) + 1;
+            set_bits(scan->string_bits, pos, end);
+            return end;
+        }
+        case '#':
+            end = end_of_line(scan, pos);
+            set_bits(scan->directive_bits, pos, end);
+            return end;
+        case '/':
+            if (pos + 1 < len && buf[pos + 1] == '/') {
+                end = end_of_line(scan, pos);
+                set_bits(scan->comment_bits, pos, end);
+                return end;
+            }
+            if (pos + 1 < len && buf[pos + 1] == '*') {
+                const char *close = memmem(buf + pos + 2, len - pos - 2, "*/", 2);
+                end = close ? (size_t)(close - buf) + 2 : len;
+                set_bits(scan->comment_bits, pos, end);
+                return end;
+            }
+            return pos + 1;
+        default:
+            return pos + 1;
+    }
+}
+
+static bool add_line_start(struct Prescan *scan, size_t *capacity, size_t offset) {
+    if (scan->n_lines == *capacity) {
+        size_t new_capacity = *capacity * 2;
+        size_t *grown = REALLOC(scan->line_starts, new_capacity * sizeof(size_t));
+        if (!grown) {
+            return false;
+        }
+        scan->line_starts = grown;
+        *capacity = new_capacity;
+    }
+    scan->line_starts[scan->n_lines++] = offset;
+    return true;
+}
+
+// Read a whole file into a NUL-terminated buffer
+char *read_source_file(FILE *file, size_t *len) {
+    size_t capacity = 1 << 16;
+    size_t used = 0;
+    char *buf = MALLOC(capacity + 1);
+    if (!buf) {
+        fprintf(stderr, "Error: Failed to allocate memory for source buffer\n");
+        return NULL;
+    }
+
+    size_t n;
+    while ((n = fread(buf + used, 1, capacity - used, file)) > 0) {
+        used += n;
+        if (used == capacity) {
+            capacity *= 2;
+            char *grown = REALLOC(buf, capacity + 1);
+            if (!grown) {
+                fprintf(stderr, "Error: Failed to allocate memory for source buffer\n");
+                FREE(buf);
+                return NULL;
+            }
+            buf = grown;
+        }
+    }
+    buf[used] = '\0';
+    *len = used;
+    return buf;
+}
+
+// Classify the whole buffer: line starts plus comment, string and directive bitmaps
+struct Prescan *new_prescan(const char *buf, size_t len) {
+    struct Prescan *scan = (struct Prescan *)CALLOC(1, sizeof(struct Prescan));
+    if (!scan) {
+        fprintf(stderr, "Error: Failed to allocate memory for pre-scan\n");
+        return NULL;
+    }
+
+    size_t words = (len + 63) / 64 + 1;
+    size_t line_capacity = 1024;
+    scan->buf = buf;
+    scan->len = len;
+    scan->comment_bits = (uint64_t *)CALLOC(words, sizeof(uint64_t));
+    scan->string_bits = (uint64_t *)CALLOC(words, sizeof(uint64_t));
+    scan->directive_bits = (uint64_t *)CALLOC(words, sizeof(uint64_t));
+    scan->line_starts = (size_t *)MALLOC(line_capacity * sizeof(size_t));
+    scan->segment_capacity = 64;
+    scan->segments = (struct Prescan_Segment *)MALLOC(scan->segment_capacity * sizeof(struct Prescan_Segment));
+    if (!scan->comment_bits || !scan->string_bits || !scan->directive_bits || !scan->line_starts || !scan->segments) {
+        fprintf(stderr, "Error: Failed to allocate memory for pre-scan\n");
+        delete_prescan(&scan);
+        return NULL;
+    }
+    scan->line_starts[scan->n_lines++] = 0;
+    scan->segments[scan->n_segments].stream_offset = 0;
+    scan->segments[scan->n_segments].source_offset = 0;
+    scan->n_segments++;
+
+    classify_fn classify = select_classifier();
+    size_t resume = 0;  // bytes before this offset belong to an already marked region
+
+    for (size_t base = 0; base < len; base += PRESCAN_BLOCK) {
+        const char *block = buf + base;
+        char tail[PRESCAN_BLOCK];
+        if (len - base < PRESCAN_BLOCK) {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, len - base);
+            block = tail;
+        }
+
+        struct Block_Masks masks;
+        classify(block, &masks);
+
+        for (uint64_t nl = masks.newline; nl != 0; nl &= nl - 1) {
+            if (!add_line_start(scan, &line_capacity, base + __builtin_ctzll(nl) + 1)) {
+                fprintf(stderr, "Error: Failed to allocate memory for line index\n");
+                delete_prescan(&scan);
+                return NULL;
+            }
+        }
+
+        for (uint64_t special = masks.special; special != 0; special &= special - 1) {
+            size_t pos = base + __builtin_ctzll(special);
+            if (pos >= resume) {
+                resume = mark_region(scan, pos);
+            }
+        }
+    }
+
+    return scan;
+}
+
+// Delete pre-scan (the text buffer belongs to the caller)
+void delete_prescan(struct Prescan **pscan) {
+    if (!pscan || !*pscan) return;
+    struct Prescan *scan = *pscan;
+    FREE(scan->line_starts);
+    FREE(scan->comment_bits);
+    FREE(scan->string_bits);
+    FREE(scan->directive_bits);
+    FREE(scan->segments);
+    FREE(scan);
+    *pscan = NULL;
+}
+
+// Region the byte at offset belongs to
+REGION_TYPE prescan_region_at(struct Prescan *scan, size_t offset) {
+    if (!scan || offset >= scan->len) return REGION_CODE;
+    if (test_bit(scan->comment_bits, offset)) return REGION_COMMENT;
+    if (test_bit(scan->string_bits, offset)) return REGION_STRING;
+    if (test_bit(scan->directive_bits, offset)) return REGION_DIRECTIVE;
+    return REGION_CODE;
+}
+
+// 1-based line containing offset (binary search over the line index)
+size_t prescan_line_of(struct Prescan *scan, size_t offset) {
+    size_t lo = 0, hi = scan->n_lines;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (scan->line_starts[mid] <= offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// 1-based line and column of offset
+void prescan_line_col(struct Prescan *scan, size_t offset, int *line, int *col) {
+    size_t l = prescan_line_of(scan, offset);
+    *line = (int)l;
+    *col = (int)(offset - scan->line_starts[l - 1]) + 1;
+}
+
+// Bytes to skip (comments and directives) in bitmap word w
+static uint64_t skip_word(struct Prescan *scan, size_t w) {
+    return scan->comment_bits[w] | scan->directive_bits[w];
+}
+
+// First offset at or after pos whose skip state differs from the state at pos
+static size_t run_end(struct Prescan *scan, size_t pos, bool skipped) {
+    size_t words = (scan->len + 63) / 64;
+    size_t w = pos >> 6;
+    uint64_t change = skipped ? ~skip_word(scan, w) : skip_word(scan, w);
+    change &= ~0ULL << (pos & 63);
+
+    while (change == 0) {
+        if (++w >= words) return scan->len;
+        change = skipped ? ~skip_word(scan, w) : skip_word(scan, w);
+    }
+    size_t end = (w << 6) + __builtin_ctzll(change);
+    return end < scan->len ? end : scan->len;
+}
+
+// Remember where the source resumes after a skipped region
+static void add_segment(struct Prescan *scan, size_t stream_offset, size_t source_offset) {
+    if (scan->n_segments == scan->segment_capacity) {
+        size_t new_capacity = scan->segment_capacity * 2;
+        struct Prescan_Segment *grown = REALLOC(scan->segments, new_capacity * sizeof(struct Prescan_Segment));
+        if (!grown) {
+            // like an allocation failure of the scanner's own buffers this ends the run: with a
+            // short map every later token would be reported at a wrong source offset
+            fprintf(stderr, "Error: Failed to allocate memory for offset map\n");
+            exit(1);
+        }
+        scan->segments = grown;
+        scan->segment_capacity = new_capacity;
+    }
+    scan->segments[scan->n_segments].stream_offset = stream_offset;
+    scan->segments[scan->n_segments].source_offset = source_offset;
+    scan->n_segments++;
+}
+
+// Feed the scanner: copy code runs verbatim and replace every comment or directive
+// region with its newlines (or a single blank) so tokens keep their separation.
+size_t prescan_fill(struct Prescan *scan, char *dest, size_t max_size) {
+    size_t out = 0;
+
+    while (out < max_size) {
+        if (scan->pending_newlines > 0) {
+            size_t n = scan->pending_newlines < max_size - out ? scan->pending_newlines : max_size - out;
+            memset(dest + out, '\n', n);
+            out += n;
+            scan->pending_newlines -= n;
+            continue;
+        }
+        if (scan->cursor >= scan->len) break;
+
+        bool skipped = test_bit(scan->comment_bits, scan->cursor) || test_bit(scan->directive_bits, scan->cursor);
+        size_t end = run_end(scan, scan->cursor, skipped);
+
+        if (skipped) {
+            size_t newlines = prescan_line_of(scan, end) - prescan_line_of(scan, scan->cursor);
+            size_t replaced = newlines == 0 ? 1 : newlines;
+            add_segment(scan, scan->stream_offset + out + replaced, end);
+            if (newlines == 0) {
+                dest[out++] = ' ';
+            } else {
+                scan->pending_newlines = newlines;
+            }
+            scan->cursor = end;
+        } else {
+            size_t n = end - scan->cursor < max_size - out ? end - scan->cursor : max_size - out;
+            memcpy(dest + out, scan->buf + scan->cursor, n);
+            scan->cursor += n;
+            out += n;
+        }
+    }
+
+    scan->stream_offset += out;
+    return out;
+}
+
+// Source offset of a byte the scanner saw at stream_offset.
+// Tokens arrive in order, so the cursor usually only moves forward.
+size_t prescan_source_offset(struct Prescan *scan, size_t stream_offset) {
+    size_t i = scan->segment_cursor;
+
+    if (scan->segments[i].stream_offset > stream_offset) {
+        size_t lo = 0, hi = i;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo + 1) / 2;
+            if (scan->segments[mid].stream_offset <= stream_offset) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        i = lo;
+    }
+    while (i + 1 < scan->n_segments && scan->segments[i + 1].stream_offset <= stream_offset) {
+        i++;
+    }
+
+    scan->segment_cursor = i;
+    return scan->segments[i].source_offset + (stream_offset - scan->segments[i].stream_offset);
+}
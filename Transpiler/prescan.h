@@ -0,0 +1,51 @@
+#ifndef PRESCAN_H
+#define PRESCAN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Kind of region marked by the pre-scan
+typedef enum {
+    REGION_CODE,
+    REGION_COMMENT,
+    REGION_STRING,
+    REGION_DIRECTIVE
+} REGION_TYPE;
+
+// Start of a run of source bytes handed to the scanner unchanged
+struct Prescan_Segment {
+    size_t stream_offset;         /* offset in the text the scanner sees */
+    size_t source_offset;         /* matching offset in the input buffer */
+};
+
+// Pre-scan of a whole input buffer
+struct Prescan {
+    const char *buf;              /* input text (not owned) */
+    size_t len;                   /* length of input text */
+    size_t *line_starts;          /* offset of the first byte of every line */
+    size_t n_lines;               /* number of entries in line_starts */
+    uint64_t *comment_bits;       /* one bit per byte inside a comment */
+    uint64_t *string_bits;        /* one bit per byte inside a string literal */
+    uint64_t *directive_bits;     /* one bit per byte inside a '#' line */
+    size_t cursor;                /* next source byte handed to the scanner */
+    size_t pending_newlines;      /* newlines of a skipped region not yet handed out */
+    size_t stream_offset;         /* bytes handed to the scanner so far */
+    struct Prescan_Segment *segments; /* scanner offset -> source offset map */
+    size_t n_segments;
+    size_t segment_capacity;
+    size_t segment_cursor;        /* last segment used, lookups are mostly monotonic */
+};
+
+// Function declarations
+char *read_source_file(FILE *file, size_t *len);
+struct Prescan *new_prescan(const char *buf, size_t len);
+void delete_prescan(struct Prescan **pscan);
+REGION_TYPE prescan_region_at(struct Prescan *scan, size_t offset);
+size_t prescan_line_of(struct Prescan *scan, size_t offset);
+void prescan_line_col(struct Prescan *scan, size_t offset, int *line, int *col);
+size_t prescan_fill(struct Prescan *scan, char *dest, size_t max_size);
+size_t prescan_source_offset(struct Prescan *scan, size_t stream_offset);
+
+#endif // PRESCAN_H
@@ -0,0 +1,189 @@
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "loops.h"
+#include <string.h>
+
+// Reduction recognition: a counted loop (loops.c) whose body only updates one accumulator is
+// replaced by a reduce node, which the emitter writes as one call of a builtin that runs the
+// loop in C:
+//
+//     s = s + e;                   s = s + sum(e for i in range(...))    math.fsum for floats
+//     if (c) s = s + e;            s = s + sum(e for i in range(...) if c), a count for e = 1
+//     p = p * e;                   p = p * math.prod(e for i in range(...))    ints only
+//     if (e > m) m = e;            m = max(m, max((e for i in range(...)), default=m))    ints only
+//     if (c) f = true;             f = f or any(c for i in range(...))
+//     if (c) f = false;            f = f and all(not (c) for i in range(...))
+//     if (c) x = 3;                if any(c for i in range(...)): x = 3
+//
+// e and c must be pure (no calls, no x++) and, but for max and min, must not read the
+// accumulator. Int sums and products are exact in Python, as the C++ loop is without overflow;
+// math.fsum rounds a float sum once instead of after every addition, so it can differ from the
+// C++ loop in the last bits, towards the exact sum. min and max take ints only, a NaN compares
+// differently once the comparisons are regrouped. Class bodies are left alone: a generator in a
+// class body does not see the names of the class.
+
+static bool is_name(struct AST_Node_Operand *operand, const char *name) {
+    return operand && operand->operand_type == CONTENT_TYPE_ID && same_name(operand->value.val, name);
+}
+
+// Evaluating the operand has no effect and does not read name
+static bool pure_without(struct AST_Node_Operand *operand, const char *name) {
+    if (operand == NULL) return false;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_INT_NUMBER:
+        case CONTENT_TYPE_FLOAT_NUMBER:
+        case CONTENT_TYPE_BOOL:
+            return true;
+        case CONTENT_TYPE_ID:
+            return operand->value.val != NULL && !same_name(operand->value.val, name);
+        case CONTENT_TYPE_EXPRESSION: {
+            struct AST_Node_Expression *expr = operand->value.expr;
+            if (expr == NULL || !expr->left_op || !expr->right_op) return false;
+            if (expr->op == OP_ADD_ASSIGN || expr->op == OP_SUB_ASSIGN) return false;
+            for (size_t i = 0; i < count_operands(expr); i++) {
+                if (!pure_without(nth_operand(expr, i), name)) return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool condition_without(struct AST_Node_Expression *condition, const char *name) {
+    struct AST_Node_Operand operand = { .value.expr = condition, .operand_type = CONTENT_TYPE_EXPRESSION };
+    return condition != NULL && pure_without(&operand, name);
+}
+
+// Element of var = var op e (or e op var for + and *), NULL if assign is not of that form
+static struct AST_Node_Operand *accumulated(struct AST_Node_Assign *assign, OP_TYPE *op) {
+    if (assign->a_type != CONTENT_TYPE_EXPRESSION || assign->a_val.expr == NULL) return NULL;
+    struct AST_Node_Expression *expr = assign->a_val.expr;
+    if (expr->op != OP_ADD && expr->op != OP_SUB && expr->op != OP_MUL) return NULL;
+    if (expr->expr_type != assign->val_type || count_operands(expr) != 2) return NULL;
+    struct AST_Node_Operand *element = NULL;
+    if (is_name(nth_operand(expr, 0), assign->var)) {
+        element = nth_operand(expr, 1);
+    } else if (expr->op != OP_SUB && is_name(nth_operand(expr, 1), assign->var)) {
+        element = nth_operand(expr, 0);
+    }
+    if (!pure_without(element, assign->var)) return NULL;
+    *op = expr->op;
+    return element;
+}
+
+// if (e > m) m = e and its mirror images, into *reduce
+static bool match_extreme(struct AST_Node_Expression *condition, struct AST_Node_Assign *assign,
+                          struct AST_Node_Reduce *reduce) {
+    if (assign->val_type != DATA_TYPE_INT || condition->n_operands != 0) return false;
+    if (condition->op != OP_LT && condition->op != OP_GT && condition->op != OP_LE && condition->op != OP_GE) return false;
+    struct AST_Node_Operand value = assign_value(assign);
+    if (!pure_without(&value, assign->var)) return false;
+    // element on the left: e > m is a max; on the right: m < e is a max
+    bool greater = condition->op == OP_GT || condition->op == OP_GE;
+    if (is_name(condition->right_op, assign->var) && same_operand(condition->left_op, &value)) {
+        reduce->kind = greater ? REDUCE_MAX : REDUCE_MIN;
+        reduce->value = condition->left_op;
+    } else if (is_name(condition->left_op, assign->var) && same_operand(condition->right_op, &value)) {
+        reduce->kind = greater ? REDUCE_MIN : REDUCE_MAX;
+        reduce->value = condition->right_op;
+    } else {
+        return false;
+    }
+    return reduce->value->val_type == DATA_TYPE_INT;
+}
+
+// The single statement of a counted loop body as a reduction, into *reduce
+static bool match_reduction(struct AST_Node_Instruction *instr, struct AST_Node_Reduce *reduce) {
+    struct AST_Node_Expression *condition = NULL;
+    struct AST_Node_Assign *assign = NULL;
+    if (instr->n_type == ASSIGN_NODE) {
+        assign = instr->value.assign;
+    } else if (instr->n_type == IF_NODE) {
+        struct AST_Node_If *if_node = instr->value.ifNode;
+        if (if_node == NULL || if_node->else_if || if_node->else_body || if_node->condition == NULL) return false;
+        struct AST_Node_Statements *body = if_node->if_body;
+        if (body == NULL || body->right || body->left == NULL || body->left->n_type != ASSIGN_NODE) return false;
+        condition = if_node->condition;
+        assign = body->left->value.assign;
+    }
+    if (assign == NULL || assign->var == NULL) return false;
+    reduce->var = assign->var;
+    reduce->type = assign->val_type;
+    reduce->condition = condition;
+
+    if (condition != NULL && match_extreme(condition, assign, reduce)) {
+        reduce->condition = NULL;
+        return true;
+    }
+    if (condition != NULL && !condition_without(condition, assign->var)) return false;
+
+    OP_TYPE op;
+    struct AST_Node_Operand *element = accumulated(assign, &op);
+    if (element != NULL && (assign->val_type == DATA_TYPE_INT || (assign->val_type == DATA_TYPE_FLOAT && op != OP_MUL))) {
+        reduce->kind = op == OP_MUL ? REDUCE_PRODUCT : REDUCE_SUM;
+        reduce->op = op;
+        reduce->value = element;
+        return true;
+    }
+
+    // if (c) x = constant: assigned the same value however often c holds
+    if (condition != NULL && (assign->a_type == CONTENT_TYPE_INT_NUMBER || assign->a_type == CONTENT_TYPE_FLOAT_NUMBER ||
+                              assign->a_type == CONTENT_TYPE_BOOL || assign->a_type == CONTENT_TYPE_STRING)) {
+        struct AST_Node_Operand *value = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        if (!value) {
+            fprintf(stderr, "Error: Failed to allocate memory for reduction\n");
+            return false;
+        }
+        *value = assign_value(assign);
+        reduce->kind = REDUCE_ANY;
+        reduce->value = share_operand(value);
+        return true;
+    }
+    return false;
+}
+
+// Replace the for loop at instr by a reduce node if it is a reduction
+static bool reduce_loop(struct AST_Node_Statements *statement) {
+    struct AST_Node_For *for_node = statement->left->value.forNode;
+    struct Counted_Loop loop;
+    if (for_node == NULL || for_node->for_body == NULL || for_node->for_body->right != NULL ||
+        for_node->for_body->left == NULL) {
+        return false;
+    }
+    // the body first, counted_loop searches all of it (a loop nested there included)
+    struct AST_Node_Reduce match = { .loop = for_node };
+    if (!match_reduction(for_node->for_body->left, &match) || !counted_loop(for_node, &loop)) return false;
+
+    struct AST_Node_Reduce *reduce = (struct AST_Node_Reduce *)MALLOC(sizeof(struct AST_Node_Reduce));
+    struct AST_Node_Instruction *instr = (struct AST_Node_Instruction *)MALLOC(sizeof(struct AST_Node_Instruction));
+    if (!reduce || !instr) {
+        fprintf(stderr, "Error: Failed to allocate memory for reduction\n");
+        FREE(reduce);
+        FREE(instr);
+        return false;
+    }
+    *reduce = match;
+    instr->n_type = REDUCE_NODE;
+    instr->value.reduceNode = reduce;
+    statement->left = instr;
+    return true;
+}
+
+static size_t reduce_list(struct AST_Node_Statements *list) {
+    size_t changes = 0;
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL || instr->n_type == CLASS_NODE || instr->n_type == CLASS_CHILD_NODE) continue;
+        // inner loops first, a loop around a reduce node is not reduced again
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) changes += reduce_list(*bodies[i]);
+        if (instr->n_type == FOR_NODE && reduce_loop(list)) changes++;
+    }
+    return changes;
+}
+
+size_t pass_reduce(struct AST_Node_Statements **root) {
+    return reduce_list(*root);
+}
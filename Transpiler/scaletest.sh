@@ -0,0 +1,89 @@
+#!/bin/sh
+# Scaling test: translates inputs of doubling size along one axis at a time (statements in a
+# block, statements in a loop body, nesting depth, expression length, classes, members of a
+# class, call sites) and fails if CPU time or heap growth rises faster than linearly. Every axis
+# is run at each level of SCALE_LEVELS (-O0 and -O2), so that the passes are covered too.
+#
+#     ./scaletest.sh [axis ...]
+#
+# From the smallest to the largest input (16 times larger), time and heap may grow at most
+# SCALE_SLACK (2) times the size ratio; a quadratic step grows 256 times. Each size is run three
+# times and the fastest run counts.
+
+CPP2PY=${CPP2PY:-./cpp2py}
+GENCORPUS=${GENCORPUS:-./gencorpus}
+SCALE_DIR=${SCALE_DIR:-scaletest}
+SCALE_SLACK=${SCALE_SLACK:-2}
+SCALE_LEVELS=${SCALE_LEVELS:-0 2}
+AXES=${*:-statements loop nesting expression classes members calls}
+DOUBLINGS=4
+
+mkdir -p "$SCALE_DIR" || exit 1
+
+# Smallest size of an axis, large enough for the run time to be measurable
+base_size() {
+    case "$1" in
+        nesting) echo 8 ;;
+        classes) echo 500 ;;
+        *) echo 2000 ;;
+    esac
+}
+
+# Fastest CPU time (ms) of three runs at level $2, and heap growth (bytes) of the input
+measure() {
+    best=""
+    for run in 1 2 3; do
+        "$CPP2PY" -O"$2" --stats-json "$SCALE_DIR/stats.json" "$1" "$SCALE_DIR/out.py" > /dev/null 2> "$SCALE_DIR/err.txt" || return 1
+        # syntax errors, a full parser stack or a traversal cut short are reported without failing
+        if grep -q "Error" "$SCALE_DIR/err.txt"; then return 1; fi
+        cpu=$(sed -n 's/.*"total": { "wall_ms": [0-9.]*, "cpu_ms": \([0-9.]*\).*/\1/p' "$SCALE_DIR/stats.json")
+        best=$(awk -v a="$best" -v b="$cpu" 'BEGIN { print (a == "" || b < a) ? b : a }')
+    done
+    heap=$(sed -n 's/.*"heap_growth_bytes": {\(.*\)}.*/\1/p' "$SCALE_DIR/stats.json" |
+           awk -F'[:,]' '{ for (i = 2; i <= NF; i += 2) sum += $i } END { print sum + 0 }')
+    echo "$best $heap"
+}
+
+failed=0
+for level in $SCALE_LEVELS; do
+    for axis in $AXES; do
+        n=$(base_size "$axis")
+        first=""
+        step=0
+        while [ $step -le $DOUBLINGS ]; do
+            src="$SCALE_DIR/$axis-$n.cpp"
+            "$GENCORPUS" --axis "$axis" "$n" > "$src" || exit 1
+            result=$(measure "$src" "$level")
+            if [ $? -ne 0 ]; then
+                echo "$axis -O$level: translation of $src failed"
+                grep "Error" "$SCALE_DIR/err.txt" | head -n 3
+                failed=1
+                continue 2
+            fi
+            set -- $result
+            printf '%-12s -O%s n=%-8d cpu %10.3f ms   heap %12d bytes\n' "$axis" "$level" "$n" "$1" "$2"
+            if [ -z "$first" ]; then
+                first_n=$n; first_cpu=$1; first_heap=$2; first=1
+            fi
+            last_n=$n; last_cpu=$1; last_heap=$2
+            n=$((n * 2))
+            step=$((step + 1))
+        done
+        verdict=$(awk -v n0="$first_n" -v n1="$last_n" -v t0="$first_cpu" -v t1="$last_cpu" \
+                      -v h0="$first_heap" -v h1="$last_heap" -v slack="$SCALE_SLACK" 'BEGIN {
+            bound = slack * n1 / n0
+            t = t0 > 0 ? t1 / t0 : 0
+            h = h0 > 0 ? h1 / h0 : 0
+            printf "time x%.1f, heap x%.1f for size x%d (bound x%.0f)", t, h, n1 / n0, bound
+            if (t > bound || h > bound) printf " FAIL"
+        }')
+        echo "$axis -O$level: $verdict"
+        case "$verdict" in *FAIL) failed=1 ;; esac
+    done
+done
+
+if [ $failed -ne 0 ]; then
+    echo "Scaling test failed"
+    exit 1
+fi
+echo "Scaling test passed"
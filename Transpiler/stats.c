@@ -0,0 +1,211 @@
+#define _GNU_SOURCE
+#include "stats.h"
+#include "translation.h"
+#include "trace.h"
+#include "passes.h"
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define STATS_HEAP 1
+#endif
+
+// Phase timing is only done when a report was asked for, the counters are always kept
+bool stats_enabled = false;
+struct Stats stats;
+
+static struct timespec run_start;         /* stats_start() */
+static struct timespec phase_start;       /* last phase switch */
+static double step_cpu;                   /* CPU clock at the last step */
+static double step_wall[N_PHASES];        /* wall time of every phase at the last step */
+static long long step_heap;               /* heap in use at the last step */
+static uint64_t step_start;               /* trace clock at the last step */
+
+static const char *phase_names[N_PHASES] = { "other", "lex", "parse", "semantic", "optimize", "emit" };
+static const char *step_names[N_STEPS] = { "read", "front_end", "optimize", "emit" };
+static const char *step_spans[N_STEPS] = { "lex", "parse", "optimize", "emit" };   /* trace span of each step */
+
+const char *stats_phase_name(STATS_PHASE phase) {
+    return phase < N_PHASES ? phase_names[phase] : "unknown";
+}
+
+static double seconds_between(struct timespec *from, struct timespec *to) {
+    return (double)(to->tv_sec - from->tv_sec) + (double)(to->tv_nsec - from->tv_nsec) / 1e9;
+}
+
+static double cpu_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static long long heap_in_use(void) {
+#ifdef STATS_HEAP
+    return (long long)mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+// Start timing the run, everything until the first stats_enter() is charged to PHASE_NONE
+void stats_start(void) {
+    stats_enabled = true;
+    stats.phase = PHASE_NONE;
+    clock_gettime(CLOCK_MONOTONIC, &run_start);
+    phase_start = run_start;
+    step_cpu = cpu_seconds();
+    step_heap = heap_in_use();
+    step_start = trace_now();
+}
+
+// Charge the time since the last switch to the current phase
+static void charge_phase(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    stats.wall[stats.phase] += seconds_between(&phase_start, &now);
+    phase_start = now;
+}
+
+// Make phase current. Returns the phase to hand back to stats_leave();
+// nested calls for the same phase cost nothing.
+STATS_PHASE stats_enter(STATS_PHASE phase) {
+    STATS_PHASE outer = stats.phase;
+    if (!stats_enabled || phase == outer) return outer;
+    charge_phase();
+    stats.phase = phase;
+    return outer;
+}
+
+void stats_leave(STATS_PHASE outer) {
+    stats_enter(outer);
+}
+
+// Sample the CPU clock and the heap. Reading the CPU clock on every phase switch would cost more
+// than most semantic checks, so the CPU time of a step is shared out by the wall time of its phases.
+void stats_step(STATS_STEP step) {
+    if (!stats_enabled) return;
+    charge_phase();
+
+    double cpu = cpu_seconds();
+    double wall = 0, phase_wall[N_PHASES];
+    for (int p = 0; p < N_PHASES; p++) {
+        phase_wall[p] = stats.wall[p] - step_wall[p];
+        wall += phase_wall[p];
+        step_wall[p] = stats.wall[p];
+    }
+    for (int p = 0; p < N_PHASES; p++) {
+        if (wall > 0) stats.cpu[p] += (cpu - step_cpu) * phase_wall[p] / wall;
+    }
+    step_cpu = cpu;
+
+    // the phases interleaved within the step go along with its span
+    if (trace_enabled) {
+        char args[192];
+        snprintf(args, sizeof(args), "{\"lex_ms\":%.3f,\"parse_ms\":%.3f,\"semantic_ms\":%.3f,\"optimize_ms\":%.3f,\"emit_ms\":%.3f}",
+                 phase_wall[PHASE_LEX] * 1e3, phase_wall[PHASE_PARSE] * 1e3, phase_wall[PHASE_SEMANTIC] * 1e3,
+                 phase_wall[PHASE_OPTIMIZE] * 1e3, phase_wall[PHASE_EMIT] * 1e3);
+        trace_span(step_spans[step], step_start, args);
+    }
+    step_start = trace_now();
+
+    long long heap = heap_in_use();
+    stats.heap_growth[step] += heap - step_heap;
+    step_heap = heap;
+}
+
+static void stats_finish(void) {
+    if (stats_enabled) charge_phase();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    stats.wall_total = seconds_between(&run_start, &now);
+    stats.cpu_total = 0;
+    for (int p = 0; p < N_PHASES; p++) stats.cpu_total += stats.cpu[p];
+
+    struct rusage usage;
+    stats.peak_rss_kb = getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+}
+
+// Source lines and megabytes (2^20 bytes) translated per second of wall time
+static double lines_per_second(void) {
+    return stats.wall_total > 0 ? (double)stats.source_lines / stats.wall_total : 0;
+}
+
+static double megabytes_per_second(void) {
+    return stats.wall_total > 0 ? (double)stats.source_bytes / (1024.0 * 1024.0) / stats.wall_total : 0;
+}
+
+// Human readable phase times
+void stats_print_report(FILE *out) {
+    stats_finish();
+    fprintf(out, "%-10s %12s %12s\n", "phase", "wall (ms)", "cpu (ms)");
+    for (int p = PHASE_LEX; p < N_PHASES; p++) {
+        fprintf(out, "%-10s %12.3f %12.3f\n", phase_names[p], stats.wall[p] * 1e3, stats.cpu[p] * 1e3);
+    }
+    fprintf(out, "%-10s %12.3f %12.3f\n", phase_names[PHASE_NONE], stats.wall[PHASE_NONE] * 1e3, stats.cpu[PHASE_NONE] * 1e3);
+    fprintf(out, "%-10s %12.3f %12.3f\n", "total", stats.wall_total * 1e3, stats.cpu_total * 1e3);
+    fprintf(out, "%zu lines, %zu bytes: %.0f lines/s, %.2f MB/s, peak RSS %ld KB\n", stats.source_lines,
+            stats.source_bytes, lines_per_second(), megabytes_per_second(), stats.peak_rss_kb);
+    passes_print_report(out);
+}
+
+// JSON string literal of s
+void write_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fprintf(out, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20) fprintf(out, "\\u%04x", (unsigned char)*s);
+        else fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+// Machine readable counters of the run
+bool stats_write_json(const char *path, const char *input_path) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Error: Cannot open stats file %s\n", path);
+        return false;
+    }
+    stats_finish();
+
+    fprintf(out, "{\n  \"input\": ");
+    write_json_string(out, input_path);
+    fprintf(out, ",\n  \"source_bytes\": %zu,\n  \"source_lines\": %zu,\n", stats.source_bytes, stats.source_lines);
+    fprintf(out, "  \"phases\": {\n");
+    for (int p = PHASE_LEX; p <= N_PHASES; p++) {
+        int i = p % N_PHASES;                      // "other" goes last
+        fprintf(out, "    \"%s\": { \"wall_ms\": %.3f, \"cpu_ms\": %.3f }%s\n", phase_names[i],
+                stats.wall[i] * 1e3, stats.cpu[i] * 1e3, p < N_PHASES ? "," : "");
+    }
+    fprintf(out, "  },\n  \"total\": { \"wall_ms\": %.3f, \"cpu_ms\": %.3f },\n",
+            stats.wall_total * 1e3, stats.cpu_total * 1e3);
+    fprintf(out, "  \"lines_per_sec\": %.1f,\n  \"mb_per_sec\": %.3f,\n  \"peak_rss_kb\": %ld,\n",
+            lines_per_second(), megabytes_per_second(), stats.peak_rss_kb);
+    fprintf(out, "  \"tokens\": %zu,\n  \"ast_nodes\": {", stats.tokens);
+    const char *sep = "";
+    for (int t = 0; t < N_NODE_TYPES; t++) {
+        if (stats.nodes[t] == 0) continue;
+        fprintf(out, "%s\n    \"%s\": %zu", sep, node_type((NODE_TYPE)t), stats.nodes[t]);
+        sep = ",";
+    }
+    fprintf(out, "%s},\n", *sep ? "\n  " : " ");
+    fprintf(out, "  \"symbols\": %zu,\n  \"scopes\": %zu,\n  \"peak_scope_depth\": %d,\n",
+            stats.symbols, stats.scopes, stats.peak_scope_depth);
+    fprintf(out, "  \"bytes_emitted\": %zu,\n  \"heap_growth_bytes\": {", stats.bytes_emitted);
+    for (int s = 0; s < N_STEPS; s++) {
+        fprintf(out, "%s \"%s\": %lld", s ? "," : "", step_names[s], stats.heap_growth[s]);
+    }
+    fprintf(out, " },\n");
+    passes_write_json(out);
+    if (alloc_accounting()) {
+        fprintf(out, ",\n");
+        alloc_write_json(out);
+    }
+    fprintf(out, "\n}\n");
+
+    bool ok = !ferror(out);
+    if (fclose(out) != 0) ok = false;
+    if (!ok) fprintf(stderr, "Error: Failed to write stats file %s\n", path);
+    return ok;
+}
@@ -0,0 +1,63 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ast.h"
+
+#define N_NODE_TYPES (REDUCE_NODE + 1)
+
+// Phases time is charged to; lexing, parsing and semantic checks interleave inside yyparse
+typedef enum {
+    PHASE_NONE,
+    PHASE_LEX,
+    PHASE_PARSE,
+    PHASE_SEMANTIC,
+    PHASE_OPTIMIZE,
+    PHASE_EMIT,
+    N_PHASES
+} STATS_PHASE;
+
+// Points where CPU time and heap size are sampled
+typedef enum {
+    STEP_READ,                    /* input read and pre-scanned */
+    STEP_FRONT_END,               /* source parsed and checked (or AST image loaded) */
+    STEP_OPTIMIZE,                /* optimization passes run */
+    STEP_EMIT,                    /* Python written */
+    N_STEPS
+} STATS_STEP;
+
+// Counters of one run
+struct Stats {
+    STATS_PHASE phase;            /* phase currently charged */
+    double wall[N_PHASES];        /* seconds */
+    double cpu[N_PHASES];         /* seconds, shared out by wall time between two steps */
+    double wall_total;
+    double cpu_total;
+    size_t source_bytes;
+    size_t source_lines;
+    size_t tokens;
+    size_t nodes[N_NODE_TYPES];   /* nodes reached by the emitter, per node type */
+    size_t symbols;               /* symbols and overloads declared */
+    size_t scopes;                /* scopes opened */
+    int peak_scope_depth;
+    size_t bytes_emitted;
+    long long heap_growth[N_STEPS]; /* bytes in use on the heap, growth over each step */
+    long peak_rss_kb;             /* resident set high-water mark of the process */
+};
+
+extern bool stats_enabled;
+extern struct Stats stats;
+
+// Function declarations
+void stats_start(void);
+const char *stats_phase_name(STATS_PHASE phase);
+STATS_PHASE stats_enter(STATS_PHASE phase);
+void stats_leave(STATS_PHASE outer);
+void stats_step(STATS_STEP step);
+void stats_print_report(FILE *out);
+bool stats_write_json(const char *path, const char *input_path);
+void write_json_string(FILE *out, const char *s);
+
+#endif // STATS_H
@@ -1,105 +1,494 @@
-#include "symtab.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-// Create new symbol table
-struct SymTab *new_symtab(int indent, struct SymTab *next) {
-    struct SymTab *table = (struct SymTab *)malloc(sizeof(struct SymTab));
-    if (!table) {
-        fprintf(stderr, "Error: Failed to allocate memory for symbol table\n");
-        return NULL;
-    }
-    
-    table->name = NULL;
-    table->indent = indent;
-    table->next = next;
-    table->symbols = NULL;
-    return table;
-}
-
-// Delete symbol table
-void delete_symtab(struct SymTab **ptable) {
-    if (!ptable || !*ptable) return;
-    struct SymTab *table = *ptable;
-    printf("[DEBUG] Deleting symbol table: %p\n", table);
-    struct Symbol *current, *tmp;
-    HASH_ITER(hh, table->symbols, current, tmp) {
-        printf("[DEBUG] Deleting symbol: %s (%p)\n", current->name_sym, current);
-        HASH_DEL(table->symbols, current);
-        free(current->name_sym);
-        free(current->param_func_name);
-        free(current);
-    }
-    free(table->name);
-    free(table);
-    *ptable = NULL;
-    printf("[DEBUG] Symbol table deleted.\n");
-}
-
-// Add symbol to table
-struct Symbol *add_symbol(char *name_sym, struct SymTab *table, SYMBOL_TYPE symbol_type,
-                         DATA_TYPE data_type, DATA_TYPE ret_type, bool is_function,
-                         char *param_func_name, bool is_class, int line_num,
-                         union Value_sym value_sym) {
-    if (!table || !name_sym) return NULL;
-    
-    struct Symbol *symbol;
-    HASH_FIND_STR(table->symbols, name_sym, symbol);
-    
-    if (symbol) {
-        fprintf(stderr, "Error: Symbol '%s' already exists in scope\n", name_sym);
-        return NULL;
-    }
-    
-    symbol = (struct Symbol *)malloc(sizeof(struct Symbol));
-    if (!symbol) {
-        fprintf(stderr, "Error: Failed to allocate memory for symbol\n");
-        return NULL;
-    }
-    
-    symbol->name_sym = strdup(name_sym);
-    symbol->symbol_type = symbol_type;
-    symbol->data_type = data_type;
-    symbol->ret_type = ret_type;
-    symbol->is_function = is_function;
-    symbol->param_func_name = param_func_name ? strdup(param_func_name) : NULL;
-    symbol->is_class = is_class;
-    symbol->line_num = line_num;
-    symbol->value_sym = value_sym;
-    
-    HASH_ADD_STR(table->symbols, name_sym, symbol);
-    return symbol;
-}
-
-// Find symbol in current table
-struct Symbol *find_symbol(char *name_sym, struct SymTab *table) {
-    if (!table || !name_sym) return NULL;
-    
-    struct Symbol *symbol;
-    HASH_FIND_STR(table->symbols, name_sym, symbol);
-    return symbol;
-}
-
-// Find symbol in all tables
-struct Symbol *find_symtab(char *name_sym, struct SymTab *table) {
-    if (!name_sym) return NULL;
-    
-    struct Symbol *symbol;
-    while (table) {
-        symbol = find_symbol(name_sym, table);
-        if (symbol) return symbol;
-        table = table->next;
-    }
-    return NULL;
-}
-
-// Delete symbol from table
-void delete_symbol(struct Symbol *symbol, struct SymTab *table) {
-    if (!symbol || !table) return;
-    printf("[DEBUG] Deleting single symbol: %s (%p) from table %p\n", symbol->name_sym, symbol, table);
-    HASH_DEL(table->symbols, symbol);
-    free(symbol->name_sym);
-    free(symbol->param_func_name);
-    free(symbol);
-} 
+#define ALLOC_SUBSYSTEM ALLOC_SYMTAB
+#include "symtab.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SYMTAB_INITIAL_SLOTS 256
+#define OVERLOAD_INITIAL_SLOTS 64
+
+// Marks an overload slot whose function went out of scope
+static struct Symbol overload_removed;
+
+// FNV-1a hash of an identifier
+unsigned int hash_name(const char *name) {
+    unsigned int h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Find the slot holding name, or the empty slot where it would go
+static size_t probe_slot(struct SymTab *table, const char *name, unsigned int hash) {
+    size_t mask = table->n_slots - 1;
+    size_t i = hash & mask;
+    while (table->slots[i] != 0) {
+        struct Sym_Name *entry = &table->names[table->slots[i] - 1];
+        if (entry->hash == hash && strcmp(entry->name, name) == 0) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Double the slot array and reinsert every interned name
+static bool grow_slots(struct SymTab *table) {
+    size_t n_slots = table->n_slots * 2;
+    int *slots = (int *)CALLOC(n_slots, sizeof(int));
+    if (!slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for symbol table slots\n");
+        return false;
+    }
+    for (size_t id = 0; id < table->n_names; id++) {
+        size_t i = table->names[id].hash & (n_slots - 1);
+        while (slots[i] != 0) i = (i + 1) & (n_slots - 1);
+        slots[i] = (int)id + 1;
+    }
+    FREE(table->slots);
+    table->slots = slots;
+    table->n_slots = n_slots;
+    return true;
+}
+
+// Hash of a (name, arity, signature) triple
+static unsigned int hash_overload(int name_id, int arity, SIG_KEY sig_key) {
+    unsigned long long h = (unsigned long long)name_id * 0x9E3779B97F4A7C15ull;
+    h ^= sig_key + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h ^= (unsigned long long)arity;
+    return (unsigned int)(h ^ (h >> 32));
+}
+
+// Find the slot holding the function, or the empty slot where it would go
+static size_t probe_overload(struct Symbol **slots, size_t n_slots, int name_id, int arity, SIG_KEY sig_key) {
+    size_t mask = n_slots - 1;
+    size_t i = hash_overload(name_id, arity, sig_key) & mask;
+    while (slots[i] != NULL) {
+        struct Symbol *f = slots[i];
+        if (f != &overload_removed && f->name_id == name_id && f->arity == arity && f->sig_key == sig_key) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Rebuild the overload slots, twice as large, dropping removed entries
+static bool grow_overloads(struct SymTab *table) {
+    size_t n_slots = table->n_overload_slots ? table->n_overload_slots * 2 : OVERLOAD_INITIAL_SLOTS;
+    struct Symbol **slots = (struct Symbol **)CALLOC(n_slots, sizeof(struct Symbol *));
+    if (!slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for function overloads\n");
+        return false;
+    }
+    size_t n_overloads = 0;
+    for (size_t i = 0; i < table->n_overload_slots; i++) {
+        struct Symbol *f = table->overloads[i];
+        if (f == NULL || f == &overload_removed) continue;
+        slots[probe_overload(slots, n_slots, f->name_id, f->arity, f->sig_key)] = f;
+        n_overloads++;
+    }
+    FREE(table->overloads);
+    table->overloads = slots;
+    table->n_overload_slots = n_slots;
+    table->n_overloads = n_overloads;
+    return true;
+}
+
+// Python name of the n-th overload: name__<parameter types>, the first one keeps its name
+static char *mangle_name(const char *name, int arity, SIG_KEY sig_key, int overload) {
+    static const char *type_names[] = { "none", "int", "float", "str", "bool" };
+
+    if (overload == 0) return STRDUP(name);
+
+    size_t size = strlen(name) + (size_t)arity * 6 + 16;
+    char *py_name = (char *)MALLOC(size);
+    if (!py_name) {
+        fprintf(stderr, "Error: Failed to allocate memory for overload name\n");
+        return NULL;
+    }
+    if (arity == 0) {
+        snprintf(py_name, size, "%s__void", name);
+    } else if (arity > SIG_MAX_PACKED) {
+        snprintf(py_name, size, "%s__%d", name, overload);
+    } else {
+        size_t len = (size_t)snprintf(py_name, size, "%s_", name);
+        for (int i = 0; i < arity; i++) {
+            unsigned int type = (unsigned int)((sig_key >> (3 * i)) & 7) - 1;
+            len += (size_t)snprintf(py_name + len, size - len, "_%s", type < 5 ? type_names[type] : "none");
+        }
+    }
+    return py_name;
+}
+
+static void free_symbol(struct Symbol *symbol) {
+    FREE(symbol->param_func_name);
+    FREE(symbol->py_name);
+    FREE(symbol);
+}
+
+// Take a symbol out of its shadow stack or overload chain and out of the overload slots
+static void unlink_symbol(struct SymTab *table, struct Symbol *symbol) {
+    struct Symbol **link = &table->names[symbol->name_id].top;
+    if (symbol->overload > 0) {
+        // overloads hang off the first function with the same name in their scope
+        for (struct Symbol *first = *link; first != NULL; first = first->shadowed) {
+            link = &first->next_overload;
+            while (*link && *link != symbol) link = &(*link)->next_overload;
+            if (*link) {
+                *link = symbol->next_overload;
+                break;
+            }
+        }
+    } else {
+        while (*link && *link != symbol) link = &(*link)->shadowed;
+        if (*link) *link = symbol->shadowed;
+    }
+
+    if (symbol->is_function && table->n_overload_slots > 0) {
+        size_t i = probe_overload(table->overloads, table->n_overload_slots, symbol->name_id, symbol->arity, symbol->sig_key);
+        if (table->overloads[i] == symbol) table->overloads[i] = &overload_removed;
+    }
+}
+
+// Create new symbol table
+struct SymTab *new_symtab(void) {
+    struct SymTab *table = (struct SymTab *)CALLOC(1, sizeof(struct SymTab));
+    if (!table) {
+        fprintf(stderr, "Error: Failed to allocate memory for symbol table\n");
+        return NULL;
+    }
+
+    table->slots = (int *)CALLOC(SYMTAB_INITIAL_SLOTS, sizeof(int));
+    if (!table->slots) {
+        fprintf(stderr, "Error: Failed to allocate memory for symbol table slots\n");
+        FREE(table);
+        return NULL;
+    }
+    table->n_slots = SYMTAB_INITIAL_SLOTS;
+    table->indent = 0;
+    return table;
+}
+
+// Delete symbol table
+void delete_symtab(struct SymTab **ptable) {
+    if (!ptable || !*ptable) return;
+    struct SymTab *table = *ptable;
+    printf("[DEBUG] Deleting symbol table: %p\n", table);
+    while (table->indent > 0) {
+        symtab_exit_scope(table);
+    }
+    for (size_t i = 0; i < table->n_undo; i++) {
+        struct Symbol *current = table->undo_log[i];
+        if (!current) continue;
+        free_symbol(current);
+    }
+    for (size_t id = 0; id < table->n_names; id++) {
+        FREE(table->names[id].name);
+    }
+    FREE(table->slots);
+    FREE(table->names);
+    FREE(table->undo_log);
+    FREE(table->scope_marks);
+    FREE(table->overloads);
+    FREE(table);
+    *ptable = NULL;
+    printf("[DEBUG] Symbol table deleted.\n");
+}
+
+// Open a nested scope
+void symtab_enter_scope(struct SymTab *table) {
+    if (!table) return;
+    if ((size_t)table->indent == table->scope_capacity) {
+        size_t capacity = table->scope_capacity ? table->scope_capacity * 2 : 16;
+        size_t *marks = (size_t *)REALLOC(table->scope_marks, capacity * sizeof(size_t));
+        if (!marks) {
+            fprintf(stderr, "Error: Failed to allocate memory for scope marks\n");
+            return;
+        }
+        table->scope_marks = marks;
+        table->scope_capacity = capacity;
+    }
+    table->scope_marks[table->indent] = table->n_undo;
+    table->indent++;
+    stats.scopes++;
+    if (table->indent > stats.peak_scope_depth) stats.peak_scope_depth = table->indent;
+}
+
+// Close the innermost scope, unwinding every symbol it declared
+void symtab_exit_scope(struct SymTab *table) {
+    if (!table || table->indent == 0) return;
+    table->indent--;
+    size_t mark = table->scope_marks[table->indent];
+    while (table->n_undo > mark) {
+        struct Symbol *current = table->undo_log[--table->n_undo];
+        if (!current) continue;  // already removed by delete_symbol
+        unlink_symbol(table, current);
+        free_symbol(current);
+    }
+}
+
+// Return the id of name, interning it on first use
+int intern_name(char *name, struct SymTab *table) {
+    if (!table || !name) return -1;
+
+    if ((table->n_names + 1) * 4 > table->n_slots * 3 && !grow_slots(table)) return -1;
+
+    unsigned int hash = hash_name(name);
+    size_t i = probe_slot(table, name, hash);
+    if (table->slots[i] != 0) return table->slots[i] - 1;
+
+    if (table->n_names == table->names_capacity) {
+        size_t capacity = table->names_capacity ? table->names_capacity * 2 : 64;
+        struct Sym_Name *names = (struct Sym_Name *)REALLOC(table->names, capacity * sizeof(struct Sym_Name));
+        if (!names) {
+            fprintf(stderr, "Error: Failed to allocate memory for interned names\n");
+            return -1;
+        }
+        table->names = names;
+        table->names_capacity = capacity;
+    }
+
+    struct Sym_Name *entry = &table->names[table->n_names];
+    entry->name = STRDUP(name);
+    if (!entry->name) {
+        fprintf(stderr, "Error: Failed to allocate memory for interned name\n");
+        return -1;
+    }
+    entry->hash = hash;
+    entry->top = NULL;
+    entry->class_def = NULL;
+    entry->object = NULL;
+    table->slots[i] = (int)table->n_names + 1;
+    return (int)table->n_names++;
+}
+
+// Id of an already interned name, -1 if the name was never declared
+static int lookup_name(char *name, struct SymTab *table) {
+    size_t i = probe_slot(table, name, hash_name(name));
+    return table->slots[i] - 1;
+}
+
+// Push a new symbol on the shadow stack of its name
+static struct Symbol *insert_symbol(char *name_sym, struct SymTab *table, SYMBOL_TYPE symbol_type,
+                                    DATA_TYPE data_type, DATA_TYPE ret_type, bool is_function,
+                                    char *param_func_name, bool is_class, size_t offset,
+                                    union Value_sym value_sym) {
+    if (!table || !name_sym) return NULL;
+
+    int name_id = intern_name(name_sym, table);
+    if (name_id < 0) return NULL;
+
+    struct Symbol *top = table->names[name_id].top;
+    if (top && top->indent == table->indent) {
+        fprintf(stderr, "Error: Symbol '%s' already exists in scope\n", name_sym);
+        return NULL;
+    }
+
+    if (table->n_undo == table->undo_capacity) {
+        size_t capacity = table->undo_capacity ? table->undo_capacity * 2 : 64;
+        struct Symbol **log = (struct Symbol **)REALLOC(table->undo_log, capacity * sizeof(struct Symbol *));
+        if (!log) {
+            fprintf(stderr, "Error: Failed to allocate memory for symbol undo log\n");
+            return NULL;
+        }
+        table->undo_log = log;
+        table->undo_capacity = capacity;
+    }
+
+    struct Symbol *symbol = (struct Symbol *)MALLOC(sizeof(struct Symbol));
+    if (!symbol) {
+        fprintf(stderr, "Error: Failed to allocate memory for symbol\n");
+        return NULL;
+    }
+
+    symbol->name_sym = table->names[name_id].name;
+    symbol->name_id = name_id;
+    symbol->indent = table->indent;
+    symbol->shadowed = top;
+    symbol->symbol_type = symbol_type;
+    symbol->data_type = data_type;
+    symbol->ret_type = ret_type;
+    symbol->is_function = is_function;
+    symbol->param_func_name = param_func_name ? STRDUP(param_func_name) : NULL;
+    symbol->is_class = is_class;
+    symbol->offset = offset;
+    symbol->value_sym = value_sym;
+    symbol->functionDef = NULL;
+    symbol->arity = 0;
+    symbol->sig_key = 0;
+    symbol->overload = 0;
+    symbol->py_name = NULL;
+    symbol->next_overload = NULL;
+
+    table->names[name_id].top = symbol;
+    table->undo_log[table->n_undo++] = symbol;
+    return symbol;
+}
+
+// Add symbol to table
+struct Symbol *add_symbol(char *name_sym, struct SymTab *table, SYMBOL_TYPE symbol_type,
+                         DATA_TYPE data_type, DATA_TYPE ret_type, bool is_function,
+                         char *param_func_name, bool is_class, size_t offset,
+                         union Value_sym value_sym) {
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    struct Symbol *symbol = insert_symbol(name_sym, table, symbol_type, data_type, ret_type, is_function,
+                                          param_func_name, is_class, offset, value_sym);
+    if (symbol) stats.symbols++;
+    stats_leave(outer);
+    return symbol;
+}
+
+// Register a function, overloads are chained behind the first symbol with the name
+static struct Symbol *insert_function(char *name_sym, struct SymTab *table, DATA_TYPE ret_type,
+                                      int arity, SIG_KEY sig_key, struct AST_Node_FunctionDef *functionDef,
+                                      size_t offset) {
+    if (!table || !name_sym) return NULL;
+
+    struct Symbol *first = find_symbol(name_sym, table);
+    if (first && (!first->is_function || find_function(name_sym, table, arity, sig_key))) {
+        return NULL;
+    }
+    if ((table->n_overloads + 1) * 4 > table->n_overload_slots * 3 && !grow_overloads(table)) return NULL;
+
+    struct Symbol *function;
+    if (first == NULL) {
+        function = add_symbol(name_sym, table, SYMBOL_FUNCTION, DATA_TYPE_NONE, ret_type, true,
+                              NULL, false, offset, null_value);
+        if (!function) return NULL;
+    } else {
+        // overloads stay out of the shadow stack, only the undo log and the overload slots know them
+        function = (struct Symbol *)MALLOC(sizeof(struct Symbol));
+        if (!function) {
+            fprintf(stderr, "Error: Failed to allocate memory for symbol\n");
+            return NULL;
+        }
+        *function = *first;
+        function->ret_type = ret_type;
+        function->offset = offset;
+        function->param_func_name = NULL;
+        function->shadowed = NULL;
+        function->next_overload = NULL;
+        function->overload = 1;
+        struct Symbol **link = &first->next_overload;
+        for (; *link != NULL; link = &(*link)->next_overload) function->overload++;
+        *link = function;
+
+        if (table->n_undo == table->undo_capacity) {
+            size_t capacity = table->undo_capacity * 2;
+            struct Symbol **log = (struct Symbol **)REALLOC(table->undo_log, capacity * sizeof(struct Symbol *));
+            if (!log) {
+                fprintf(stderr, "Error: Failed to allocate memory for symbol undo log\n");
+                *link = NULL;
+                FREE(function);
+                return NULL;
+            }
+            table->undo_log = log;
+            table->undo_capacity = capacity;
+        }
+        table->undo_log[table->n_undo++] = function;
+    }
+
+    function->functionDef = functionDef;
+    function->arity = arity;
+    function->sig_key = sig_key;
+    function->py_name = mangle_name(name_sym, arity, sig_key, function->overload);
+
+    size_t i = probe_overload(table->overloads, table->n_overload_slots, function->name_id, arity, sig_key);
+    table->overloads[i] = function;
+    table->n_overloads++;
+    return function;
+}
+
+// Add a function; a name already declared in this scope as a function gets a new overload
+struct Symbol *add_function(char *name_sym, struct SymTab *table, DATA_TYPE ret_type,
+                           int arity, SIG_KEY sig_key, struct AST_Node_FunctionDef *functionDef,
+                           size_t offset) {
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    struct Symbol *function = insert_function(name_sym, table, ret_type, arity, sig_key, functionDef, offset);
+    if (function && function->overload > 0) stats.symbols++;   // the first one was counted by add_symbol
+    stats_leave(outer);
+    return function;
+}
+
+// Find the function with exactly this name and signature, in any scope
+struct Symbol *find_function(char *name_sym, struct SymTab *table, int arity, SIG_KEY sig_key) {
+    if (!table || !name_sym || table->n_overload_slots == 0) return NULL;
+
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    int name_id = lookup_name(name_sym, table);
+    struct Symbol *function = NULL;
+    if (name_id >= 0) {
+        size_t i = probe_overload(table->overloads, table->n_overload_slots, name_id, arity, sig_key);
+        function = table->overloads[i];
+    }
+    stats_leave(outer);
+    return function;
+}
+
+// Find symbol in current scope
+struct Symbol *find_symbol(char *name_sym, struct SymTab *table) {
+    struct Symbol *symbol = find_symtab(name_sym, table);
+    if (symbol && symbol->indent != table->indent) return NULL;
+    return symbol;
+}
+
+// Find symbol in all scopes
+struct Symbol *find_symtab(char *name_sym, struct SymTab *table) {
+    if (!table || !name_sym) return NULL;
+
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    int name_id = lookup_name(name_sym, table);
+    struct Symbol *symbol = name_id < 0 ? NULL : table->names[name_id].top;
+    stats_leave(outer);
+    return symbol;
+}
+
+// Classes and objects are not scoped: they hang off their interned name, the first declaration wins
+void register_class(char *name, struct AST_Node_Class *class_def, struct SymTab *table) {
+    if (!table || !name) return;
+    int name_id = intern_name(name, table);
+    if (name_id >= 0 && table->names[name_id].class_def == NULL) table->names[name_id].class_def = class_def;
+}
+
+struct AST_Node_Class *find_class(char *name, struct SymTab *table) {
+    if (!table || !name) return NULL;
+
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    int name_id = lookup_name(name, table);
+    struct AST_Node_Class *class_def = name_id < 0 ? NULL : table->names[name_id].class_def;
+    stats_leave(outer);
+    return class_def;
+}
+
+void register_object(char *name, struct AST_Node_Object *object, struct SymTab *table) {
+    if (!table || !name) return;
+    int name_id = intern_name(name, table);
+    if (name_id >= 0 && table->names[name_id].object == NULL) table->names[name_id].object = object;
+}
+
+struct AST_Node_Object *find_object(char *name, struct SymTab *table) {
+    if (!table || !name) return NULL;
+
+    STATS_PHASE outer = stats_enter(PHASE_SEMANTIC);
+    int name_id = lookup_name(name, table);
+    struct AST_Node_Object *object = name_id < 0 ? NULL : table->names[name_id].object;
+    stats_leave(outer);
+    return object;
+}
+
+// Delete symbol from table
+void delete_symbol(struct Symbol *symbol, struct SymTab *table) {
+    if (!symbol || !table) return;
+    printf("[DEBUG] Deleting single symbol: %s (%p) from table %p\n", symbol->name_sym, symbol, table);
+
+    unlink_symbol(table, symbol);
+
+    // Drop it from the undo log, it is usually one of the latest entries
+    for (size_t i = table->n_undo; i > 0; i--) {
+        if (table->undo_log[i - 1] == symbol) {
+            table->undo_log[i - 1] = NULL;
+            break;
+        }
+    }
+    free_symbol(symbol);
+}
@@ -1,44 +1,85 @@
-#ifndef SYMTAB_H
-#define SYMTAB_H
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "ast.h"
-#include "uthash.h"
-
-// Symbol table structure
-struct SymTab {
-    char *name;
-    int indent;
-    struct SymTab *next;
-    struct Symbol *symbols;
-};
-
-// Symbol structure
-struct Symbol {
-    char *name_sym;                /* name of symbol */
-    SYMBOL_TYPE symbol_type;       /* type of symbol */
-    DATA_TYPE data_type;          /* type of data */
-    DATA_TYPE ret_type;           /* return type for functions */
-    bool is_function;             /* is it a function? */
-    char *param_func_name;        /* name of function if it's a parameter */
-    bool is_class;                /* is it a class? */
-    int line_num;                 /* line number where symbol is declared */
-    union Value_sym value_sym;    /* value of symbol */
-    struct AST_Node_FunctionDef *functionDef; /* function definition for function symbols */
-    UT_hash_handle hh;            /* makes this structure hashable */
-};
-
-// Function declarations
-struct SymTab *new_symtab(int indent, struct SymTab *next);
-void delete_symtab(struct SymTab **ptable);
-struct Symbol *add_symbol(char *name_sym, struct SymTab *table, SYMBOL_TYPE symbol_type, 
-                         DATA_TYPE data_type, DATA_TYPE ret_type, bool is_function, 
-                         char *param_func_name, bool is_class, int line_num, 
-                         union Value_sym value_sym);
-struct Symbol *find_symbol(char *name_sym, struct SymTab *table);
-struct Symbol *find_symtab(char *name_sym, struct SymTab *table);
-void delete_symbol(struct Symbol *symbol, struct SymTab *table);
-
-#endif // SYMTAB_H
+#ifndef SYMTAB_H
+#define SYMTAB_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+
+// Parameter types of a function packed 3 bits each, first parameter in the low bits
+typedef unsigned long long SIG_KEY;
+#define SIG_MAX_PACKED 21         /* parameters that fit in a SIG_KEY, longer lists are hashed */
+
+// Interned identifier, owns the top of its shadow stack
+struct Sym_Name {
+    char *name;                   /* interned spelling */
+    unsigned int hash;            /* hash of name */
+    struct Symbol *top;           /* innermost visible symbol with this name */
+    struct AST_Node_Class *class_def; /* class declared with this name, if any */
+    struct AST_Node_Object *object;   /* object declared with this name, if any */
+};
+
+// Symbol table structure: one open-addressing table for all scopes
+struct SymTab {
+    int *slots;                   /* name id + 1 per slot, 0 if empty */
+    size_t n_slots;               /* always a power of two */
+    struct Sym_Name *names;       /* interned identifiers, indexed by name id */
+    size_t n_names;
+    size_t names_capacity;
+    struct Symbol **undo_log;     /* symbols in declaration order */
+    size_t n_undo;
+    size_t undo_capacity;
+    size_t *scope_marks;          /* undo log length at every scope entry */
+    size_t scope_capacity;
+    struct Symbol **overloads;    /* functions by (name, arity, signature) */
+    size_t n_overload_slots;      /* always a power of two */
+    size_t n_overloads;           /* used slots, removed ones included */
+    int indent;                   /* current scope depth */
+};
+
+// Symbol structure
+struct Symbol {
+    char *name_sym;                /* name of symbol (interned, owned by the table) */
+    int name_id;                   /* interned identifier */
+    int indent;                    /* scope depth of the declaration */
+    struct Symbol *shadowed;       /* symbol hidden by this one, if any */
+    SYMBOL_TYPE symbol_type;       /* type of symbol */
+    DATA_TYPE data_type;          /* type of data */
+    DATA_TYPE ret_type;           /* return type for functions */
+    bool is_function;             /* is it a function? */
+    char *param_func_name;        /* name of function if it's a parameter */
+    bool is_class;                /* is it a class? */
+    size_t offset;                /* source offset where symbol is declared */
+    union Value_sym value_sym;    /* value of symbol */
+    struct AST_Node_FunctionDef *functionDef; /* function definition for function symbols */
+    int arity;                    /* number of parameters for functions */
+    SIG_KEY sig_key;              /* packed parameter types for functions */
+    int overload;                 /* 0 for the first function with this name, n for the n-th overload */
+    char *py_name;                /* Python name, mangled for overloads */
+    struct Symbol *next_overload; /* further overloads of the same name */
+};
+
+// Function declarations
+unsigned int hash_name(const char *name);
+struct SymTab *new_symtab(void);
+void delete_symtab(struct SymTab **ptable);
+void symtab_enter_scope(struct SymTab *table);
+void symtab_exit_scope(struct SymTab *table);
+int intern_name(char *name, struct SymTab *table);
+struct Symbol *add_symbol(char *name_sym, struct SymTab *table, SYMBOL_TYPE symbol_type,
+                         DATA_TYPE data_type, DATA_TYPE ret_type, bool is_function,
+                         char *param_func_name, bool is_class, size_t offset,
+                         union Value_sym value_sym);
+struct Symbol *add_function(char *name_sym, struct SymTab *table, DATA_TYPE ret_type,
+                           int arity, SIG_KEY sig_key, struct AST_Node_FunctionDef *functionDef,
+                           size_t offset);
+struct Symbol *find_function(char *name_sym, struct SymTab *table, int arity, SIG_KEY sig_key);
+struct Symbol *find_symbol(char *name_sym, struct SymTab *table);
+void register_class(char *name, struct AST_Node_Class *class_def, struct SymTab *table);
+struct AST_Node_Class *find_class(char *name, struct SymTab *table);
+void register_object(char *name, struct AST_Node_Object *object, struct SymTab *table);
+struct AST_Node_Object *find_object(char *name, struct SymTab *table);
+struct Symbol *find_symtab(char *name_sym, struct SymTab *table);
+void delete_symbol(struct Symbol *symbol, struct SymTab *table);
+
+#endif // SYMTAB_H
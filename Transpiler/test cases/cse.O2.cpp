@@ -0,0 +1,22 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int x = 7;
+    x = x + 1;
+    int y = 2;
+    y = y * 5;
+    int cx = 3;
+    cx = cx - 1;
+    int cy = 4;
+    cy = cy + 2;
+    int d = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+    int e = x * y;
+    int f = x * y + 1;
+    x = x + 1;
+    int g = x * y;
+    cout << d;
+    cout << f - e;
+    cout << g;
+    return 0;
+}
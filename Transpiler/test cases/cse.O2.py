@@ -0,0 +1,23 @@
+def main():
+    x = 7
+    x = x + 1
+    y = 2
+    y = y * 5
+    cx = 3
+    cx = cx - 1
+    cy = 4
+    cy = cy + 2
+    __cse0 = x - cx
+    __cse1 = y - cy
+    d = __cse0 * __cse0 + __cse1 * __cse1
+    e = x * y
+    f = e + 1
+    x = x + 1
+    g = x * y
+    print(str(d))
+    print(str(f - e))
+    print(str(g))
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -0,0 +1,35 @@
+#include <iostream>
+using namespace std;
+
+int square(int x) {{
+    int s = x * x;
+    return s;
+} }
+
+int show(int x) {{
+    cout << x;
+    if (x > 9) {
+        return 9;
+    }
+    return x;
+} }
+
+int count(int n) {{
+    int c = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        c = c + 1;
+    }
+    return c;
+} }
+
+int main() {
+    int a = square(12);
+    int b = show(5);
+    int c = count(1000000);
+    int d = count(5);
+    cout << a;
+    cout << b;
+    cout << c;
+    cout << d;
+    return 0;
+}
@@ -0,0 +1,28 @@
+def square(x):
+    s = x * x
+    return s
+def show(x):
+    print(str(x))
+    if x > 9:
+        return 9
+    return x
+def count(n):
+    c = 0
+    c = c + len(range(0, n))
+    return c
+def main():
+    a = 144
+    b = show(5)
+    __inl0_n = 1000000
+    __inl0_c = 0
+    __inl0_c = __inl0_c + len(range(0, __inl0_n))
+    c = __inl0_c
+    d = 5
+    print(str(a))
+    print(str(b))
+    print(str(c))
+    print(str(d))
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -7,7 +7,7 @@ def main():
     a = 5 / 3
     b = -5.5 + 3.3
     b = -5.5 - 3.3
-    b = -5.5 - 3.300
+    b = -5.5 - 3.3
     b = -5.5 * -3.3
     b = -5.5 / -3.3
     return 0
@@ -0,0 +1,21 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int w = 10 - 7;
+    int h = w * 4 + 1;
+    float r = 1.5 * 2.0;
+    int n = 3;
+    n = n + 1;
+    n = n * 1;
+    int m = n * (2 + 3);
+    if (w > 5) {
+        cout << "wide";
+    } else {
+        cout << "narrow";
+    }
+    cout << h;
+    cout << r;
+    cout << m;
+    return 0;
+}
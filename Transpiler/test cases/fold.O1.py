@@ -0,0 +1,15 @@
+def main():
+    w = 3
+    h = 13
+    r = 3.0
+    n = 3
+    n = n + 1
+    m = n * 5
+    print("narrow")
+    print(str(h))
+    print(str(r))
+    print(str(m))
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -0,0 +1,25 @@
+#include <iostream>
+using namespace std;
+
+int clamp(int v, int top) {{
+    if (v > top) {
+        v = top - 1;
+    }
+    return v;
+} }
+
+int twice(int v) {{
+    return v + v;
+} }
+
+int main() {
+    int x = 40;
+    x = x + 2;
+    int a = clamp(x, 10) + 1;
+    int b = twice(x);
+    bool ok = x > 50 && twice(x) > 3;
+    cout << a;
+    cout << b;
+    cout << ok;
+    return 0;
+}
@@ -0,0 +1,23 @@
+def clamp(v, top):
+    if v > top:
+        v = top - 1
+    return v
+def twice(v):
+    return v + v
+def main():
+    x = 40
+    x = x + 2
+    __inl0_v = x
+    __inl0_top = 10
+    if __inl0_v > __inl0_top:
+        __inl0_v = __inl0_top - 1
+    a = __inl0_v + 1
+    b = x + x
+    ok = x > 50 and twice(x) > 3
+    print(str(a))
+    print(str(b))
+    print(str(ok))
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -7,10 +7,10 @@ def main():
     product = a * b
     quotient = a / b
     complex1 = a + b * c
-    complex2 = a + b * c
+    complex2 = (a + b) * c
     complex3 = a * b + c
-    complex4 = a * b + c
-    result = sum + difference * (product / quotient)
+    complex4 = a * (b + c)
+    result = sum + difference * product / quotient
     return result
 
 if __name__ == "__main__":
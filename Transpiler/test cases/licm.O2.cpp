@@ -0,0 +1,20 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int a = 3;
+    a = a + 1;
+    int b = 5;
+    b = b * 2;
+    int c = 0;
+    for (int i = 0; i < 20; i++) {
+        cout << i * (a * b + 1);
+        cout << i / a;
+    }
+    for (int j = 0; j < 20; j++) {
+        c = c + a * b;
+        cout << c;
+        b = b - 1;
+    }
+    return 0;
+}
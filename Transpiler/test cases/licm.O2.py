@@ -0,0 +1,18 @@
+def main():
+    a = 3
+    a = a + 1
+    b = 5
+    b = b * 2
+    c = 0
+    __inv0 = a * b + 1
+    for i in range(0, 20):
+        print(str(i * __inv0))
+        print(str(i / a))
+    for j in range(0, 20):
+        c = c + a * b
+        print(str(c))
+        b = b - 1
+    return 0
+
+if __name__ == "__main__":
+        main()
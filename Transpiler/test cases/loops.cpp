@@ -0,0 +1,22 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int n = 5;
+    n = n + 1;
+    for (int i = 0; i < n; i++) {
+        cout << i;
+    }
+    for (int j = 10; j >= 0; j = j - 3) {
+        cout << j;
+    }
+    int m = 4;
+    for (int k = 0; k < m; k++) {
+        m = m - 1;
+        cout << k;
+    }
+    for (int d = 0; d < n / 2; d++) {
+        cout << d;
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+def main():
+    n = 5
+    n = n + 1
+    for i in range(0, n):
+        print(str(i))
+    for j in range(10, -1, -3):
+        print(str(j))
+    m = 4
+    k = 0
+    while k < m:
+        m = m - 1
+        print(str(k))
+        k = k + 1
+    d = 0
+    while d < n / 2:
+        print(str(d))
+        d = d + 1
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -0,0 +1,17 @@
+#include <iostream>
+using namespace std;
+
+int fact(int n) {{
+    int r = 1;
+    if (n > 1) {
+        int m = fact(n - 1);
+        r = n * m;
+    }
+    return r;
+} }
+
+int main() {
+    int a = fact(10);
+    cout << a;
+    return 0;
+}
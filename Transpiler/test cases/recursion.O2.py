@@ -0,0 +1,13 @@
+def fact(n):
+    r = 1
+    if n > 1:
+        m = fact(n - 1)
+        r = n * m
+    return r
+def main():
+    a = 3628800
+    print(str(a))
+    return 0
+
+if __name__ == "__main__":
+        main()
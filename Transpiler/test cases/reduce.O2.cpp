@@ -0,0 +1,32 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int n = 50;
+    n = n + 50;
+    int total = 0;
+    for (int i = 1; i <= n; i++) {
+        total = total + i * i;
+    }
+    int best = 0;
+    for (int j = 0; j < n; j++) {
+        if (j * 7 - j * j > best) {
+            best = j * 7 - j * j;
+        }
+    }
+    bool found = false;
+    for (int k = 0; k < n; k++) {
+        if (k * k == 49) {
+            found = true;
+        }
+    }
+    int last = 0;
+    for (int p = 0; p < n; p++) {
+        last = last + p;
+        cout << last;
+    }
+    cout << total;
+    cout << best;
+    cout << found;
+    return 0;
+}
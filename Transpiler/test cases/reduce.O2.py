@@ -0,0 +1,20 @@
+def main():
+    n = 50
+    n = n + 50
+    total = 0
+    total = total + sum(i * i for i in range(1, n + 1))
+    best = 0
+    best = max(best, max((j * 7 - j * j for j in range(0, n)), default=best))
+    found = False
+    found = found or any(k * k == 49 for k in range(0, n))
+    last = 0
+    for p in range(0, n):
+        last = last + p
+        print(str(last))
+    print(str(total))
+    print(str(best))
+    print(str(found))
+    return 0
+
+if __name__ == "__main__":
+        main()
@@ -0,0 +1,18 @@
+#include <iostream>
+using namespace std;
+
+int main() {
+    int x = 2;
+    x = x * 3;
+    for (int i = 0; i < 3; i++) {
+        cout << x * i;
+    }
+    int s = 1;
+    for (int j = s; j < 4; j++) {
+        cout << x + j;
+    }
+    for (int k = 0; k < 100; k++) {
+        cout << x - k;
+    }
+    return 0;
+}
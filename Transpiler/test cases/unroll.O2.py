@@ -0,0 +1,15 @@
+def main():
+    x = 2
+    x = x * 3
+    print(str(x * 0))
+    print(str(x))
+    print(str(x * 2))
+    s = 1
+    for j in range(1, 4):
+        print(str(x + j))
+    for k in range(0, 100):
+        print(str(x - k))
+    return 0
+
+if __name__ == "__main__":
+        main()
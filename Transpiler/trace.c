@@ -0,0 +1,108 @@
+#define _GNU_SOURCE
+#include "trace.h"
+#include "stats.h"
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+bool trace_enabled = false;
+
+static int trace_fd = -1;
+static const char *trace_path = NULL;
+static char *events = NULL;               /* events of this run, written out by trace_close() */
+static size_t events_len = 0;
+static FILE *events_out = NULL;
+static long trace_pid;
+static long trace_tid;
+
+// Microseconds on the monotonic clock, shared by every process on the machine
+uint64_t trace_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+// Start collecting events; the file is created on first use and appended to afterwards
+bool trace_open(const char *path, const char *input_path) {
+    trace_fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (trace_fd < 0) {
+        fprintf(stderr, "Error: Cannot open trace file %s\n", path);
+        return false;
+    }
+    events_out = open_memstream(&events, &events_len);
+    if (events_out == NULL) {
+        fprintf(stderr, "Error: Failed to allocate memory for trace events\n");
+        close(trace_fd);
+        trace_fd = -1;
+        return false;
+    }
+    trace_path = path;
+    trace_pid = (long)getpid();
+    trace_tid = (long)syscall(SYS_gettid);
+    trace_enabled = true;
+
+    // name the process after the file it translates
+    fprintf(events_out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":",
+            trace_pid, trace_tid);
+    write_json_string(events_out, input_path);
+    fprintf(events_out, "}},\n");
+    return true;
+}
+
+// Complete event from start until now; args is a JSON object or NULL
+void trace_span(const char *name, uint64_t start, const char *args) {
+    if (!trace_enabled) return;
+    uint64_t end = trace_now();
+    fprintf(events_out, "{\"name\":\"%s\",\"cat\":\"cpp2py\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%ld,\"tid\":%ld",
+            name, (unsigned long long)start, (unsigned long long)(end - start), trace_pid, trace_tid);
+    if (args) fprintf(events_out, ",\"args\":%s", args);
+    fprintf(events_out, "},\n");
+}
+
+// Instant event on the current thread, message may be NULL
+void trace_instant(const char *name, const char *message) {
+    if (!trace_enabled) return;
+    fprintf(events_out, "{\"name\":\"%s\",\"cat\":\"cpp2py\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":%ld,\"tid\":%ld",
+            name, (unsigned long long)trace_now(), trace_pid, trace_tid);
+    if (message) {
+        fprintf(events_out, ",\"args\":{\"message\":");
+        write_json_string(events_out, message);
+        fputc('}', events_out);
+    }
+    fprintf(events_out, "},\n");
+}
+
+// Append the events of this run in one write. The array is left open (trace viewers accept
+// that) so that other runs can keep appending; the lock keeps parallel runs from interleaving.
+bool trace_close(void) {
+    if (!trace_enabled) return true;
+    trace_enabled = false;
+    bool ok = fclose(events_out) == 0;
+    events_out = NULL;
+
+    if (ok && flock(trace_fd, LOCK_EX) == 0) {
+        struct stat st;
+        if (fstat(trace_fd, &st) == 0 && st.st_size == 0 && write(trace_fd, "[\n", 2) != 2) ok = false;
+        size_t done = 0;
+        while (ok && done < events_len) {
+            ssize_t n = write(trace_fd, events + done, events_len - done);
+            if (n <= 0) ok = false;
+            else done += (size_t)n;
+        }
+        flock(trace_fd, LOCK_UN);
+    } else {
+        ok = false;
+    }
+    if (close(trace_fd) != 0) ok = false;
+    if (!ok) fprintf(stderr, "Error: Failed to write trace file %s\n", trace_path);
+
+    trace_fd = -1;
+    free(events);
+    events = NULL;
+    events_len = 0;
+    return ok;
+}
@@ -0,0 +1,22 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Trace-event (Chrome/Perfetto JSON) timeline of a run. Every run appends its events to the
+// same file, so runs over many files, in sequence or in parallel, end up on one timeline:
+// one process per run, spans on the thread that did the work.
+
+extern bool trace_enabled;
+
+// Function declarations
+bool trace_open(const char *path, const char *input_path);
+uint64_t trace_now(void);
+void trace_span(const char *name, uint64_t start, const char *args);
+void trace_instant(const char *name, const char *message);
+bool trace_close(void);
+
+#endif // TRACE_H
@@ -0,0 +1,365 @@
+#define _GNU_SOURCE
+#define ALLOC_SUBSYSTEM ALLOC_AST
+#include "passes.h"
+#include "loops.h"
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+// Unrolling of small counted loops.
+//
+// A counted loop (loops.c) with literal start and stop, for (int k = 0; k < 3; k++), is replaced by
+// its body once per value of k, with k replaced by that value: the per-iteration cost of a Python
+// for loop is large next to a body of a few statements. It is unrolled when the copies hold at most
+// unroll_limit statements (nested ones included) and the body holds only statements a copy is
+// made of here: assignments, declarations, input, output, calls, returns, ifs and for loops. The
+// grammar has no break or continue, so every iteration runs the body to its end or returns. Inner
+// loops are unrolled first. The pass runs ahead of fold, which then folds the expressions over the
+// substituted values and prunes the branches they decide.
+
+unsigned long unroll_limit = 16;
+
+#define MAX_TRIP_COUNT 1024
+
+// Number of statements in list and the blocks nested in it, or SIZE_MAX if one cannot be copied or
+// there are more than limit; the walk stops there, a large body costs no more than a small one
+static size_t body_size(struct AST_Node_Statements *list, size_t limit) {
+    size_t size = 0;
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL) continue;
+        switch (instr->n_type) {
+            case ASSIGN_NODE:
+            case INIT_NODE:
+            case INPUT_NODE:
+            case OUTPUT_NODE:
+            case FUNC_CALL_NODE:
+            case RETURN_NODE:
+            case IF_NODE:
+            case FOR_NODE:
+                break;
+            default:
+                return SIZE_MAX;
+        }
+        if (++size > limit) return SIZE_MAX;
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) {
+            size_t nested = body_size(*bodies[i], limit - size);
+            if (nested == SIZE_MAX) return SIZE_MAX;
+            size += nested;
+        }
+    }
+    return size;
+}
+
+/****************** Substitution *****************/
+
+// The induction variable and the value it has in the copy being made
+struct Unroll_Copy {
+    const char *var;
+    struct AST_Node_Operand *value;
+    struct AST_Node_Operand *text;   /* the value as a string literal, for output */
+    bool failed;                  /* an allocation failed, the copy is dropped */
+};
+
+static struct AST_Node_Operand *copy_operand(struct Unroll_Copy *copy, struct AST_Node_Operand *operand);
+
+static void *copy_node(struct Unroll_Copy *copy, const void *node, size_t size) {
+    void *result = MALLOC(size);
+    if (!result) {
+        fprintf(stderr, "Error: Failed to allocate memory for unrolled loop\n");
+        copy->failed = true;
+        return NULL;
+    }
+    memcpy(result, node, size);
+    return result;
+}
+
+// expr with the variable replaced, expr itself if it does not read it
+static struct AST_Node_Expression *copy_expression(struct Unroll_Copy *copy, struct AST_Node_Expression *expr) {
+    if (expr == NULL) return NULL;
+    size_t n = count_operands(expr);
+    struct AST_Node_Operand *small[8];
+    struct AST_Node_Operand **operands = n <= 8 ? small : (struct AST_Node_Operand **)MALLOC(n * sizeof(*operands));
+    if (!operands) {
+        fprintf(stderr, "Error: Failed to allocate memory for unrolled loop\n");
+        copy->failed = true;
+        return expr;
+    }
+    bool changed = false;
+    for (size_t i = 0; i < n; i++) {
+        struct AST_Node_Operand *child = nth_operand(expr, i);
+        operands[i] = copy_operand(copy, child);
+        changed = changed || operands[i] != child;
+    }
+    struct AST_Node_Expression *result = expr;
+    if (changed) {
+        result = (struct AST_Node_Expression *)copy_node(copy, expr, sizeof(*expr));
+        struct AST_Node_Operand **list = expr->n_operands
+            ? (struct AST_Node_Operand **)copy_node(copy, operands, n * sizeof(*operands)) : NULL;
+        if (result && (list || !expr->n_operands)) {
+            result->left_op = operands[0];
+            result->right_op = operands[n - 1];
+            result->operands = list;
+            result = share_expression(result);
+        } else {
+            FREE(result);
+            FREE(list);
+            result = expr;
+        }
+    }
+    if (operands != small) FREE(operands);
+    return result;
+}
+
+// Call arguments with the variable replaced, params itself if none reads it
+static struct AST_Node_Params *copy_arguments(struct Unroll_Copy *copy, struct AST_Node_Params *params) {
+    if (params == NULL) return NULL;
+    struct AST_Node_Params *rest = copy_arguments(copy, params->next_param);
+    struct AST_Node_Operand *argument = copy_operand(copy, params->call_param);
+    if (rest == params->next_param && argument == params->call_param) return params;
+    struct AST_Node_Params *result = (struct AST_Node_Params *)copy_node(copy, params, sizeof(*params));
+    if (!result) return params;
+    result->call_param = argument;
+    result->next_param = rest;
+    return result;
+}
+
+static struct AST_Node_FunctionCall *copy_call(struct Unroll_Copy *copy, struct AST_Node_FunctionCall *call) {
+    if (call == NULL) return NULL;
+    struct AST_Node_Params *params = copy_arguments(copy, call->params);
+    if (params == call->params) return call;
+    struct AST_Node_FunctionCall *result = (struct AST_Node_FunctionCall *)copy_node(copy, call, sizeof(*call));
+    if (!result) return call;
+    result->params = params;
+    return result;
+}
+
+// operand with the variable replaced, operand itself if it does not read it
+static struct AST_Node_Operand *copy_operand(struct Unroll_Copy *copy, struct AST_Node_Operand *operand) {
+    if (operand == NULL) return NULL;
+    struct AST_Node_Operand result = *operand;
+    switch (operand->operand_type) {
+        case CONTENT_TYPE_ID:
+            return same_name(operand->value.val, copy->var) ? copy->value : operand;
+        case CONTENT_TYPE_EXPRESSION:
+            result.value.expr = copy_expression(copy, operand->value.expr);
+            if (result.value.expr == operand->value.expr) return operand;
+            break;
+        case CONTENT_TYPE_FUNCTION:
+            result.value.funca = copy_call(copy, operand->value.funca);
+            if (result.value.funca == operand->value.funca) return operand;
+            break;
+        default:
+            return operand;
+    }
+    struct AST_Node_Operand *node = (struct AST_Node_Operand *)copy_node(copy, &result, sizeof(result));
+    return node ? share_operand(node) : operand;
+}
+
+// Statement nodes are copied whether they change or not, later passes rewrite them in place
+static struct AST_Node_Assign *copy_assign(struct Unroll_Copy *copy, struct AST_Node_Assign *assign) {
+    if (assign == NULL) return NULL;
+    struct AST_Node_Assign *result = (struct AST_Node_Assign *)copy_node(copy, assign, sizeof(*assign));
+    if (!result || !has_value(assign)) return result;
+    struct AST_Node_Operand value = assign_value(assign);
+    struct AST_Node_Operand *copied = copy_operand(copy, &value);
+    result->a_val = copied->value;
+    result->a_type = copied->operand_type;
+    return result;
+}
+
+static struct AST_Node_Statements *copy_list(struct Unroll_Copy *copy, struct AST_Node_Statements *list);
+
+static struct AST_Node_Instruction *copy_instruction(struct Unroll_Copy *copy, struct AST_Node_Instruction *instr) {
+    struct AST_Node_Instruction *result = (struct AST_Node_Instruction *)copy_node(copy, instr, sizeof(*instr));
+    if (!result) return NULL;
+    switch (instr->n_type) {
+        case ASSIGN_NODE:
+            result->value.assign = copy_assign(copy, instr->value.assign);
+            break;
+        case INIT_NODE: {
+            struct AST_Node_Init **link = &result->value.init;
+            for (struct AST_Node_Init *init = instr->value.init; init != NULL && !copy->failed; init = init->next_init) {
+                struct AST_Node_Init *node = (struct AST_Node_Init *)copy_node(copy, init, sizeof(*init));
+                if (!node) break;
+                node->assign = copy_assign(copy, init->assign);
+                *link = node;
+                link = &node->next_init;
+            }
+            *link = NULL;
+            break;
+        }
+        case INPUT_NODE: {
+            struct AST_Node_Input **link = &result->value.inputNode;
+            for (struct AST_Node_Input *in = instr->value.inputNode; in != NULL && !copy->failed; in = in->next_input) {
+                struct AST_Node_Input *node = (struct AST_Node_Input *)copy_node(copy, in, sizeof(*in));
+                if (!node) break;
+                *link = node;
+                link = &node->next_input;
+            }
+            *link = NULL;
+            break;
+        }
+        case OUTPUT_NODE: {
+            struct AST_Node_Output **link = &result->value.outputNode;
+            for (struct AST_Node_Output *out = instr->value.outputNode; out != NULL && !copy->failed; out = out->next_output) {
+                struct AST_Node_Output *node = (struct AST_Node_Output *)copy_node(copy, out, sizeof(*out));
+                if (!node) break;
+                node->output_op = copy_operand(copy, out->output_op);
+                // a number is printed as is and could not be concatenated with the other parts
+                if (node->output_op == copy->value) node->output_op = copy->text;
+                *link = node;
+                link = &node->next_output;
+            }
+            *link = NULL;
+            break;
+        }
+        case FUNC_CALL_NODE:
+            result->value.functionCall = copy_call(copy, instr->value.functionCall);
+            break;
+        case RETURN_NODE: {
+            struct AST_Node_Return *return_node = instr->value.returnNode;
+            if (return_node == NULL) break;
+            result->value.returnNode = (struct AST_Node_Return *)copy_node(copy, return_node, sizeof(*return_node));
+            if (result->value.returnNode && return_node->value) {
+                struct AST_Node *node = (struct AST_Node *)copy_node(copy, return_node->value, sizeof(struct AST_Node));
+                if (node) node->value = copy_operand(copy, (struct AST_Node_Operand *)return_node->value->value);
+                result->value.returnNode->value = node;
+            }
+            break;
+        }
+        case IF_NODE: {
+            struct AST_Node_If *if_node = instr->value.ifNode;
+            if (if_node == NULL) break;
+            struct AST_Node_If *node = (struct AST_Node_If *)copy_node(copy, if_node, sizeof(*if_node));
+            if (!node) break;
+            node->condition = copy_expression(copy, if_node->condition);
+            node->if_body = copy_list(copy, if_node->if_body);
+            if (if_node->else_if) {
+                node->else_if = (struct AST_Node_Else_If *)copy_node(copy, if_node->else_if, sizeof(*if_node->else_if));
+                if (node->else_if) {
+                    node->else_if->condition = copy_expression(copy, if_node->else_if->condition);
+                    node->else_if->elif_body = copy_list(copy, if_node->else_if->elif_body);
+                }
+            }
+            if (if_node->else_body) {
+                node->else_body = (struct AST_Node_Else *)copy_node(copy, if_node->else_body, sizeof(*if_node->else_body));
+                if (node->else_body) node->else_body->else_body = copy_list(copy, if_node->else_body->else_body);
+            }
+            result->value.ifNode = node;
+            break;
+        }
+        case FOR_NODE: {
+            struct AST_Node_For *for_node = instr->value.forNode;
+            if (for_node == NULL) break;
+            struct AST_Node_For *node = (struct AST_Node_For *)copy_node(copy, for_node, sizeof(*for_node));
+            if (!node) break;
+            node->init = copy_assign(copy, for_node->init);
+            node->condition = copy_expression(copy, for_node->condition);
+            node->increment = copy_assign(copy, for_node->increment);
+            node->for_body = copy_list(copy, for_node->for_body);
+            result->value.forNode = node;
+            break;
+        }
+        default:
+            copy->failed = true;
+            break;
+    }
+    return result;
+}
+
+static struct AST_Node_Statements *copy_list(struct Unroll_Copy *copy, struct AST_Node_Statements *list) {
+    struct AST_Node_Statements *head = NULL;
+    struct AST_Node_Statements **link = &head;
+    for (; list != NULL && !copy->failed; list = list->right) {
+        struct AST_Node_Statements *node = (struct AST_Node_Statements *)copy_node(copy, list, sizeof(*list));
+        if (!node) break;
+        if (list->left) node->left = copy_instruction(copy, list->left);
+        *link = node;
+        link = &node->right;
+    }
+    *link = NULL;
+    return head;
+}
+
+/****************** Unrolling *****************/
+
+// Number of values range(start, stop, step) takes
+static long long trip_count(long long start, long long stop, long long step) {
+    if (step > 0) return stop > start ? (stop - start + step - 1) / step : 0;
+    return start > stop ? (start - stop - step - 1) / -step : 0;
+}
+
+// Replace the for loop of statement by copies of its body; true if it was unrolled
+static bool unroll_loop(struct AST_Node_Statements *statement) {
+    struct AST_Node_For *for_node = statement->left->value.forNode;
+    struct Counted_Loop loop;
+    if (for_node == NULL || for_node->for_body == NULL) return false;
+    // the size first, counted_loop searches the body for assignments
+    size_t size = body_size(for_node->for_body, unroll_limit);
+    if (size == SIZE_MAX || !counted_loop(for_node, &loop)) return false;
+    // int literals, as C++ types them, keep the values of the variable from overflowing
+    struct AST_Node_Operand *bound = loop.bound;
+    if (loop.start.operand_type != CONTENT_TYPE_INT_NUMBER || bound->operand_type != CONTENT_TYPE_INT_NUMBER ||
+        loop.start.value.ival < INT_MIN || loop.start.value.ival > INT_MAX ||
+        bound->value.ival < INT_MIN || bound->value.ival > INT_MAX) {
+        return false;
+    }
+    long long trips = trip_count(loop.start.value.ival, (long long)bound->value.ival + loop.adjust, loop.step);
+    if (trips < 1 || trips > MAX_TRIP_COUNT || size * (size_t)trips > unroll_limit) return false;
+
+    struct AST_Node_Statements *head = NULL;
+    struct AST_Node_Statements **link = &head;
+    for (long long i = 0; i < trips; i++) {
+        struct AST_Node_Operand *value = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        struct AST_Node_Operand *text = (struct AST_Node_Operand *)MALLOC(sizeof(struct AST_Node_Operand));
+        if (!value || !text) {
+            fprintf(stderr, "Error: Failed to allocate memory for unrolled loop\n");
+            FREE(value);
+            FREE(text);
+            return false;
+        }
+        value->value.ival = (long)(loop.start.value.ival + i * loop.step);
+        value->val_type = DATA_TYPE_INT;
+        value->operand_type = CONTENT_TYPE_INT_NUMBER;
+        text->value.val = NULL;
+        ASPRINTF(&text->value.val, "\"%ld\"", value->value.ival);
+        text->val_type = DATA_TYPE_STRING;
+        text->operand_type = CONTENT_TYPE_STRING;
+        struct Unroll_Copy copy = { .var = loop.var, .value = share_operand(value), .text = share_operand(text) };
+        *link = copy_list(&copy, for_node->for_body);
+        if (copy.failed) return false;
+        while (*link != NULL) link = &(*link)->right;
+    }
+    if (head == NULL) return false;
+
+    // the copies take the place of the loop statement, which keeps its list node
+    *link = statement->right;
+    statement->left = head->left;
+    statement->right = head->right;
+    return true;
+}
+
+static size_t unroll_list(struct AST_Node_Statements *list) {
+    size_t changes = 0;
+    for (; list != NULL; list = list->right) {
+        struct AST_Node_Instruction *instr = list->left;
+        if (instr == NULL || instr->n_type == CLASS_NODE || instr->n_type == CLASS_CHILD_NODE) continue;
+        struct AST_Node_Statements **bodies[4];
+        size_t n = nested_bodies(instr, bodies, 4);
+        for (size_t i = 0; i < n; i++) changes += unroll_list(*bodies[i]);
+        // the copies are not visited again, their loops were unrolled along with the body
+        struct AST_Node_Statements *next = list->right;
+        if (instr->n_type == FOR_NODE && unroll_loop(list)) {
+            changes++;
+            while (list->right != next) list = list->right;
+        }
+    }
+    return changes;
+}
+
+size_t pass_unroll(struct AST_Node_Statements **root) {
+    return unroll_list(*root);
+}
@@ -1,12 +1,13 @@
-#ifndef UTILS_H
-#define UTILS_H
-
-#include "ast.h"
-#include "symtab.h"
-
-// Function declarations
-DATA_TYPE str_to_type(char *type_str);
-bool search_class_body(char *var_name, struct AST_Node_Statements *root);
-void check_function_call(struct AST_Node_FunctionCall *func_call);
-
-#endif // UTILS_H 
+#ifndef UTILS_H
+#define UTILS_H
+
+#include "ast.h"
+#include "symtab.h"
+
+// Function declarations
+DATA_TYPE str_to_type(char *type_str);
+SIG_KEY pack_signature(struct AST_Node_Params *params, bool is_decl, int *arity);
+struct Symbol *check_function_call(struct AST_Node_FunctionCall *func_call, size_t offset);
+int source_line(size_t offset);
+
+#endif // UTILS_H 